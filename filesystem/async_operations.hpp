@@ -0,0 +1,481 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_ASYNC_OPERATIONS_HPP_INCLUDED
+#define XSTD_FILESYSTEM_ASYNC_OPERATIONS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined( __cpp_impl_coroutine ) && defined( __has_include )
+#if __has_include( <coroutine> )
+#include <coroutine>
+#define XSTD_FILESYSTEM_HAS_COROUTINES 1
+#endif
+#endif
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Asynchronous operations - not part of the proposal
+
+
+//! \brief  A copyable handle on whether an operation has been cancelled.
+//!         A default constructed token is never cancelled.
+class cancellation_token
+{
+public:
+
+    cancellation_token() = default;
+
+    bool cancelled() const noexcept
+    {
+        return Cancelled_ && Cancelled_->load( std::memory_order_acquire );
+    }
+
+private:
+
+    friend class cancellation_source;
+
+    explicit cancellation_token( std::shared_ptr<std::atomic<bool>> Cancelled )
+    : Cancelled_( std::move( Cancelled ) )
+    {
+    }
+
+    std::shared_ptr<std::atomic<bool>> Cancelled_;
+};
+
+
+//! \brief  Cancels every operation given one of its tokens
+class cancellation_source
+{
+public:
+
+    cancellation_source()
+    : Cancelled_( std::make_shared<std::atomic<bool>>( false ) )
+    {
+    }
+
+    cancellation_token token() const
+    {
+        return cancellation_token( Cancelled_ );
+    }
+
+    void cancel() noexcept
+    {
+        Cancelled_->store( true, std::memory_order_release );
+    }
+
+    bool cancelled() const noexcept
+    {
+        return Cancelled_->load( std::memory_order_acquire );
+    }
+
+private:
+
+    std::shared_ptr<std::atomic<bool>> Cancelled_;
+};
+
+
+//! \brief  A fixed number of threads running posted work in the order it
+//!         was posted. Any type with a `post( std::function<void()> )`
+//!         member can be used as an executor in its place.
+class thread_pool
+{
+public:
+
+    //! \brief  Start `threads` threads, or one per core if 0
+    explicit thread_pool( std::size_t Threads = 0 )
+    {
+        if( Threads == 0 )
+        {
+            Threads = default_thread_count();
+        }
+        for( std::size_t Thread = 0; Thread != Threads; ++Thread )
+        {
+            Threads_.emplace_back( [this]() { run(); } );
+        }
+    }
+
+    thread_pool( const thread_pool& ) = delete;
+    thread_pool& operator=( const thread_pool& ) = delete;
+
+    //! \brief  Finish the work already posted and stop the threads
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock( Mutex_ );
+            Stopping_ = true;
+        }
+        Ready_.notify_all();
+        for( auto& Thread: Threads_ )
+        {
+            Thread.join();
+        }
+    }
+
+    void post( std::function<void()> Work )
+    {
+        {
+            std::lock_guard<std::mutex> Lock( Mutex_ );
+            Queue_.push_back( std::move( Work ) );
+        }
+        Ready_.notify_one();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return Threads_.size();
+    }
+
+    //! \brief  The pool used when no executor is given, started on first use
+    static thread_pool& default_pool()
+    {
+        static thread_pool Pool;
+        return Pool;
+    }
+
+private:
+
+    void run()
+    {
+        while( true )
+        {
+            std::function<void()> Work;
+            {
+                std::unique_lock<std::mutex> Lock( Mutex_ );
+                Ready_.wait( Lock, [this]() { return Stopping_ || !Queue_.empty(); } );
+                if( Queue_.empty() )
+                {
+                    return;
+                }
+                Work = std::move( Queue_.front() );
+                Queue_.pop_front();
+            }
+            Work();
+        }
+    }
+
+    std::mutex                          Mutex_;
+    std::condition_variable             Ready_;
+    std::deque<std::function<void()>>   Queue_;
+    bool                                Stopping_ = false;
+    std::vector<std::thread>            Threads_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations that fail with `operation_canceled` once
+//!         a token is cancelled, and otherwise pass queries on to
+//!         `Operations`, so a cancelled resolution stops at its next query
+template<class Operations = system_operations>
+class cancellable_operations
+{
+public:
+
+    cancellable_operations( Operations Ops, xstd::filesystem::cancellation_token Token )
+    : Ops_( std::move( Ops ) )
+    , Token_( std::move( Token ) )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return !cancelled( ec ) && Ops_.exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return !cancelled( ec ) && Ops_.is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return cancelled( ec ) ? path_t() : Ops_.canonical( p, ec );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return cancelled( ec ) ? path_t() : Ops_.current_path( ec );
+    }
+
+private:
+
+    bool cancelled( boost::system::error_code& ec ) const
+    {
+        if( Token_.cancelled() )
+        {
+            ec.assign( boost::system::errc::operation_canceled, boost::system::generic_category() );
+            return true;
+        }
+        return false;
+    }
+
+    Operations                              Ops_;
+    xstd::filesystem::cancellation_token    Token_;
+};
+
+
+#if defined( XSTD_FILESYSTEM_HAS_COROUTINES )
+
+
+//! \brief  An awaitable that runs a blocking filesystem operation on an
+//!         executor and resumes the awaiting coroutine, on the executor's
+//!         thread, once it is complete.
+//!
+//!         If `ec` was given it receives the error, otherwise an error is
+//!         thrown from the `co_await` as a filesystem_error. An operation
+//!         whose token is cancelled before it completes fails with
+//!         `operation_canceled`.
+template<class Executor>
+class async_path_operation
+{
+public:
+
+    //! `work` computes the result, setting its error code argument on failure
+    using work_t = std::function<path_t( boost::system::error_code& )>;
+
+    async_path_operation( Executor& Exec, work_t Work, xstd::filesystem::cancellation_token Token, boost::system::error_code* ec, const char* Name, path_t p, path_t start = path_t() )
+    : Exec_( Exec )
+    , Work_( std::move( Work ) )
+    , Token_( std::move( Token ) )
+    , Ec_( ec )
+    , Name_( Name )
+    , P_( std::move( p ) )
+    , Start_( std::move( start ) )
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend( std::coroutine_handle<> Awaiting )
+    {
+        Exec_.post( [this, Awaiting]()
+        {
+            if( Token_.cancelled() )
+            {
+                Error_.assign( boost::system::errc::operation_canceled, boost::system::generic_category() );
+            }
+            else
+            {
+                try
+                {
+                    Result_ = Work_( Error_ );
+                }
+                catch( ... )
+                {
+                    Exception_ = std::current_exception();
+                }
+                if( Token_.cancelled() )
+                {
+                    Result_.clear();
+                    Error_.assign( boost::system::errc::operation_canceled, boost::system::generic_category() );
+                }
+            }
+            Awaiting.resume();
+        } );
+    }
+
+    path_t await_resume()
+    {
+        if( Exception_ )
+        {
+            std::rethrow_exception( Exception_ );
+        }
+        if( Ec_ )
+        {
+            *Ec_ = Error_;
+        }
+        else if( Error_ )
+        {
+            if( Start_.empty() )
+            {
+                BOOST_FILESYSTEM_THROW( filesystem_error( Name_, P_, Error_ ) );
+            }
+            BOOST_FILESYSTEM_THROW( filesystem_error( Name_, P_, Start_, Error_ ) );
+        }
+        return std::move( Result_ );
+    }
+
+private:
+
+    Executor&                               Exec_;
+    work_t                                  Work_;
+    xstd::filesystem::cancellation_token    Token_;
+    boost::system::error_code*              Ec_;
+    const char*                             Name_;
+    path_t                                  P_;
+    path_t                                  Start_;
+
+    path_t                                  Result_;
+    boost::system::error_code               Error_;
+    std::exception_ptr                      Exception_;
+};
+
+
+//! \brief  Awaitable `relative( p, start, ec, ops )` run on `executor`
+template<class Operations, class Executor>
+async_path_operation<Executor>
+async_relative( const path_t& p, const path_t& start, boost::system::error_code& ec, const Operations& ops, Executor& executor, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<Operations> Ops( ops, token );
+    return async_path_operation<Executor>
+    (   executor,
+        [p, start, Ops]( boost::system::error_code& ec ) { return relative( p, start, ec, Ops ); },
+        std::move( token ), &ec, "boost::filesystem::relative", p, start   );
+}
+
+
+//! \brief  Awaitable `relative( p, start, ec )` run on the default thread pool
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_relative( const path_t& p, const path_t& start, boost::system::error_code& ec, xstd::filesystem::cancellation_token token = {} )
+{
+    return async_relative( p, start, ec, system_operations(), xstd::filesystem::thread_pool::default_pool(), std::move( token ) );
+}
+
+
+//! \brief  Awaitable `relative( p, start )` run on the default thread pool
+//!
+//! \throw As specified in Error reporting, from the `co_await`.
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_relative( const path_t& p, const path_t& start, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<> Ops( system_operations(), token );
+    return async_path_operation<xstd::filesystem::thread_pool>
+    (   xstd::filesystem::thread_pool::default_pool(),
+        [p, start, Ops]( boost::system::error_code& ec ) { return relative( p, start, ec, Ops ); },
+        std::move( token ), nullptr, "boost::filesystem::relative", p, start   );
+}
+
+
+//! \brief  Awaitable `proximate( p, start, ec, ops )` run on `executor`
+template<class Operations, class Executor>
+async_path_operation<Executor>
+async_proximate( const path_t& p, const path_t& start, boost::system::error_code& ec, const Operations& ops, Executor& executor, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<Operations> Ops( ops, token );
+    return async_path_operation<Executor>
+    (   executor,
+        [p, start, Ops]( boost::system::error_code& ec ) { return proximate( p, start, ec, Ops ); },
+        std::move( token ), &ec, "boost::filesystem::proximate", p, start   );
+}
+
+
+//! \brief  Awaitable `proximate( p, start, ec )` run on the default thread pool
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_proximate( const path_t& p, const path_t& start, boost::system::error_code& ec, xstd::filesystem::cancellation_token token = {} )
+{
+    return async_proximate( p, start, ec, system_operations(), xstd::filesystem::thread_pool::default_pool(), std::move( token ) );
+}
+
+
+//! \brief  Awaitable `proximate( p, start )` run on the default thread pool
+//!
+//! \throw As specified in Error reporting, from the `co_await`.
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_proximate( const path_t& p, const path_t& start, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<> Ops( system_operations(), token );
+    return async_path_operation<xstd::filesystem::thread_pool>
+    (   xstd::filesystem::thread_pool::default_pool(),
+        [p, start, Ops]( boost::system::error_code& ec ) { return proximate( p, start, ec, Ops ); },
+        std::move( token ), nullptr, "boost::filesystem::proximate", p, start   );
+}
+
+
+//! \brief  Awaitable `weakly_canonical( p, ec, ops )` run on `executor`
+template<class Operations, class Executor>
+async_path_operation<Executor>
+async_weakly_canonical( const path_t& p, boost::system::error_code& ec, const Operations& ops, Executor& executor, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<Operations> Ops( ops, token );
+    return async_path_operation<Executor>
+    (   executor,
+        [p, Ops]( boost::system::error_code& ec ) { return weakly_canonical( p, ec, Ops ); },
+        std::move( token ), &ec, "boost::filesystem::weakly_canonical", p   );
+}
+
+
+//! \brief  Awaitable `weakly_canonical( p, ec )` run on the default thread pool
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_weakly_canonical( const path_t& p, boost::system::error_code& ec, xstd::filesystem::cancellation_token token = {} )
+{
+    return async_weakly_canonical( p, ec, system_operations(), xstd::filesystem::thread_pool::default_pool(), std::move( token ) );
+}
+
+
+//! \brief  Awaitable `canonical( p, ec )` answered by `ops` on `executor`
+template<class Operations, class Executor>
+async_path_operation<Executor>
+async_canonical( const path_t& p, boost::system::error_code& ec, const Operations& ops, Executor& executor, xstd::filesystem::cancellation_token token = {} )
+{
+    cancellable_operations<Operations> Ops( ops, token );
+    return async_path_operation<Executor>
+    (   executor,
+        [p, Ops]( boost::system::error_code& ec )
+        {
+            auto real_p = absolute_helper( p, ec, Ops );
+            return ec ? path_t() : Ops.canonical( real_p, ec );
+        },
+        std::move( token ), &ec, "boost::filesystem::canonical", p   );
+}
+
+
+//! \brief  Awaitable `canonical( p, ec )` run on the default thread pool
+inline
+async_path_operation<xstd::filesystem::thread_pool>
+async_canonical( const path_t& p, boost::system::error_code& ec, xstd::filesystem::cancellation_token token = {} )
+{
+    return async_canonical( p, ec, system_operations(), xstd::filesystem::thread_pool::default_pool(), std::move( token ) );
+}
+
+
+#endif
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,47 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_async_operations
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_async_operations_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+#if defined( XSTD_FILESYSTEM_HAS_COROUTINES )
+
+BOOST_AUTO_TEST_CASE( test_case_async_real_relative_paths )
+{
+    test_async_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_async_multiple_nested_symlinks )
+{
+    test_async_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_async_imaginary_relative_paths )
+{
+    test_async_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_async_real_and_imaginary_relative_paths )
+{
+    test_async_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_async_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_async_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_async_executor_and_cancellation )
+{
+    test_async_executor_and_cancellation();
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_case_async_unavailable )
+{
+    BOOST_TEST_MESSAGE( "C++20 coroutines are not available, so there is nothing to test" );
+}
+
+#endif
@@ -0,0 +1,550 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_BATCH_RESOLVER_HPP_INCLUDED
+#define XSTD_FILESYSTEM_BATCH_RESOLVER_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/io_uring_ring.hpp>
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cerrno>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  The outcome of resolving one path of a batch
+struct batch_resolution
+{
+    //! True if the path exists
+    bool                        found = false;
+
+    //! True if the path exists and is a directory
+    bool                        is_directory = false;
+
+    //! `canonical( p )` if the path exists, otherwise `weakly_canonical( p )`
+    boost::filesystem::path_t   real_path;
+};
+
+
+//! \brief  Resolves batches of paths together, issuing the `lstat` calls of
+//!         every path that is part way through its resolution at once.
+//!
+//!         Each path is walked one element at a time, following symlinks,
+//!         as `canonical` does. A round collects the next element of every
+//!         unfinished path, removes duplicates and those already examined,
+//!         and stats them all before any path moves on, so paths sharing
+//!         directories share the work and a cold cache is read with many
+//!         requests outstanding rather than one.
+//!
+//!         Where io_uring is available each round is submitted to the
+//!         kernel as `IORING_OP_STATX` requests; otherwise the round is
+//!         split across a number of threads. io_uring has no readlink
+//!         operation so symlinks are read with `readlink`, once each per
+//!         batch, on the same threads as the fallback.
+//!
+//!         A resolver handles one batch at a time.
+class batch_resolver
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    enum class backend
+    {
+        automatic,
+        io_uring,
+        threads
+    };
+
+    //! The most symlinks followed in one resolution, as for `canonical`
+    static const int max_symlinks = 40;
+
+    //! \brief  Resolve with io_uring if it is available and `backend` allows,
+    //!         otherwise with `threads` threads, or one per core if 0.
+    //!         `queue_depth` is the most requests io_uring keeps in flight.
+    explicit batch_resolver( backend Backend = backend::automatic, std::size_t Threads = 0, unsigned QueueDepth = 256 )
+    : Threads_( Threads ? Threads : default_thread_count() )
+    {
+#if defined( XSTD_FILESYSTEM_HAS_IO_URING )
+        if( Backend != backend::threads )
+        {
+            Ring_.reset( new io_uring_ring( QueueDepth ) );
+            if( !Ring_->valid() )
+            {
+                Ring_.reset();
+            }
+        }
+#else
+        (void)Backend;
+        (void)QueueDepth;
+#endif
+    }
+
+    batch_resolver( const batch_resolver& ) = delete;
+    batch_resolver& operator=( const batch_resolver& ) = delete;
+
+    //! \brief  Return true if rounds are submitted through io_uring
+    bool uses_io_uring() const noexcept
+    {
+#if defined( XSTD_FILESYSTEM_HAS_IO_URING )
+        return static_cast<bool>( Ring_ );
+#else
+        return false;
+#endif
+    }
+
+    //! \brief  Resolve every path in `paths`, calling `resolved( index,
+    //!         resolution )` for each as soon as it is complete, so paths
+    //!         that are resolved in fewer rounds are reported first. Relative
+    //!         paths are first made absolute.
+    template<class Callback>
+    void resolve( const std::vector<path_t>& Paths, Callback Resolved )
+    {
+        std::vector<walk> Walks( Paths.size() );
+        std::vector<std::size_t> Active;
+        for( std::size_t Index = 0; Index != Paths.size(); ++Index )
+        {
+            auto& Walk = Walks[Index];
+            auto Path = Paths[Index].is_relative() ? boost::filesystem::absolute( Paths[Index] ) : Paths[Index];
+            if( Path.has_root_name() )
+            {
+                // Not walked element by element, so resolved directly
+                batch_resolution Result;
+                boost::system::error_code ec;
+                Result.found = boost::filesystem::exists( Path, ec );
+                Result.is_directory = Result.found && boost::filesystem::is_directory( Path, ec );
+                Result.real_path = Result.found ? boost::filesystem::canonical( Path, ec ) : weakly_canonical( Path, ec );
+                Resolved( Index, std::move( Result ) );
+                continue;
+            }
+            for( auto Element = ++Path.begin(); Element != Path.end(); ++Element )
+            {
+                Walk.elements.push_back( Element->native() );
+            }
+            Active.push_back( Index );
+        }
+
+        std::unordered_map<std::string, lstat_request>  Stats;
+        std::unordered_map<std::string, target>         Targets;
+
+        std::vector<std::string> Needed;
+        std::vector<std::string> NeededTargets;
+
+        while( !Active.empty() )
+        {
+            Needed.clear();
+            NeededTargets.clear();
+
+            // Every walk advances before any request is recorded, so a walk
+            // never mistakes a request made this round for its answer
+            std::size_t Remaining = 0;
+            for( auto Index: Active )
+            {
+                auto& Walk = Walks[Index];
+                if( advance( Walk, Stats, Targets ) )
+                {
+                    Resolved( Index, finish( Walk ) );
+                    continue;
+                }
+                Active[Remaining++] = Index;
+            }
+            Active.resize( Remaining );
+
+            for( auto Index: Active )
+            {
+                auto& Walk = Walks[Index];
+                if( Walk.needs_target )
+                {
+                    if( Targets.emplace( Walk.candidate, target() ).second )
+                    {
+                        NeededTargets.push_back( Walk.candidate );
+                    }
+                }
+                else if( Stats.emplace( Walk.candidate, lstat_request() ).second )
+                {
+                    Needed.push_back( Walk.candidate );
+                }
+            }
+
+            stat_all( Needed, Stats );
+            read_all( NeededTargets, Targets );
+        }
+    }
+
+private:
+
+    struct target
+    {
+        int         error = 0;
+        std::string path;
+    };
+
+    //! The state of one path part way through its resolution
+    struct walk
+    {
+        //! The elements of the path below the root directory
+        std::vector<std::string> elements;
+
+        //! The index of the next element of `elements` to start on
+        std::size_t next = 0;
+
+        //! The elements still to resolve for the current element of
+        //! `elements`, which grows as symlinks are expanded
+        std::deque<std::string> expansion;
+
+        //! The real path resolved so far, and whether it is a directory
+        std::string real = "/";
+        bool        is_directory = true;
+
+        //! The real path and element index before the current element, so
+        //! that a failure part way through expanding it is undone
+        std::string committed = "/";
+        std::size_t committed_index = 0;
+
+        int         symlinks = 0;
+        bool        found = false;
+
+        //! The path to `lstat`, or to read if `needs_target`, before the
+        //! walk can continue
+        std::string candidate;
+        bool        needs_target = false;
+    };
+
+    //! Walk as far as the results gathered so far allow, returning true once
+    //! the walk has finished
+    static bool advance( walk& Walk, const std::unordered_map<std::string, lstat_request>& Stats, const std::unordered_map<std::string, target>& Targets )
+    {
+        while( true )
+        {
+            if( Walk.expansion.empty() )
+            {
+                Walk.committed = Walk.real;
+                Walk.committed_index = Walk.next;
+                if( Walk.next == Walk.elements.size() )
+                {
+                    Walk.found = true;
+                    return true;
+                }
+                Walk.expansion.push_back( Walk.elements[Walk.next++] );
+            }
+
+            // Anything below a file fails with ENOTDIR, even "." and ".."
+            if( !Walk.is_directory )
+            {
+                return true;
+            }
+
+            const auto& Element = Walk.expansion.front();
+            if( Element == "." )
+            {
+                Walk.expansion.pop_front();
+                continue;
+            }
+            if( Element == ".." )
+            {
+                auto Slash = Walk.real.rfind( '/' );
+                Walk.real.erase( Slash ? Slash : 1 );
+                Walk.expansion.pop_front();
+                continue;
+            }
+
+            auto Candidate = Walk.real.size() == 1 ? "/" + Element : Walk.real + '/' + Element;
+            auto Stat = Stats.find( Candidate );
+            if( Stat == Stats.end() )
+            {
+                Walk.candidate = std::move( Candidate );
+                Walk.needs_target = false;
+                return false;
+            }
+            if( Stat->second.error )
+            {
+                return true;
+            }
+            if( !S_ISLNK( Stat->second.mode ) )
+            {
+                Walk.real = std::move( Candidate );
+                Walk.is_directory = S_ISDIR( Stat->second.mode );
+                Walk.expansion.pop_front();
+                continue;
+            }
+
+            auto Target = Targets.find( Candidate );
+            if( Target == Targets.end() )
+            {
+                Walk.candidate = std::move( Candidate );
+                Walk.needs_target = true;
+                return false;
+            }
+            if( Target->second.error || Target->second.path.empty() || ++Walk.symlinks > max_symlinks )
+            {
+                return true;
+            }
+
+            Walk.expansion.pop_front();
+            const auto& Link = Target->second.path;
+            std::vector<std::string> Elements;
+            for( std::size_t Start = 0; Start < Link.size(); )
+            {
+                auto End = Link.find( '/', Start );
+                if( End == std::string::npos )
+                {
+                    End = Link.size();
+                }
+                if( End != Start )
+                {
+                    Elements.push_back( Link.substr( Start, End - Start ) );
+                }
+                Start = End + 1;
+            }
+            Walk.expansion.insert( Walk.expansion.begin(), Elements.begin(), Elements.end() );
+            if( Link[0] == '/' )
+            {
+                Walk.real = "/";
+            }
+        }
+    }
+
+    static batch_resolution finish( const walk& Walk )
+    {
+        batch_resolution Result;
+        if( Walk.found )
+        {
+            Result.found = true;
+            Result.is_directory = Walk.is_directory;
+            Result.real_path = Walk.real;
+            return Result;
+        }
+
+        // As `weakly_canonical`: the deepest existing leading elements made
+        // canonical, followed by the rest normalized
+        path_t Remainder;
+        for( auto Element = Walk.committed_index; Element != Walk.elements.size(); ++Element )
+        {
+            Remainder /= Walk.elements[Element];
+        }
+        Result.real_path = normalize( path_t( Walk.committed ) / Remainder );
+        return Result;
+    }
+
+    void stat_all( const std::vector<std::string>& Paths, std::unordered_map<std::string, lstat_request>& Stats )
+    {
+        std::vector<lstat_request*> Requests;
+        for( const auto& Path: Paths )
+        {
+            auto& Entry = *Stats.find( Path );
+            Entry.second.path = Entry.first.c_str();
+            Requests.push_back( &Entry.second );
+        }
+
+#if defined( XSTD_FILESYSTEM_HAS_IO_URING )
+        if( Ring_ )
+        {
+            std::vector<lstat_request> Batch;
+            Batch.reserve( Requests.size() );
+            for( auto Request: Requests )
+            {
+                Batch.push_back( *Request );
+            }
+            if( Ring_->lstat( Batch.data(), Batch.data() + Batch.size() ) )
+            {
+                for( std::size_t Index = 0; Index != Batch.size(); ++Index )
+                {
+                    *Requests[Index] = Batch[Index];
+                }
+                return;
+            }
+            // The ring has failed, having waited for everything it had in
+            // flight, so stop using it
+            Ring_.reset();
+        }
+#endif
+
+        parallel_for( Requests.size(), Threads_, [&]( std::size_t First, std::size_t Last )
+        {
+            for( auto Index = First; Index != Last; ++Index )
+            {
+                auto& Request = *Requests[Index];
+                struct stat Status;
+                Request.error = ::lstat( Request.path, &Status ) == 0 ? 0 : errno;
+                Request.mode = Request.error ? 0 : Status.st_mode;
+            }
+        } );
+    }
+
+    void read_all( const std::vector<std::string>& Paths, std::unordered_map<std::string, target>& Targets )
+    {
+        std::vector<target*> Results;
+        for( const auto& Path: Paths )
+        {
+            Results.push_back( &Targets[Path] );
+        }
+
+        parallel_for( Paths.size(), Threads_, [&]( std::size_t First, std::size_t Last )
+        {
+            for( auto Index = First; Index != Last; ++Index )
+            {
+                auto& Result = *Results[Index];
+                Result.path.resize( 256 );
+                while( true )
+                {
+                    auto Size = ::readlink( Paths[Index].c_str(), &Result.path[0], Result.path.size() );
+                    if( Size < 0 )
+                    {
+                        Result.error = errno;
+                        Result.path.clear();
+                        break;
+                    }
+                    if( static_cast<std::size_t>( Size ) < Result.path.size() )
+                    {
+                        Result.path.resize( static_cast<std::size_t>( Size ) );
+                        break;
+                    }
+                    Result.path.resize( Result.path.size() * 2 );
+                }
+            }
+        } );
+    }
+
+    std::size_t                     Threads_;
+#if defined( XSTD_FILESYSTEM_HAS_IO_URING )
+    std::unique_ptr<io_uring_ring>  Ring_;
+#endif
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Batch operations - not part of the proposal
+
+
+//! \brief  Compute `relative( p, start, ec )` for every pair in `pairs`,
+//!         calling `done( index, relative, ec )` for each pair as soon as
+//!         both of its paths are resolved
+//!
+//! \param  pairs - the (p, start) pairs to compute relative paths for
+//!
+//! \param  done - called once per pair, in order of completion
+//!
+//! \param  resolver - resolves all the distinct paths of `pairs` together
+//!
+//! \note   The results are those of `relative` called for each pair in turn,
+//!         provided the filesystem does not change during the batch.
+template<class Callback>
+void
+batch_relative( const std::vector<std::pair<path_t, path_t>>& Pairs, Callback Done, xstd::filesystem::batch_resolver& Resolver )
+{
+    // Each distinct path is resolved once, however many pairs it appears in
+    std::vector<path_t> Paths;
+    std::vector<std::vector<std::size_t>> Users;
+    std::unordered_map<std::string, std::size_t> Indices;
+    std::vector<std::pair<std::size_t, std::size_t>> PairPaths;
+
+    auto index_of = [&]( const path_t& p, std::size_t Pair )
+    {
+        auto Inserted = Indices.emplace( p.native(), Paths.size() );
+        if( Inserted.second )
+        {
+            Paths.push_back( p );
+            Users.emplace_back();
+        }
+        auto Index = Inserted.first->second;
+        if( Users[Index].empty() || Users[Index].back() != Pair )
+        {
+            Users[Index].push_back( Pair );
+        }
+        return Index;
+    };
+    for( std::size_t Pair = 0; Pair != Pairs.size(); ++Pair )
+    {
+        auto Path  = index_of( Pairs[Pair].first, Pair );
+        auto Start = index_of( Pairs[Pair].second, Pair );
+        PairPaths.emplace_back( Path, Start );
+    }
+
+    std::vector<xstd::filesystem::batch_resolution> Resolutions( Paths.size() );
+    std::vector<bool> Finished( Paths.size() );
+
+    Resolver.resolve( Paths, [&]( std::size_t Index, xstd::filesystem::batch_resolution&& Resolution )
+    {
+        Resolutions[Index] = std::move( Resolution );
+        Finished[Index] = true;
+
+        for( auto Pair: Users[Index] )
+        {
+            auto Path  = PairPaths[Pair].first;
+            auto Start = PairPaths[Pair].second;
+            if( !Finished[Path] || !Finished[Start] )
+            {
+                continue;
+            }
+
+            boost::system::error_code ec;
+            const auto& real_start = Resolutions[Start];
+            if( real_start.found && !real_start.is_directory )
+            {
+                ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+                Done( Pair, path_t(), ec );
+            }
+            else
+            {
+                Done( Pair, lexically_relative( Resolutions[Path].real_path, real_start.real_path ), ec );
+            }
+        }
+    } );
+}
+
+
+//! \brief  Compute `proximate( p, start, ec )` for every pair in `pairs`,
+//!         calling `done( index, proximate, ec )` for each pair as soon as
+//!         both of its paths are resolved
+//!
+//! \note   As `batch_relative`.
+template<class Callback>
+void
+batch_proximate( const std::vector<std::pair<path_t, path_t>>& Pairs, Callback Done, xstd::filesystem::batch_resolver& Resolver )
+{
+    batch_relative( Pairs, [&]( std::size_t Pair, path_t&& Relative, const boost::system::error_code& ec )
+    {
+        Done( Pair, Relative.empty() ? path_t( Pairs[Pair].first ) : std::move( Relative ), ec );
+    },
+    Resolver );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,36 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_batch_resolver
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_batch_resolver_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_batch_resolver_backends )
+{
+    test_batch_resolver_backends();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_batch_real_relative_paths )
+{
+    test_batch_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_batch_multiple_nested_symlinks )
+{
+    test_batch_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_batch_imaginary_relative_paths )
+{
+    test_batch_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_batch_real_and_imaginary_relative_paths )
+{
+    test_batch_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_batch_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_batch_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
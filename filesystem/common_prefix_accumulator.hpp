@@ -0,0 +1,146 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_COMMON_PREFIX_ACCUMULATOR_HPP_INCLUDED
+#define XSTD_FILESYSTEM_COMMON_PREFIX_ACCUMULATOR_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Maintain the common prefix of a stream of paths, one path at a time
+//!
+//!         After adding the paths in [first,last), in any order and split
+//!         across any number of merged accumulators, `prefix()` is equal to
+//!         `common_prefix( first, last )`. Adding a path costs time
+//!         proportional to the depth of the current prefix.
+class common_prefix_accumulator
+{
+public:
+
+    //! \brief  Narrow the prefix to the elements it shares with `p`
+    void add( const path_t& p )
+    {
+        if( Count_++ == 0 )
+        {
+            for( const auto& Element: p )
+            {
+                push( Element );
+            }
+            return;
+        }
+
+        std::size_t Matched = 0;
+        auto Element = p.begin();
+        auto End     = p.end();
+
+        for( ; Matched != Elements_.size() && Element != End; ++Matched, ++Element )
+        {
+            if( *Element != Elements_[Matched] )
+            {
+                break;
+            }
+        }
+        truncate( Matched );
+    }
+
+    //! \brief  Combine with an accumulator that has seen another part of the
+    //!         same sequence, as if all of its paths had been added here
+    void merge( const common_prefix_accumulator& Other )
+    {
+        if( Other.Count_ == 0 )
+        {
+            return;
+        }
+        if( Count_ == 0 )
+        {
+            *this = Other;
+            return;
+        }
+        Count_ += Other.Count_;
+
+        std::size_t Matched = 0;
+        for( ; Matched != Elements_.size() && Matched != Other.Elements_.size(); ++Matched )
+        {
+            if( Elements_[Matched] != Other.Elements_[Matched] )
+            {
+                break;
+            }
+        }
+        truncate( Matched );
+    }
+
+    //! \brief  Return the common prefix of all paths seen so far, if any,
+    //!         path() otherwise
+    const path_t& prefix() const noexcept
+    {
+        return Prefix_;
+    }
+
+    //! \brief  Return the number of elements in the current prefix
+    std::size_t depth() const noexcept
+    {
+        return Elements_.size();
+    }
+
+    //! \brief  Return the number of paths seen so far
+    std::size_t size() const noexcept
+    {
+        return Count_;
+    }
+
+    void clear()
+    {
+        Count_ = 0;
+        Elements_.clear();
+        Sizes_.clear();
+        Prefix_.clear();
+    }
+
+private:
+
+    void push( const path_t& Element )
+    {
+        Prefix_ /= Element;
+        Elements_.push_back( Element );
+        Sizes_.push_back( Prefix_.native().size() );
+    }
+
+    void truncate( std::size_t Depth )
+    {
+        if( Depth == Elements_.size() )
+        {
+            return;
+        }
+        Elements_.resize( Depth );
+        Sizes_.resize( Depth );
+        Prefix_ = path_t( Prefix_.native().substr( 0, Depth ? Sizes_.back() : 0 ) );
+    }
+
+    std::size_t                 Count_ = 0;
+    std::vector<path_t>         Elements_;
+    std::vector<std::size_t>    Sizes_;
+    path_t                      Prefix_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -31,3 +31,22 @@ BOOST_AUTO_TEST_CASE( test_case_common_prefix_from_initializer_list )
     test_common_prefix_from_initializer_list();
 }
 
+BOOST_AUTO_TEST_CASE( test_case_common_prefix_accumulator )
+{
+    test_common_prefix_accumulator();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_common_prefix_accumulator_merge )
+{
+    test_common_prefix_accumulator_merge();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_group_by_common_prefix )
+{
+    test_group_by_common_prefix();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_group_by_common_prefix_large )
+{
+    test_group_by_common_prefix_large();
+}
@@ -0,0 +1,243 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_CONCURRENT_PATH_MAP_HPP_INCLUDED
+#define XSTD_FILESYSTEM_CONCURRENT_PATH_MAP_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  An insert-only map from path to path that many threads can read
+//!         and write at once without taking a lock.
+//!
+//!         The map is a fixed array of buckets, each the head of a singly
+//!         linked list. An entry is never changed or removed once it has
+//!         been published, so `find` simply follows the list for its bucket
+//!         and never waits for a writer. `insert` links a new entry in
+//!         front of the current head with a compare-and-swap, retrying only
+//!         if another thread inserted into the same bucket at the same time.
+//!
+//!         The bucket count is fixed at construction and should be about
+//!         the number of entries expected; lists simply grow longer past
+//!         that. Memory is released when the map is destroyed.
+class concurrent_path_map
+{
+public:
+
+    static const std::size_t default_buckets = 64 * 1024;
+
+    explicit concurrent_path_map( std::size_t Buckets = default_buckets )
+    : Mask_( bucket_count_for( Buckets ) - 1 )
+    , Buckets_( new std::atomic<node*>[ Mask_ + 1 ] )
+    {
+        for( std::size_t i = 0; i != Mask_ + 1; ++i )
+        {
+            Buckets_[i].store( nullptr, std::memory_order_relaxed );
+        }
+    }
+
+    concurrent_path_map( const concurrent_path_map& ) = delete;
+    concurrent_path_map& operator=( const concurrent_path_map& ) = delete;
+
+    ~concurrent_path_map()
+    {
+        for( std::size_t i = 0; i != Mask_ + 1; ++i )
+        {
+            node* Node = Buckets_[i].load( std::memory_order_relaxed );
+            while( Node )
+            {
+                node* Next = Node->next;
+                delete Node;
+                Node = Next;
+            }
+        }
+    }
+
+    //! \brief  Return the value for `key`, or null if there is none. The
+    //!         value remains valid for the lifetime of the map.
+    const boost::filesystem::path_t* find( const boost::filesystem::path_t& Key ) const noexcept
+    {
+        std::size_t Hash = hash( Key.native() );
+        for( node* Node = Buckets_[ Hash & Mask_ ].load( std::memory_order_acquire ); Node; Node = Node->next )
+        {
+            if( Node->hash == Hash && Node->key == Key.native() )
+            {
+                return &Node->value;
+            }
+        }
+        return nullptr;
+    }
+
+    //! \brief  Map `key` to `value` unless `key` is already present, and
+    //!         return the value now held for `key`
+    const boost::filesystem::path_t& insert( const boost::filesystem::path_t& Key, const boost::filesystem::path_t& Value )
+    {
+        std::size_t Hash = hash( Key.native() );
+        auto& Bucket = Buckets_[ Hash & Mask_ ];
+
+        std::unique_ptr<node> New( new node{ Hash, Key.native(), Value, nullptr } );
+        node* Head = Bucket.load( std::memory_order_acquire );
+        node* Searched = nullptr;
+
+        while( true )
+        {
+            // Only the entries added since the last attempt need checking
+            for( node* Node = Head; Node != Searched; Node = Node->next )
+            {
+                if( Node->hash == Hash && Node->key == New->key )
+                {
+                    return Node->value;
+                }
+            }
+            Searched = Head;
+            New->next = Head;
+            if( Bucket.compare_exchange_weak( Head, New.get(), std::memory_order_release, std::memory_order_acquire ) )
+            {
+                Size_.fetch_add( 1, std::memory_order_relaxed );
+                return New.release()->value;
+            }
+        }
+    }
+
+    //! \brief  Return the number of entries
+    std::size_t size() const noexcept
+    {
+        return Size_.load( std::memory_order_relaxed );
+    }
+
+    std::size_t bucket_count() const noexcept
+    {
+        return Mask_ + 1;
+    }
+
+private:
+
+    struct node
+    {
+        std::size_t                 hash;
+        std::string                 key;
+        boost::filesystem::path_t   value;
+        node*                       next;
+    };
+
+    static std::size_t bucket_count_for( std::size_t Buckets )
+    {
+        std::size_t Count = 1;
+        while( Count < Buckets )
+        {
+            Count <<= 1;
+        }
+        return Count;
+    }
+
+    static std::size_t hash( const std::string& Key )
+    {
+        std::size_t Hashed = std::hash<std::string>()( Key );
+        // Buckets are chosen by the low bits so spread the high bits into them
+        Hashed ^= Hashed >> 29;
+        Hashed *= static_cast<std::size_t>( 0x9e3779b97f4a7c15ull );
+        return Hashed ^ ( Hashed >> ( sizeof( std::size_t ) * 4 ) );
+    }
+
+    std::size_t                             Mask_;
+    std::unique_ptr<std::atomic<node*>[]>   Buckets_;
+    std::atomic<std::size_t>                Size_{ 0 };
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations for `relative` and `proximate` that remember
+//!         the result of `canonical` for absolute paths in a shared
+//!         concurrent_path_map and forward everything else to `Operations`.
+//!
+//!         Cached entries are never invalidated, so the map must only be
+//!         shared for as long as the symlinks it has seen are not changed.
+//!         Use a new map to start again.
+template<class Operations = system_operations>
+class cached_canonical_operations
+{
+public:
+
+    explicit cached_canonical_operations( xstd::filesystem::concurrent_path_map& Map, const Operations& Ops = Operations() )
+    : Map_( Map )
+    , Ops_( Ops )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        // A relative path depends on the current directory so is not cached
+        if( p.is_relative() )
+        {
+            return Ops_.canonical( p, ec );
+        }
+        if( auto Cached = Map_.find( p ) )
+        {
+            ec.clear();
+            return *Cached;
+        }
+        auto real_p = Ops_.canonical( p, ec );
+        if( ec )
+        {
+            return real_p;
+        }
+        return Map_.insert( p, real_p );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return Ops_.current_path( ec );
+    }
+
+private:
+
+    xstd::filesystem::concurrent_path_map&  Map_;
+    Operations                              Ops_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,36 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_concurrent_path_map
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_concurrent_path_map_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_path_map_insert_and_find )
+{
+    test_concurrent_path_map_insert_and_find();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_path_map_concurrent_insert )
+{
+    test_concurrent_path_map_concurrent_insert();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_real_relative_paths )
+{
+    test_concurrent_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_multiple_nested_symlinks )
+{
+    test_concurrent_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_real_and_imaginary_relative_paths )
+{
+    test_concurrent_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_concurrent_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_concurrent_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
@@ -0,0 +1,642 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_DIRFD_RESOLVER_HPP_INCLUDED
+#define XSTD_FILESYSTEM_DIRFD_RESOLVER_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  The outcome of resolving a path with a dirfd_resolver
+struct dirfd_resolution
+{
+    //! True if the path exists, in which case `real_path` and `mode` are set
+    bool            found = false;
+
+    //! The path with every symlink, ".", ".." and redundant separator removed
+    std::string     real_path;
+
+    //! The `st_mode` of the object the path refers to
+    mode_t          mode = 0;
+};
+
+
+//! \brief  Resolves absolute paths one element at a time relative to open
+//!         directory file descriptors rather than from "/" each time.
+//!
+//!         A resolution starts from the deepest anchor whose path is a
+//!         leading run of elements of the path being resolved, and walks
+//!         the remaining elements with `fstatat`, `readlinkat` and `openat`,
+//!         following symlinks in user space. Anchors are only added by
+//!         `anchor` and stay open until `clear` is called or the resolver
+//!         is destroyed.
+//!
+//!         Anchors are kept by the real path of the directory, and the
+//!         paths passed to `anchor` are remembered as spellings of them.
+//!         Before an anchor is used its spelling is checked to still refer
+//!         to the same device and inode, with one `stat` when the root is
+//!         "/" or by walking it otherwise, so a symlink that is retargeted
+//!         or a directory that is replaced is never resolved through. A
+//!         spelling found to be stale is forgotten.
+//!
+//!         Given a root, paths are resolved as if the process were chrooted
+//!         there and real paths are relative to it. The walk clamps ".." and
+//!         absolute symlinks to the root itself but, unlike `openat2` with
+//!         `RESOLVE_IN_ROOT`, cannot stop a directory being moved out of the
+//!         root part way through a resolution.
+//!
+//!         `resolve` and `anchor` may be called concurrently; `clear` may not
+//!         be called concurrently with anything else.
+class dirfd_resolver
+{
+public:
+
+    static const std::size_t default_max_anchors = 256;
+
+    //! The most symlinks followed in one resolution before failing with ELOOP
+    static const int max_symlinks = 40;
+
+    explicit dirfd_resolver( std::size_t MaxAnchors = default_max_anchors )
+    : dirfd_resolver( "/", MaxAnchors )
+    {
+    }
+
+    //! \brief  Resolve paths as if `root` were "/". ".." never leaves `root`
+    //!         and absolute symlinks are resolved from `root`.
+    explicit dirfd_resolver( const boost::filesystem::path_t& Root, std::size_t MaxAnchors = default_max_anchors )
+    : MaxAnchors_( MaxAnchors )
+    , RootFd_( ::open( Root.c_str(), directory_flags ) )
+    {
+        if( RootFd_ < 0 )
+        {
+            BOOST_FILESYSTEM_THROW
+            (   boost::filesystem::filesystem_error
+                (   "xstd::filesystem::dirfd_resolver",
+                    Root,
+                    boost::system::error_code( errno, boost::system::system_category() )   )   );
+        }
+        struct stat RootStatus;
+        struct stat SlashStatus;
+        Rooted_ = ::fstat( RootFd_, &RootStatus ) != 0
+               || ::stat( "/", &SlashStatus ) != 0
+               || SlashStatus.st_dev != RootStatus.st_dev
+               || SlashStatus.st_ino != RootStatus.st_ino;
+    }
+
+    dirfd_resolver( const dirfd_resolver& ) = delete;
+    dirfd_resolver& operator=( const dirfd_resolver& ) = delete;
+
+    ~dirfd_resolver()
+    {
+        clear();
+        ::close( RootFd_ );
+    }
+
+    //! \brief  Resolve the absolute path `p`. A path that does not exist is
+    //!         not an error.
+    dirfd_resolution resolve( const boost::filesystem::path_t& p, boost::system::error_code& ec ) const
+    {
+        return resolve_path( p, ec, false );
+    }
+
+    //! \brief  Resolve the directory `dir` and keep it open as an anchor,
+    //!         returning false if it could not be or the anchors are full
+    bool anchor( const boost::filesystem::path_t& Dir, boost::system::error_code& ec )
+    {
+        auto Result = resolve_path( Dir, ec, true );
+        if( !ec && Result.found && !S_ISDIR( Result.mode ) )
+        {
+            ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+        }
+        return !ec && Result.found && anchored( Dir );
+    }
+
+    //! \brief  Return true if `dir` is a spelling of an anchor
+    bool anchored( const boost::filesystem::path_t& Dir ) const
+    {
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        return Spellings_.count( Dir.native() ) != 0;
+    }
+
+    //! \brief  Return the number of anchors held open, not counting "/"
+    std::size_t anchors() const
+    {
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        return Anchors_.size();
+    }
+
+    //! \brief  Close every anchor
+    void clear()
+    {
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        for( auto& Anchor: Anchors_ )
+        {
+            ::close( Anchor.second.fd );
+        }
+        for( auto Fd: Retired_ )
+        {
+            ::close( Fd );
+        }
+        Anchors_.clear();
+        Spellings_.clear();
+        Retired_.clear();
+    }
+
+private:
+
+#ifdef O_PATH
+    static const int directory_flags = O_PATH | O_DIRECTORY | O_CLOEXEC;
+#else
+    static const int directory_flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+#endif
+
+    struct anchor_t
+    {
+        int         fd;
+        dev_t       device;
+        ino_t       inode;
+    };
+
+    //! Resolve `p` from the deepest anchor that still holds, keeping the
+    //! result open as an anchor if `anchor_result` is true and it is a
+    //! directory
+    dirfd_resolution resolve_path( const boost::filesystem::path_t& p, boost::system::error_code& ec, bool AnchorResult ) const
+    {
+        ec.clear();
+        dirfd_resolution Result;
+
+        const std::string& Spelled = p.native();
+        if( Spelled.empty() || Spelled[0] != '/' )
+        {
+            ec.assign( boost::system::errc::invalid_argument, boost::system::generic_category() );
+            return Result;
+        }
+
+        // Find the deepest anchor and queue the elements that follow it,
+        // last element first so that they can be popped in order
+        std::vector<path_element> Elements;
+        for( auto Elem = first_element( Spelled.data(), Spelled.size() ); !is_end( Elem ); Elem = next_element( Spelled.data(), Spelled.size(), Elem ) )
+        {
+            Elements.push_back( Elem );
+        }
+        if( Elements.front().kind != element_kind::root_directory )
+        {
+            ec.assign( boost::system::errc::invalid_argument, boost::system::generic_category() );
+            return Result;
+        }
+
+        walk Walk{ RootFd_, false, "/" };
+        std::size_t Anchored = 1;
+        for( std::size_t Depth = Elements.size(); Depth > 1; --Depth )
+        {
+            auto Prefix = Spelled.substr( 0, Elements[Depth - 1].last );
+            anchor_t Anchor;
+            std::string RealPath;
+            if( !find_anchor( Prefix, Anchor, RealPath ) )
+            {
+                continue;
+            }
+            if( !refers_to( Prefix, Anchor ) )
+            {
+                forget_spelling( Prefix, RealPath );
+                continue;
+            }
+            Walk.fd = Anchor.fd;
+            Walk.real_path = std::move( RealPath );
+            Anchored = Depth;
+            break;
+        }
+
+        std::vector<std::string> Pending;
+        for( std::size_t Depth = Elements.size(); Depth > Anchored; --Depth )
+        {
+            Pending.emplace_back( Elements[Depth - 1].data, Elements[Depth - 1].size );
+        }
+
+        if( !walk_elements( Walk, Pending, Result, ec ) || !AnchorResult || !S_ISDIR( Result.mode ) )
+        {
+            return Result;
+        }
+        // Reaching an existing anchor, or the root, leaves nothing to open
+        // but `dir` is still remembered as a spelling of the anchor
+        add_anchor( Spelled, Walk.owned ? Walk.fd : -1, Result.real_path );
+        Walk.owned = false;
+        return Result;
+    }
+
+    //! The directory a walk has reached. `fd` is closed by the walk only if
+    //! it is `owned`, anchors and the root are shared.
+    struct walk
+    {
+        int         fd;
+        bool        owned;
+        std::string real_path;
+
+        walk( int Fd, bool Owned, std::string RealPath )
+        : fd( Fd ), owned( Owned ), real_path( std::move( RealPath ) )
+        {
+        }
+
+        walk( const walk& ) = delete;
+        walk& operator=( const walk& ) = delete;
+
+        ~walk()
+        {
+            if( owned )
+            {
+                ::close( fd );
+            }
+        }
+
+        void descend( int Fd, bool Owned = true )
+        {
+            if( owned )
+            {
+                ::close( fd );
+            }
+            fd = Fd;
+            owned = Owned;
+        }
+    };
+
+    static bool not_found( int Error )
+    {
+        return Error == ENOENT || Error == ENOTDIR;
+    }
+
+    //! Walk `pending` from the directory in `walk`. On return `walk` holds
+    //! the final directory if the path resolved to one that was opened.
+    bool walk_elements( walk& Walk, std::vector<std::string>& Pending, dirfd_resolution& Result, boost::system::error_code& ec ) const
+    {
+        mode_t Mode = S_IFDIR;
+        bool AtFinal = true;
+        int Symlinks = 0;
+
+        auto fail = [&ec]( int Error )
+        {
+            if( !not_found( Error ) )
+            {
+                ec.assign( Error, boost::system::system_category() );
+            }
+            return false;
+        };
+
+        while( !Pending.empty() )
+        {
+            std::string Name = std::move( Pending.back() );
+            Pending.pop_back();
+
+            if( Name.empty() || Name == "." )
+            {
+                continue;
+            }
+            if( Name == ".." )
+            {
+                // As in the kernel the parent of the root is the root
+                if( Walk.real_path == "/" )
+                {
+                    Walk.descend( RootFd_, false );
+                    Mode = S_IFDIR;
+                    AtFinal = true;
+                    continue;
+                }
+                // The walk follows the physical directory structure so the
+                // parent of the real path is the parent of the directory
+                int Parent = ::openat( Walk.fd, "..", directory_flags );
+                if( Parent < 0 )
+                {
+                    return fail( errno );
+                }
+                Walk.descend( Parent );
+                auto Slash = Walk.real_path.rfind( '/' );
+                Walk.real_path.resize( Slash ? Slash : 1 );
+                Mode = S_IFDIR;
+                AtFinal = true;
+                continue;
+            }
+
+            struct stat Status;
+            if( ::fstatat( Walk.fd, Name.c_str(), &Status, AT_SYMLINK_NOFOLLOW ) != 0 )
+            {
+                return fail( errno );
+            }
+
+            if( S_ISLNK( Status.st_mode ) )
+            {
+                if( ++Symlinks > max_symlinks )
+                {
+                    return fail( ELOOP );
+                }
+                std::string Target;
+                if( !read_link( Walk.fd, Name, Status, Target ) )
+                {
+                    return fail( errno );
+                }
+                if( Target.empty() )
+                {
+                    return fail( ENOENT );
+                }
+                if( Target[0] == '/' )
+                {
+                    Walk.descend( RootFd_, false );
+                    Walk.real_path = "/";
+                }
+                // POSIX leaves the meaning of a leading "//name" to the
+                // implementation and Linux reads it as "/name", so the text
+                // of a root-name is walked as the first element
+                std::vector<std::string> Elements;
+                for( auto Elem = first_element( Target.data(), Target.size() ); !is_end( Elem ); Elem = next_element( Target.data(), Target.size(), Elem ) )
+                {
+                    if( Elem.kind == element_kind::filename )
+                    {
+                        Elements.emplace_back( Elem.data, Elem.size );
+                    }
+                    else if( Elem.kind == element_kind::root_name && Elem.size > 2 )
+                    {
+                        Elements.emplace_back( Elem.data + 2, Elem.size - 2 );
+                    }
+                }
+                Pending.insert( Pending.end(), Elements.rbegin(), Elements.rend() );
+                Mode = S_IFDIR;
+                AtFinal = true;
+                continue;
+            }
+
+            if( Walk.real_path.back() != '/' )
+            {
+                Walk.real_path.push_back( '/' );
+            }
+            Walk.real_path.append( Name );
+            Mode = Status.st_mode;
+
+            if( Pending.empty() && !S_ISDIR( Mode ) )
+            {
+                AtFinal = false;
+                break;
+            }
+            if( !S_ISDIR( Mode ) )
+            {
+                return fail( ENOTDIR );
+            }
+            int Next = ::openat( Walk.fd, Name.c_str(), directory_flags );
+            if( Next < 0 )
+            {
+                return fail( errno );
+            }
+            Walk.descend( Next );
+            AtFinal = true;
+        }
+
+        if( !AtFinal && Walk.owned )
+        {
+            Walk.descend( -1, false );
+        }
+        Result.found = true;
+        Result.real_path = Walk.real_path;
+        Result.mode = Mode;
+        return true;
+    }
+
+    static bool read_link( int Fd, const std::string& Name, const struct stat& Status, std::string& Target )
+    {
+        // st_size is 0 for some virtual filesystems so grow until it fits
+        Target.resize( Status.st_size > 0 ? static_cast<std::size_t>( Status.st_size ) + 1 : 256 );
+        while( true )
+        {
+            auto Size = ::readlinkat( Fd, Name.c_str(), &Target[0], Target.size() );
+            if( Size < 0 )
+            {
+                return false;
+            }
+            if( static_cast<std::size_t>( Size ) < Target.size() )
+            {
+                Target.resize( static_cast<std::size_t>( Size ) );
+                return true;
+            }
+            Target.resize( Target.size() * 2 );
+        }
+    }
+
+    bool find_anchor( const std::string& Spelled, anchor_t& Anchor, std::string& RealPath ) const
+    {
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        auto Spelling = Spellings_.find( Spelled );
+        if( Spelling == Spellings_.end() )
+        {
+            return false;
+        }
+        auto Found = Anchors_.find( Spelling->second );
+        if( Found == Anchors_.end() )
+        {
+            return false;
+        }
+        Anchor = Found->second;
+        RealPath = Spelling->second;
+        return true;
+    }
+
+    //! Return true if `spelled` still resolves to the directory `anchor` is
+    //! open on. From "/" the kernel resolves it in one `stat`; below another
+    //! root absolute symlinks and ".." would escape, so it is walked.
+    bool refers_to( const std::string& Spelled, const anchor_t& Anchor ) const
+    {
+        struct stat Status;
+        if( !Rooted_ )
+        {
+            return ::stat( Spelled.c_str(), &Status ) == 0
+                && Status.st_dev == Anchor.device
+                && Status.st_ino == Anchor.inode;
+        }
+
+        std::vector<std::string> Pending;
+        for( auto Elem = first_element( Spelled.data(), Spelled.size() ); !is_end( Elem ); Elem = next_element( Spelled.data(), Spelled.size(), Elem ) )
+        {
+            if( Elem.kind == element_kind::filename )
+            {
+                Pending.emplace_back( Elem.data, Elem.size );
+            }
+        }
+        std::reverse( Pending.begin(), Pending.end() );
+
+        walk Walk{ RootFd_, false, "/" };
+        dirfd_resolution Result;
+        boost::system::error_code ec;
+        return walk_elements( Walk, Pending, Result, ec )
+            && S_ISDIR( Result.mode )
+            && ::fstat( Walk.fd, &Status ) == 0
+            && Status.st_dev == Anchor.device
+            && Status.st_ino == Anchor.inode;
+    }
+
+    void forget_spelling( const std::string& Spelled, const std::string& RealPath ) const
+    {
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        auto Spelling = Spellings_.find( Spelled );
+        if( Spelling != Spellings_.end() && Spelling->second == RealPath )
+        {
+            Spellings_.erase( Spelling );
+        }
+    }
+
+    //! Keep `fd`, if it is not -1, open as the anchor for `real_path` and
+    //! remember `spelled` as a spelling of it. A directory that has replaced
+    //! the one an anchor was open on replaces the anchor.
+    void add_anchor( const std::string& Spelled, int Fd, const std::string& RealPath ) const
+    {
+        struct stat Status;
+        if( Fd >= 0 && ::fstat( Fd, &Status ) != 0 )
+        {
+            ::close( Fd );
+            return;
+        }
+
+        std::lock_guard<std::mutex> Lock( AnchorsMutex_ );
+        auto Found = Anchors_.find( RealPath );
+        if( Fd >= 0 )
+        {
+            if( Found == Anchors_.end() && Anchors_.size() != MaxAnchors_ )
+            {
+                Found = Anchors_.emplace( RealPath, anchor_t{ Fd, Status.st_dev, Status.st_ino } ).first;
+            }
+            else if( Found != Anchors_.end() && ( Found->second.device != Status.st_dev || Found->second.inode != Status.st_ino ) )
+            {
+                // A resolution may still be walking from the old
+                // descriptor so it is only closed by `clear`
+                Retired_.push_back( Found->second.fd );
+                Found->second = anchor_t{ Fd, Status.st_dev, Status.st_ino };
+            }
+            else
+            {
+                ::close( Fd );
+            }
+        }
+        if( Found != Anchors_.end() && ( Spellings_.size() != MaxAnchors_ || Spellings_.count( Spelled ) ) )
+        {
+            Spellings_[Spelled] = RealPath;
+        }
+    }
+
+    std::size_t                                             MaxAnchors_;
+    int                                                     RootFd_;
+    bool                                                    Rooted_;
+    mutable std::mutex                                      AnchorsMutex_;
+    mutable std::unordered_map<std::string, anchor_t>       Anchors_;
+    mutable std::unordered_map<std::string, std::string>    Spellings_;
+    mutable std::vector<int>                                Retired_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations for `relative` and `proximate` that resolve
+//!         absolute paths with a dirfd_resolver. Nothing is anchored here;
+//!         anchor the directories that many paths will be resolved below,
+//!         such as a shared `start`, with `dirfd_resolver::anchor` first.
+//!
+//!         Paths that are relative or have a root-name are passed to
+//!         `system_operations`.
+class dirfd_operations
+{
+public:
+
+    explicit dirfd_operations( xstd::filesystem::dirfd_resolver& Resolver )
+    : Resolver_( Resolver )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        if( !resolvable( p ) )
+        {
+            return system_operations().exists( p, ec );
+        }
+        return Resolver_.resolve( p, ec ).found;
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        if( !resolvable( p ) )
+        {
+            return system_operations().is_directory( p, ec );
+        }
+        auto Result = Resolver_.resolve( p, ec );
+        return Result.found && S_ISDIR( Result.mode );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        if( !resolvable( p ) )
+        {
+            return system_operations().canonical( p, ec );
+        }
+        auto Result = Resolver_.resolve( p, ec );
+        if( ec )
+        {
+            return path_t();
+        }
+        if( !Result.found )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::system_category() );
+            return path_t();
+        }
+        return path_t( std::move( Result.real_path ) );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return system_operations().current_path( ec );
+    }
+
+private:
+
+    static bool resolvable( const path_t& p )
+    {
+        return p.has_root_directory() && !p.has_root_name();
+    }
+
+    xstd::filesystem::dirfd_resolver& Resolver_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
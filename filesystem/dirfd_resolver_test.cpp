@@ -0,0 +1,41 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_dirfd_resolver
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_dirfd_resolver_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_resolver_paths )
+{
+    test_dirfd_resolver_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_retargeted_symlink )
+{
+    test_dirfd_retargeted_symlink();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_real_relative_paths )
+{
+    test_dirfd_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_multiple_nested_symlinks )
+{
+    test_dirfd_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_imaginary_relative_paths )
+{
+    test_dirfd_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_real_and_imaginary_relative_paths )
+{
+    test_dirfd_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_dirfd_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_dirfd_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
@@ -0,0 +1,224 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_EQUIVALENCE_INDEX_HPP_INCLUDED
+#define XSTD_FILESYSTEM_EQUIVALENCE_INDEX_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <sys/stat.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Answers `equivalent` for many paths by calling `stat` once for
+//!         each distinct path and comparing the device and inode it
+//!         recorded, so checking N paths against M others costs N + M
+//!         calls rather than 2 * N * M.
+//!
+//!         What `stat` found is kept until `clear` is called, so the index
+//!         describes the filesystem as it was when each path was first seen.
+//!         Paths are compared as spelled; two spellings of one file are
+//!         each looked up once and then compare equal by inode.
+//!
+//!         An index is not safe to share between threads, except that `add`
+//!         itself spreads its `stat` calls across threads.
+class equivalence_index
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    equivalence_index() = default;
+
+    equivalence_index( const equivalence_index& ) = delete;
+    equivalence_index& operator=( const equivalence_index& ) = delete;
+
+    //! \brief  Look up every path in `paths` not already in the index using
+    //!         up to `threads` threads, or one per core if `threads` is 0
+    void add( const std::vector<path_t>& Paths, std::size_t Threads = 1 )
+    {
+        std::vector<std::pair<const std::string, entry>*> Unseen;
+        Unseen.reserve( Paths.size() );
+        for( const auto& Path : Paths )
+        {
+            auto Inserted = Entries_.emplace( Path.native(), entry() );
+            if( Inserted.second )
+            {
+                Unseen.push_back( &*Inserted.first );
+            }
+        }
+
+        work_stealing_for( Unseen.size(), Threads, [&]( std::size_t First, std::size_t Last )
+        {
+            for( ; First != Last; ++First )
+            {
+                Unseen[First]->second = look_up( Unseen[First]->first );
+            }
+        } );
+        Lookups_ += Unseen.size();
+    }
+
+    //! \brief  Return true if `p1` and `p2` resolve to the same file, as
+    //!         `boost::filesystem::equivalent` does
+    //!
+    //! \note   If neither path can be resolved `ec` is set to the error for
+    //!         `p1`; if only one cannot then the result is false and `ec` is
+    //!         cleared.
+    bool equivalent( const path_t& p1, const path_t& p2, boost::system::error_code& ec )
+    {
+        const auto& Entry1 = find( p1 );
+        const auto& Entry2 = find( p2 );
+        if( Entry1.error && Entry2.error )
+        {
+            ec.assign( Entry1.error, boost::system::system_category() );
+            return false;
+        }
+        ec.clear();
+        return !Entry1.error && !Entry2.error
+            && Entry1.device == Entry2.device
+            && Entry1.inode == Entry2.inode;
+    }
+
+    //! \brief  Return true if `p1` and `p2` resolve to the same file
+    //!
+    //! \throws boost::filesystem::filesystem_error if neither can be resolved
+    bool equivalent( const path_t& p1, const path_t& p2 )
+    {
+        boost::system::error_code ec;
+        auto Result = equivalent( p1, p2, ec );
+        if( ec )
+        {
+            BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::equivalence_index::equivalent", p1, p2, ec ) );
+        }
+        return Result;
+    }
+
+    //! \brief  Group the indices of `paths` by the file each resolves to,
+    //!         in the order each file is first reached. Paths that cannot be
+    //!         resolved are equivalent to nothing and are left out.
+    std::vector<std::vector<std::size_t>> classes( const std::vector<path_t>& Paths, std::size_t Threads = 1 )
+    {
+        add( Paths, Threads );
+
+        std::vector<std::vector<std::size_t>> Classes;
+        std::unordered_map<file_key, std::size_t, file_key_hash> ClassOf;
+        for( std::size_t Path = 0; Path != Paths.size(); ++Path )
+        {
+            const auto& Entry = find( Paths[Path] );
+            if( Entry.error )
+            {
+                continue;
+            }
+            auto Class = ClassOf.emplace( file_key{ Entry.device, Entry.inode }, Classes.size() );
+            if( Class.second )
+            {
+                Classes.emplace_back();
+            }
+            Classes[ Class.first->second ].push_back( Path );
+        }
+        return Classes;
+    }
+
+    //! \brief  Return the number of `stat` calls made so far
+    std::size_t lookups() const noexcept
+    {
+        return Lookups_;
+    }
+
+    //! \brief  Return the number of distinct paths in the index
+    std::size_t size() const noexcept
+    {
+        return Entries_.size();
+    }
+
+    //! \brief  Forget everything, so later queries see the filesystem afresh
+    void clear()
+    {
+        Entries_.clear();
+    }
+
+private:
+
+    struct entry
+    {
+        std::uint64_t   device = 0;
+        std::uint64_t   inode  = 0;
+        int             error  = 0;
+    };
+
+    struct file_key
+    {
+        std::uint64_t   device;
+        std::uint64_t   inode;
+
+        bool operator==( const file_key& Other ) const noexcept
+        {
+            return device == Other.device && inode == Other.inode;
+        }
+    };
+
+    struct file_key_hash
+    {
+        std::size_t operator()( const file_key& Key ) const noexcept
+        {
+            return std::hash<std::uint64_t>()( Key.inode * 0x9e3779b97f4a7c15ull ^ Key.device );
+        }
+    };
+
+    static entry look_up( const std::string& Path ) noexcept
+    {
+        entry Entry;
+        struct ::stat Status;
+        if( ::stat( Path.c_str(), &Status ) != 0 )
+        {
+            Entry.error = errno;
+            return Entry;
+        }
+        Entry.device = static_cast<std::uint64_t>( Status.st_dev );
+        Entry.inode  = static_cast<std::uint64_t>( Status.st_ino );
+        return Entry;
+    }
+
+    const entry& find( const path_t& p )
+    {
+        auto Found = Entries_.find( p.native() );
+        if( Found == Entries_.end() )
+        {
+            Found = Entries_.emplace( p.native(), look_up( p.native() ) ).first;
+            ++Lookups_;
+        }
+        return Found->second;
+    }
+
+    std::unordered_map<std::string, entry>  Entries_;
+    std::size_t                             Lookups_ = 0;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,26 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_equivalence_index
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_equivalence_index_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_equivalence_index_queries )
+{
+    test_equivalence_index_queries();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_equivalence_index_classes )
+{
+    test_equivalence_index_classes();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_equivalence_index_real_relative_paths )
+{
+    test_equivalence_index_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_equivalence_index_real_and_imaginary_relative_paths )
+{
+    test_equivalence_index_real_and_imaginary_relative_paths();
+}
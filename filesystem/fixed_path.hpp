@@ -0,0 +1,342 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_FIXED_PATH_HPP_INCLUDED
+#define XSTD_FILESYSTEM_FIXED_PATH_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  A path held in a fixed-capacity character buffer so that the
+//!         lexical operations `normalize`, `lexically_relative` and
+//!         `common_prefix` can be evaluated at compile time.
+//!
+//!         Results are formatted exactly as the `path_t` overloads would
+//!         format them, so `fixed.str() == normalize( path_t( fixed.c_str() ) )`
+//!         and so on.
+template<std::size_t N>
+class fixed_path
+{
+public:
+
+    static constexpr std::size_t capacity = N;
+
+    constexpr fixed_path() noexcept = default;
+
+    template<std::size_t M>
+    constexpr fixed_path( const char (&Source)[M] )
+    {
+        static_assert( M - 1 <= N, "string literal does not fit in fixed_path" );
+        append_chars( Source, M - 1 );
+    }
+
+    constexpr fixed_path( const char* Source, std::size_t Size )
+    {
+        append_chars( Source, Size );
+    }
+
+    template<std::size_t M>
+    constexpr fixed_path( const fixed_path<M>& Other )
+    {
+        append_chars( Other.data(), Other.size() );
+    }
+
+    constexpr std::size_t size() const noexcept { return Size_; }
+    constexpr bool empty() const noexcept { return Size_ == 0; }
+    constexpr const char* data() const noexcept { return Data_; }
+    constexpr const char* c_str() const noexcept { return Data_; }
+    constexpr char operator[]( std::size_t Pos ) const { return Data_[Pos]; }
+
+    std::string str() const
+    {
+        return std::string( Data_, Size_ );
+    }
+
+    boost::filesystem::path_t to_path() const
+    {
+        return boost::filesystem::path_t( str() );
+    }
+
+    //! \brief  Append an element as `path_t::operator/=` would, adding a
+    //!         separator only where one is needed
+    constexpr fixed_path& append( const char* Source, std::size_t Size )
+    {
+        if( Size != 0 && Source[0] != '/' && Size_ != 0 && Data_[Size_-1] != '/' )
+        {
+            append_chars( "/", 1 );
+        }
+        append_chars( Source, Size );
+        return *this;
+    }
+
+    constexpr fixed_path& append( const path_element& Element )
+    {
+        return append( Element.data, Element.size );
+    }
+
+    //! \brief  Shorten the held path to its first `size` characters
+    constexpr void truncate( std::size_t Size )
+    {
+        for( std::size_t i = Size; i < Size_; ++i )
+        {
+            Data_[i] = '\0';
+        }
+        if( Size < Size_ )
+        {
+            Size_ = Size;
+        }
+    }
+
+    constexpr path_element first() const
+    {
+        return first_element( Data_, Size_ );
+    }
+
+    constexpr path_element next( const path_element& Element ) const
+    {
+        return next_element( Data_, Size_, Element );
+    }
+
+private:
+
+    constexpr void append_chars( const char* Source, std::size_t Size )
+    {
+        if( Size > N - Size_ )
+        {
+            throw std::length_error( "fixed_path capacity exceeded" );
+        }
+        for( std::size_t i = 0; i != Size; ++i )
+        {
+            Data_[Size_++] = Source[i];
+        }
+        Data_[Size_] = '\0';
+    }
+
+    char        Data_[N + 1] = {};
+    std::size_t Size_ = 0;
+};
+
+
+template<std::size_t N, std::size_t M>
+constexpr
+bool
+operator==( const fixed_path<N>& Lhs, const fixed_path<M>& Rhs )
+{
+    if( Lhs.size() != Rhs.size() )
+    {
+        return false;
+    }
+    for( std::size_t i = 0; i != Lhs.size(); ++i )
+    {
+        if( Lhs[i] != Rhs[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template<std::size_t N, std::size_t M>
+constexpr
+bool
+operator!=( const fixed_path<N>& Lhs, const fixed_path<M>& Rhs )
+{
+    return !( Lhs == Rhs );
+}
+
+
+template<std::size_t N, std::size_t M>
+constexpr
+bool
+operator==( const fixed_path<N>& Lhs, const char (&Rhs)[M] )
+{
+    return Lhs == fixed_path<M-1>( Rhs );
+}
+
+
+template<std::size_t N, std::size_t M>
+constexpr
+bool
+operator!=( const fixed_path<N>& Lhs, const char (&Rhs)[M] )
+{
+    return !( Lhs == Rhs );
+}
+
+
+//! \brief  Return a `fixed_path` sized to hold the string literal `source`
+template<std::size_t M>
+constexpr
+fixed_path<M-1>
+make_fixed_path( const char (&Source)[M] )
+{
+    return fixed_path<M-1>( Source );
+}
+
+
+//! \brief  Return a normalized path by collapsing all redundant
+//!         current ".", parent ".." directory elements and
+//!         directory-separator elements
+//!
+//! \param  p - the path that we want a normalized path of
+//!
+//! \return a path representing a normalized version of p
+template<std::size_t N>
+constexpr
+fixed_path<N+1>
+normalize( const fixed_path<N>& p )
+{
+    fixed_path<N+1> norm_p;
+    bool relative = true;
+
+    for( auto elem = p.first(); !is_end( elem ); elem = p.next( elem ) )
+    {
+        if( element_is( elem, "." ) )
+        {
+            continue;
+        }
+        else if( element_is( elem, ".." ) )
+        {
+            if( relative )
+            {
+                norm_p.append( "..", 2 );
+            }
+            else
+            {
+                // As if by norm_p = norm_p.parent_path()
+                std::size_t parent_size = 0;
+                auto norm_elem = norm_p.first();
+                for( auto next = norm_p.next( norm_elem ); !is_end( next ); next = norm_p.next( next ) )
+                {
+                    parent_size = norm_elem.last;
+                    norm_elem = next;
+                }
+                norm_p.truncate( parent_size );
+                if( norm_p.empty() )
+                {
+                    relative = true;
+                }
+            }
+        }
+        else
+        {
+            relative = false;
+            norm_p.append( elem );
+        }
+    }
+    return norm_p;
+}
+
+
+//! \brief  Return a relative path from `start` to `p` if one
+//!         exists. This is a lexical-only analysis
+//!
+//! \param  p - the path we want a relative path to
+//!
+//! \param  start - the path that we want the relative path from
+//!
+//! \return a path representing a relative path from `start` to `p`
+//!         if one exists, an empty path otherwise. If `p` and `start`
+//!         are the same then `"."` is returned.
+template<std::size_t N, std::size_t M>
+constexpr
+fixed_path<N + 2*M + 3>
+lexically_relative( const fixed_path<N>& p, const fixed_path<M>& start )
+{
+    fixed_path<N + 2*M + 3> relative_path;
+
+    auto p_elem = p.first();
+    auto start_elem = start.first();
+
+    if( !element_equal( p_elem, start_elem ) )
+    {
+        return relative_path;
+    }
+
+    for( ; !is_end( p_elem ) && !is_end( start_elem ); p_elem = p.next( p_elem ), start_elem = start.next( start_elem ) )
+    {
+        if( !element_equal( p_elem, start_elem ) )
+        {
+            break;
+        }
+    }
+
+    if( is_end( start_elem ) )
+    {
+        relative_path.append( ".", 1 );
+    }
+    for( ; !is_end( start_elem ); start_elem = start.next( start_elem ) )
+    {
+        relative_path.append( "..", 2 );
+    }
+    for( ; !is_end( p_elem ); p_elem = p.next( p_elem ) )
+    {
+        relative_path.append( p_elem );
+    }
+    return relative_path;
+}
+
+
+//! \brief  Return a common prefix from the paths `p1` and `p2`
+//!
+//! \param  p1 - a fixed_path object
+//!
+//! \param  p2 - a fixed_path object
+//!
+//! \return a path representing the common prefix, if any, an empty path otherwise
+template<std::size_t N, std::size_t M>
+constexpr
+fixed_path<N+1>
+common_prefix( const fixed_path<N>& p1, const fixed_path<M>& p2 )
+{
+    fixed_path<N+1> Common;
+
+    auto Elem1 = p1.first();
+    auto Elem2 = p2.first();
+
+    for( ; !is_end( Elem1 ) && !is_end( Elem2 ); Elem1 = p1.next( Elem1 ), Elem2 = p2.next( Elem2 ) )
+    {
+        if( !element_equal( Elem1, Elem2 ) )
+        {
+            break;
+        }
+        Common.append( Elem1 );
+    }
+    return Common;
+}
+
+
+//! \brief  Return a common prefix from all of the paths passed as arguments
+//!
+//! \return a path representing the common prefix, if any, an empty path otherwise
+template<std::size_t N, std::size_t M, std::size_t... Ms>
+constexpr
+auto
+common_prefix( const fixed_path<N>& p1, const fixed_path<M>& p2, const fixed_path<Ms>&... ps )
+{
+    return common_prefix( common_prefix( p1, p2 ), ps... );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
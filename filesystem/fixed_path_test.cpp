@@ -0,0 +1,21 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_fixed_path
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_fixed_path_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_fixed_normalize )
+{
+    test_fixed_normalize();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_fixed_lexically_relative )
+{
+    test_fixed_lexically_relative();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_fixed_common_prefix )
+{
+    test_fixed_common_prefix();
+}
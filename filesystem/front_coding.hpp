@@ -0,0 +1,403 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_FRONT_CODING_HPP_INCLUDED
+#define XSTD_FILESYSTEM_FRONT_CODING_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+
+// C++ Standard Library Includes
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Front-coded path lists - not part of the proposal.
+//
+// A front-coded list stores each path as the number of leading elements it
+// shares with the previous path followed by the bytes that differ:
+//
+//     entry    := varint shared-elements, varint suffix-size, suffix-bytes
+//     trailer  := u64 restart-offset * restart-count,
+//                 u64 entry-count, u64 restart-count, u64 restart-interval
+//
+// Every `restart-interval` entries the shared element count is forced to zero
+// and the offset of the entry is recorded so that any entry can be reached by
+// decoding at most `restart-interval` entries. Integers in the trailer are
+// little-endian. Paths are reproduced byte for byte, so sorting the input
+// (for example with `std::sort` on `path_t`) gives the best compression.
+
+
+// Helpers to make implementation easier - not part of the proposal
+
+//! The parts of a path_element needed to resume scanning after it
+struct element_end
+{
+    std::size_t                     last;
+    xstd::filesystem::element_kind  kind;
+};
+
+
+inline
+void
+scan_element_ends( const char* s, std::size_t Size, std::vector<element_end>& Ends )
+{
+    auto Elem = Ends.empty()
+              ? xstd::filesystem::first_element( s, Size )
+              : xstd::filesystem::next_element( s, Size, xstd::filesystem::path_element{ "", 0, 0, Ends.back().last, Ends.back().kind } );
+
+    for( ; !is_end( Elem ); Elem = xstd::filesystem::next_element( s, Size, Elem ) )
+    {
+        Ends.push_back( element_end{ Elem.last, Elem.kind } );
+    }
+}
+
+
+inline
+void
+append_varint( std::string& Out, std::uint64_t Value )
+{
+    while( Value >= 0x80 )
+    {
+        Out.push_back( static_cast<char>( ( Value & 0x7f ) | 0x80 ) );
+        Value >>= 7;
+    }
+    Out.push_back( static_cast<char>( Value ) );
+}
+
+
+inline
+void
+append_u64( std::string& Out, std::uint64_t Value )
+{
+    for( int Byte = 0; Byte != 8; ++Byte )
+    {
+        Out.push_back( static_cast<char>( ( Value >> ( 8 * Byte ) ) & 0xff ) );
+    }
+}
+
+
+inline
+std::uint64_t
+read_u64( const char* In )
+{
+    std::uint64_t Value = 0;
+    for( int Byte = 7; Byte >= 0; --Byte )
+    {
+        Value = ( Value << 8 ) | static_cast<unsigned char>( In[Byte] );
+    }
+    return Value;
+}
+
+
+//! \brief  Writes a front-coded path list to an output stream one path at a time
+class front_coded_encoder
+{
+public:
+
+    static const std::size_t default_restart_interval = 16;
+
+    explicit front_coded_encoder( std::ostream& Out, std::size_t RestartInterval = default_restart_interval )
+    : Out_( Out )
+    , RestartInterval_( RestartInterval ? RestartInterval : 1 )
+    {
+    }
+
+    front_coded_encoder( const front_coded_encoder& ) = delete;
+    front_coded_encoder& operator=( const front_coded_encoder& ) = delete;
+
+    void add( const path_t& Path )
+    {
+        add( boost::string_ref( Path.native() ) );
+    }
+
+    void add( boost::string_ref Path )
+    {
+        std::size_t Shared = 0;
+        std::size_t PrefixSize = 0;
+
+        if( Count_ % RestartInterval_ == 0 )
+        {
+            Restarts_.push_back( Written_ );
+        }
+        else
+        {
+            // Count the leading elements that are byte-for-byte identical
+            auto Elem = xstd::filesystem::first_element( Path.data(), Path.size() );
+            for( ; Shared != PrevEnds_.size() && !is_end( Elem ); ++Shared )
+            {
+                if( Elem.last != PrevEnds_[Shared].last
+                    || Elem.kind != PrevEnds_[Shared].kind
+                    || std::memcmp( Path.data() + PrefixSize, Prev_.data() + PrefixSize, Elem.last - PrefixSize ) != 0 )
+                {
+                    break;
+                }
+                PrefixSize = Elem.last;
+                Elem = xstd::filesystem::next_element( Path.data(), Path.size(), Elem );
+            }
+        }
+
+        Entry_.clear();
+        append_varint( Entry_, Shared );
+        append_varint( Entry_, Path.size() - PrefixSize );
+        Entry_.append( Path.data() + PrefixSize, Path.size() - PrefixSize );
+
+        Out_.write( Entry_.data(), Entry_.size() );
+        Written_ += Entry_.size();
+        ++Count_;
+
+        Prev_.resize( PrefixSize );
+        Prev_.append( Path.data() + PrefixSize, Path.size() - PrefixSize );
+        PrevEnds_.resize( Shared );
+        scan_element_ends( Prev_.data(), Prev_.size(), PrevEnds_ );
+    }
+
+    //! \brief  Write the restart index and trailer. No further paths may be added.
+    void finish()
+    {
+        Entry_.clear();
+        for( auto Restart: Restarts_ )
+        {
+            append_u64( Entry_, Restart );
+        }
+        append_u64( Entry_, Count_ );
+        append_u64( Entry_, Restarts_.size() );
+        append_u64( Entry_, RestartInterval_ );
+        Out_.write( Entry_.data(), Entry_.size() );
+        Out_.flush();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return Count_;
+    }
+
+private:
+
+    std::ostream&               Out_;
+    std::size_t                 RestartInterval_;
+    std::size_t                 Count_   = 0;
+    std::uint64_t               Written_ = 0;
+    std::vector<std::uint64_t>  Restarts_;
+    std::string                 Prev_;
+    std::vector<element_end>    PrevEnds_;
+    std::string                 Entry_;
+};
+
+
+//! \brief  Reads a front-coded path list held in memory, for example in a
+//!         mapped file. Sequential decoding copies only the differing bytes
+//!         of each path; random access starts at the nearest restart point.
+class front_coded_decoder
+{
+public:
+
+    front_coded_decoder( const char* Data, std::size_t Size )
+    : Data_( Data )
+    {
+        const std::size_t Fixed = 3 * 8;
+        if( Size < Fixed )
+        {
+            corrupt();
+        }
+        Count_           = read_u64( Data + Size - 24 );
+        RestartCount_    = read_u64( Data + Size - 16 );
+        RestartInterval_ = read_u64( Data + Size - 8 );
+        if( RestartInterval_ == 0 || RestartCount_ > ( Size - Fixed ) / 8 )
+        {
+            corrupt();
+        }
+        Restarts_    = Data + Size - Fixed - RestartCount_ * 8;
+        EntriesSize_ = Restarts_ - Data;
+        if( RestartCount_ != ( Count_ + RestartInterval_ - 1 ) / RestartInterval_ )
+        {
+            corrupt();
+        }
+    }
+
+    explicit front_coded_decoder( boost::string_ref Encoded )
+    : front_coded_decoder( Encoded.data(), Encoded.size() )
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return Count_;
+    }
+
+    //! \brief  A position in the list that decodes one path at a time
+    class cursor
+    {
+    public:
+
+        //! \brief  Decode the next path, returning false at the end of the list
+        bool next()
+        {
+            if( Index_ == Decoder_->Count_ )
+            {
+                return false;
+            }
+            std::uint64_t Shared = read_varint();
+            std::uint64_t Suffix = read_varint();
+            if( Shared > Ends_.size() || Suffix > Decoder_->EntriesSize_ - Offset_ )
+            {
+                corrupt();
+            }
+            Shared_ = static_cast<std::size_t>( Shared );
+            Ends_.resize( Shared );
+            Path_.resize( Shared ? Ends_.back().last : 0 );
+            Path_.append( Decoder_->Data_ + Offset_, Suffix );
+            Offset_ += Suffix;
+            scan_element_ends( Path_.data(), Path_.size(), Ends_ );
+            ++Index_;
+            return true;
+        }
+
+        //! \brief  The path most recently decoded by `next()`
+        boost::string_ref path() const noexcept
+        {
+            return boost::string_ref( Path_ );
+        }
+
+        //! \brief  The number of leading elements the path most recently
+        //!         decoded by `next()` shares with the one before it
+        std::size_t shared() const noexcept
+        {
+            return Shared_;
+        }
+
+        //! \brief  The index of the path most recently decoded by `next()`
+        std::size_t index() const noexcept
+        {
+            return Index_ - 1;
+        }
+
+    private:
+
+        friend class front_coded_decoder;
+
+        cursor( const front_coded_decoder& Decoder, std::size_t Restart )
+        : Decoder_( &Decoder )
+        , Index_( Restart * Decoder.RestartInterval_ )
+        , Offset_( Restart < Decoder.RestartCount_ ? read_u64( Decoder.Restarts_ + 8 * Restart ) : Decoder.EntriesSize_ )
+        {
+            if( Offset_ > Decoder.EntriesSize_ )
+            {
+                corrupt();
+            }
+        }
+
+        std::uint64_t read_varint()
+        {
+            std::uint64_t Value = 0;
+            for( unsigned Shift = 0; Shift < 64; Shift += 7 )
+            {
+                if( Offset_ == Decoder_->EntriesSize_ )
+                {
+                    corrupt();
+                }
+                auto Byte = static_cast<unsigned char>( Decoder_->Data_[Offset_++] );
+                Value |= static_cast<std::uint64_t>( Byte & 0x7f ) << Shift;
+                if( !( Byte & 0x80 ) )
+                {
+                    return Value;
+                }
+            }
+            corrupt();
+            return Value;
+        }
+
+        const front_coded_decoder*  Decoder_;
+        std::size_t                 Index_;
+        std::size_t                 Offset_;
+        std::size_t                 Shared_ = 0;
+        std::string                 Path_;
+        std::vector<element_end>    Ends_;
+    };
+
+    //! \brief  Return a cursor positioned before the first path
+    cursor begin() const
+    {
+        return cursor( *this, 0 );
+    }
+
+    //! \brief  Return a cursor whose next call to `next()` decodes path `index`
+    cursor seek( std::size_t Index ) const
+    {
+        if( Index >= Count_ )
+        {
+            // The last restart block may be short, so the end is not at a
+            // restart point
+            cursor Cursor( *this, RestartCount_ );
+            Cursor.Index_ = Count_;
+            Cursor.Offset_ = EntriesSize_;
+            return Cursor;
+        }
+        cursor Cursor( *this, Index / RestartInterval_ );
+        while( Cursor.Index_ != Index )
+        {
+            Cursor.next();
+        }
+        return Cursor;
+    }
+
+    //! \brief  Return path `index`, throwing std::out_of_range if there is none
+    path_t at( std::size_t Index ) const
+    {
+        if( Index >= Count_ )
+        {
+            throw std::out_of_range( "boost::filesystem::front_coded_decoder::at" );
+        }
+        auto Cursor = seek( Index );
+        Cursor.next();
+        return path_t( Cursor.path().to_string() );
+    }
+
+    //! \brief  Call `f( string_ref path )` for each path in order
+    template<class Function>
+    void for_each( Function f ) const
+    {
+        auto Cursor = begin();
+        while( Cursor.next() )
+        {
+            f( Cursor.path() );
+        }
+    }
+
+private:
+
+    [[noreturn]] static void corrupt()
+    {
+        throw std::runtime_error( "boost::filesystem::front_coded_decoder: corrupt front-coded data" );
+    }
+
+    const char*     Data_;
+    const char*     Restarts_;
+    std::size_t     EntriesSize_;
+    std::uint64_t   Count_;
+    std::uint64_t   RestartCount_;
+    std::uint64_t   RestartInterval_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
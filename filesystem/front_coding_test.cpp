@@ -0,0 +1,26 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_front_coding
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_front_coding_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_front_coding_round_trip )
+{
+    test_front_coding_round_trip();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_front_coding_random_access )
+{
+    test_front_coding_random_access();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_front_coding_compression )
+{
+    test_front_coding_compression();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_front_coding_empty_and_corrupt )
+{
+    test_front_coding_empty_and_corrupt();
+}
@@ -0,0 +1,119 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_GROUP_BY_PREFIX_HPP_INCLUDED
+#define XSTD_FILESYSTEM_GROUP_BY_PREFIX_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  A set of paths sharing a common prefix, with the prefix removed
+//!         from each member as if by `remove_common_prefix`
+struct path_group
+{
+    path_t              prefix;
+    std::vector<path_t> members;
+};
+
+
+//! \brief  Partition the sequence of paths defined by the range [first,last)
+//!         into the largest groups whose members share at least their first
+//!         `min_depth` elements
+//!
+//! \param  first - an InputIterator to the start of the range
+//!
+//! \param  last - an InputIterator to the end of the range
+//!
+//! \param  min_depth - the number of leading elements that the members of
+//!         a group must share. Paths with fewer elements are grouped with
+//!         paths that have exactly the same elements. Root elements are
+//!         counted, so `/a/b` has three elements.
+//!
+//! \param  threads - the number of threads to use, or 0 to use one per core
+//!
+//! \return the groups in ascending order of prefix. Each group holds its
+//!         `common_prefix` and its members, in their original order, with
+//!         that prefix removed. Every path appears in exactly one group.
+//!
+//! \note   The paths are sorted on their leading elements so the operation
+//!         takes O(N log N) comparisons.
+template<class InputIterator>
+std::vector<path_group>
+group_by_common_prefix( InputIterator First, InputIterator Last, std::size_t MinDepth, std::size_t Threads = 1 )
+{
+    std::vector<path_t> Paths( First, Last );
+    std::vector<path_t> Keys( Paths.size() );
+
+    xstd::filesystem::parallel_for( Paths.size(), Threads, [&]( std::size_t FirstPath, std::size_t LastPath )
+    {
+        for( std::size_t i = FirstPath; i != LastPath; ++i )
+        {
+            std::size_t Depth = 0;
+            for( auto Element = Paths[i].begin(); Depth != MinDepth && Element != Paths[i].end(); ++Element, ++Depth )
+            {
+                Keys[i] /= *Element;
+            }
+        }
+    } );
+
+    std::vector<std::size_t> Order( Paths.size() );
+    std::iota( Order.begin(), Order.end(), std::size_t( 0 ) );
+
+    xstd::filesystem::parallel_stable_sort
+    (
+        Order.begin(), Order.end(),
+        [&Keys]( std::size_t Lhs, std::size_t Rhs ) { return Keys[Lhs] < Keys[Rhs]; },
+        Threads
+    );
+
+    std::vector<std::pair<std::size_t, std::size_t>> Runs;
+    for( std::size_t Begin = 0, End = 0; Begin != Order.size(); Begin = End )
+    {
+        for( End = Begin + 1; End != Order.size() && Keys[Order[End]] == Keys[Order[Begin]]; ++End )
+        {
+        }
+        Runs.emplace_back( Begin, End );
+    }
+
+    std::vector<path_group> Groups( Runs.size() );
+
+    xstd::filesystem::parallel_for( Runs.size(), Threads, [&]( std::size_t FirstRun, std::size_t LastRun )
+    {
+        for( std::size_t Run = FirstRun; Run != LastRun; ++Run )
+        {
+            auto& Group = Groups[Run];
+            for( std::size_t i = Runs[Run].first; i != Runs[Run].second; ++i )
+            {
+                Group.members.push_back( std::move( Paths[Order[i]] ) );
+            }
+            Group.prefix = remove_common_prefix( Group.members.begin(), Group.members.end() );
+        }
+    } );
+
+    return Groups;
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
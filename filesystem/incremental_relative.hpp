@@ -0,0 +1,251 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_INCREMENTAL_RELATIVE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_INCREMENTAL_RELATIVE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Computes `lexically_relative( p, start )` for a stream of paths
+//!         `p` against one `start`, remembering how far the previous path
+//!         matched `start` so that only the elements that changed are looked
+//!         at again.
+//!
+//!         Consecutive paths of a sorted stream share most of their leading
+//!         elements. The elements a path shares with the one before it
+//!         matched `start` exactly as far as they did last time, so they are
+//!         neither compared with `start` again nor rewritten in the result;
+//!         adding a path costs time proportional to the elements after the
+//!         shared ones, plus finding where they end if the caller does not
+//!         say (see `relativise( p, shared )`).
+//!
+//!         Any order of paths gives the same results as `lexically_relative`;
+//!         sorted input is simply the fastest.
+class incremental_lexically_relative
+{
+public:
+
+    explicit incremental_lexically_relative( const path_t& Start )
+    : Start_( Start )
+    {
+        scan( Start_.native(), StartElements_, 0 );
+    }
+
+    const path_t& start() const noexcept
+    {
+        return Start_;
+    }
+
+    //! \brief  Return `lexically_relative( p, start() )` as text, valid until
+    //!         the next call, or an empty string if there is no relative path
+    boost::string_ref relativise( boost::string_ref p )
+    {
+        return relativise( p, shared_with_previous( p ) );
+    }
+
+    //! \brief  Return `lexically_relative( p, start() )` as text, valid until
+    //!         the next call, where `shared` leading elements of `p` are
+    //!         known to be byte for byte the same as those of the previous
+    //!         path, as reported by `front_coded_decoder::cursor::shared()`
+    boost::string_ref relativise( boost::string_ref p, std::size_t Shared )
+    {
+        Shared = std::min( Shared, Elements_.size() );
+
+        // Keep the shared elements and scan only what follows them
+        Elements_.resize( Shared );
+        std::size_t PrefixSize = Shared ? Elements_.back().last : 0;
+        Previous_.resize( PrefixSize );
+        Previous_.append( p.data() + PrefixSize, p.size() - PrefixSize );
+        scan( Previous_, Elements_, Shared );
+
+        // Shared elements match `start` as far as they did before, and past
+        // that only the new elements need comparing
+        std::size_t Match = Match_;
+        if( Shared <= Match_ )
+        {
+            for( Match = Shared; Match != Elements_.size() && Match != StartElements_.size(); ++Match )
+            {
+                ++Compared_;
+                if( !equal( Previous_, Elements_[Match], Start_.native(), StartElements_[Match] ) )
+                {
+                    break;
+                }
+            }
+        }
+        Match_ = Match;
+
+        if( Match == 0 && !( Elements_.empty() && StartElements_.empty() ) )
+        {
+            Output_.clear();
+            OutputValid_ = false;
+            return boost::string_ref();
+        }
+
+        // The result is `.` or `..`s for the unmatched part of `start`
+        // followed by the unmatched elements of `p`, so when the match is
+        // unchanged only the elements after the shared ones are rewritten
+        if( !OutputValid_ || OutputMatch_ != Match )
+        {
+            Output_.clear();
+            if( Match == StartElements_.size() )
+            {
+                Output_ = ".";
+            }
+            for( std::size_t Up = Match; Up != StartElements_.size(); ++Up )
+            {
+                xstd::filesystem::append_element( Output_, "..", 2 );
+            }
+            HeadSize_ = Output_.size();
+            OutputSizes_.clear();
+            OutputMatch_ = Match;
+            OutputValid_ = true;
+        }
+        std::size_t Keep = std::max( Match, Shared );
+        OutputSizes_.resize( Keep - Match );
+        Output_.resize( Keep == Match ? HeadSize_ : OutputSizes_.back() );
+        for( std::size_t Element = Keep; Element != Elements_.size(); ++Element )
+        {
+            append( Output_, Previous_, Elements_[Element] );
+            OutputSizes_.push_back( Output_.size() );
+        }
+        return boost::string_ref( Output_ );
+    }
+
+    //! \brief  Return `lexically_relative( p, start() )`
+    path_t operator()( const path_t& p )
+    {
+        return path_t( relativise( boost::string_ref( p.native() ) ).to_string() );
+    }
+
+    //! \brief  Return the number of element comparisons made with `start`
+    //!         so far
+    std::size_t compared() const noexcept
+    {
+        return Compared_;
+    }
+
+    //! \brief  Forget the previous path, as if the next were the first
+    void reset()
+    {
+        Previous_.clear();
+        Elements_.clear();
+        Match_ = 0;
+        Output_.clear();
+        OutputSizes_.clear();
+        OutputValid_ = false;
+    }
+
+private:
+
+    //! An element as an offset into the text of its path, or as the text
+    //! "." for the element that follows a trailing separator
+    struct element
+    {
+        std::size_t                     text;
+        std::size_t                     size;
+        std::size_t                     last;
+        xstd::filesystem::element_kind  kind;
+        bool                            dot;
+    };
+
+    static void scan( const std::string& s, std::vector<element>& Elements, std::size_t Shared )
+    {
+        auto Element = Shared == 0
+                     ? xstd::filesystem::first_element( s.data(), s.size() )
+                     : xstd::filesystem::next_element( s.data(), s.size(), xstd::filesystem::path_element{ "", 0, 0, Elements.back().last, Elements.back().kind } );
+        for( ; !is_end( Element ); Element = xstd::filesystem::next_element( s.data(), s.size(), Element ) )
+        {
+            bool Dot = Element.data != s.data() + Element.first;
+            Elements.push_back( element{ Element.first, Element.size, Element.last, Element.kind, Dot } );
+        }
+    }
+
+    static const char* text( const std::string& s, const element& Element ) noexcept
+    {
+        return Element.dot ? "." : s.data() + Element.text;
+    }
+
+    static bool equal( const std::string& Lhs, const element& LhsElement, const std::string& Rhs, const element& RhsElement ) noexcept
+    {
+        return LhsElement.size == RhsElement.size
+            && std::memcmp( text( Lhs, LhsElement ), text( Rhs, RhsElement ), LhsElement.size ) == 0;
+    }
+
+    static void append( std::string& Out, const std::string& s, const element& Element )
+    {
+        xstd::filesystem::append_element( Out, text( s, Element ), Element.size );
+    }
+
+    //! Return the number of leading elements of `p` that are the same, and
+    //! end at the same place, as those of the previous path
+    std::size_t shared_with_previous( boost::string_ref p ) const
+    {
+        auto Limit = std::min( p.size(), Previous_.size() );
+        auto Differ = static_cast<std::size_t>( std::mismatch( p.data(), p.data() + Limit, Previous_.data() ).first - p.data() );
+
+        // Whether a path starts with a root-name depends on its first three
+        // characters
+        if( Differ < 3 )
+        {
+            return 0;
+        }
+
+        // Elements ending before the first difference are shared, as is one
+        // ending exactly there if both paths continue with a separator or
+        // end there, unless it is the element after a trailing separator
+        auto Shared = static_cast<std::size_t>( std::partition_point( Elements_.begin(), Elements_.end(), [&]( const element& Element )
+        {
+            return Element.last < Differ;
+        } ) - Elements_.begin() );
+        if( Shared != Elements_.size() && Elements_[Shared].last == Differ && !Elements_[Shared].dot
+            && ( Differ == p.size() || p[Differ] == '/' )
+            && ( Differ == Previous_.size() || Previous_[Differ] == '/' ) )
+        {
+            ++Shared;
+        }
+        return Shared;
+    }
+
+    path_t                      Start_;
+    std::vector<element>        StartElements_;
+
+    std::string                 Previous_;
+    std::vector<element>        Elements_;
+    std::size_t                 Match_ = 0;
+
+    std::string                 Output_;
+    std::size_t                 HeadSize_ = 0;
+    std::size_t                 OutputMatch_ = 0;
+    bool                        OutputValid_ = false;
+    std::vector<std::size_t>    OutputSizes_;
+
+    std::size_t                 Compared_ = 0;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
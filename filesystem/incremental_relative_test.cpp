@@ -0,0 +1,26 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_incremental_relative
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_incremental_relative_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_incremental_relative_awkward_paths )
+{
+    test_incremental_relative_awkward_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_incremental_relative_random_paths )
+{
+    test_incremental_relative_random_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_incremental_relative_front_coded_paths )
+{
+    test_incremental_relative_front_coded_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_incremental_relative_compares_only_changes )
+{
+    test_incremental_relative_compares_only_changes();
+}
@@ -0,0 +1,324 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_IO_URING_RING_HPP_INCLUDED
+#define XSTD_FILESYSTEM_IO_URING_RING_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined( __linux__ ) && defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined( SYS_io_uring_setup ) && defined( SYS_io_uring_enter ) && defined( IORING_SETUP_CLAMP ) && defined( STATX_TYPE )
+#define XSTD_FILESYSTEM_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Asynchronous I/O helper for the batch operations - not part of the proposal
+
+
+//! \brief  A request to `lstat` a path, and its outcome
+struct lstat_request
+{
+    const char* path = nullptr;
+
+    //! 0 on success, otherwise the errno value
+    int         error = 0;
+
+    //! The `st_mode` of the path itself, not of what a symlink refers to
+    mode_t      mode = 0;
+};
+
+
+#if defined( XSTD_FILESYSTEM_HAS_IO_URING )
+
+//! \brief  A minimal io_uring submission and completion queue pair that
+//!         answers batches of lstat_requests with `IORING_OP_STATX`,
+//!         driven through the raw system calls so that liburing is not
+//!         needed.
+//!
+//!         A ring is used by one thread at a time.
+class io_uring_ring
+{
+public:
+
+    //! The most times in a row `io_uring_enter` may fail with EAGAIN or
+    //! EBUSY before a batch is given up on
+    static const int max_busy_retries = 64;
+
+    //! \brief  Set up a ring of `entries` submission queue entries. If the
+    //!         kernel refuses, `valid` returns false and `error` says why.
+    explicit io_uring_ring( unsigned Entries = 256 )
+    {
+        io_uring_params Params;
+        std::memset( &Params, 0, sizeof( Params ) );
+        Params.flags = IORING_SETUP_CLAMP;
+
+        Fd_ = static_cast<int>( ::syscall( SYS_io_uring_setup, Entries, &Params ) );
+        if( Fd_ < 0 )
+        {
+            Error_ = errno;
+            return;
+        }
+
+        SqSize_ = Params.sq_off.array + Params.sq_entries * sizeof( unsigned );
+        CqSize_ = Params.cq_off.cqes + Params.cq_entries * sizeof( io_uring_cqe );
+        bool Single = ( Params.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+        if( Single )
+        {
+            SqSize_ = CqSize_ = std::max( SqSize_, CqSize_ );
+        }
+
+        SqRing_ = map( SqSize_, IORING_OFF_SQ_RING );
+        CqRing_ = Single ? SqRing_ : map( CqSize_, IORING_OFF_CQ_RING );
+        SqesSize_ = Params.sq_entries * sizeof( io_uring_sqe );
+        Sqes_ = static_cast<io_uring_sqe*>( map( SqesSize_, IORING_OFF_SQES ) );
+        if( !SqRing_ || !CqRing_ || !Sqes_ )
+        {
+            Error_ = errno;
+            return;
+        }
+
+        auto Sq = static_cast<char*>( SqRing_ );
+        SqTail_  = reinterpret_cast<unsigned*>( Sq + Params.sq_off.tail );
+        SqMask_  = *reinterpret_cast<unsigned*>( Sq + Params.sq_off.ring_mask );
+        SqArray_ = reinterpret_cast<unsigned*>( Sq + Params.sq_off.array );
+        Entries_ = Params.sq_entries;
+
+        auto Cq = static_cast<char*>( CqRing_ );
+        CqHead_ = reinterpret_cast<unsigned*>( Cq + Params.cq_off.head );
+        CqTail_ = reinterpret_cast<unsigned*>( Cq + Params.cq_off.tail );
+        CqMask_ = *reinterpret_cast<unsigned*>( Cq + Params.cq_off.ring_mask );
+        Cqes_   = reinterpret_cast<io_uring_cqe*>( Cq + Params.cq_off.cqes );
+
+        // Kernels before 5.6 accept the ring but not IORING_OP_STATX
+        lstat_request Probe;
+        Probe.path = "/";
+        if( !lstat( &Probe, &Probe + 1 ) || Probe.error == EINVAL )
+        {
+            Error_ = Probe.error ? Probe.error : EINVAL;
+        }
+    }
+
+    io_uring_ring( const io_uring_ring& ) = delete;
+    io_uring_ring& operator=( const io_uring_ring& ) = delete;
+
+    ~io_uring_ring()
+    {
+        if( Sqes_ )
+        {
+            ::munmap( Sqes_, SqesSize_ );
+        }
+        if( CqRing_ && CqRing_ != SqRing_ )
+        {
+            ::munmap( CqRing_, CqSize_ );
+        }
+        if( SqRing_ )
+        {
+            ::munmap( SqRing_, SqSize_ );
+        }
+        if( Fd_ >= 0 )
+        {
+            ::close( Fd_ );
+        }
+    }
+
+    //! \brief  Return true if the ring can be used
+    bool valid() const noexcept
+    {
+        return Fd_ >= 0 && !Error_;
+    }
+
+    //! \brief  Return the errno value explaining why the ring is not valid
+    int error() const noexcept
+    {
+        return Error_;
+    }
+
+    //! \brief  Answer every request in [first,last), keeping up to a full
+    //!         ring of them in flight. Returns false, leaving later requests
+    //!         unanswered, if `io_uring_enter` fails, but only once nothing
+    //!         is left in flight that the kernel could still read a path
+    //!         for or write a result from.
+    bool lstat( lstat_request* First, lstat_request* Last )
+    {
+        std::size_t Count = Last - First;
+        Results_.resize( std::min<std::size_t>( Count, Entries_ ) );
+        Slots_.clear();
+        for( std::size_t Slot = 0; Slot != Results_.size(); ++Slot )
+        {
+            Slots_.push_back( Slot );
+        }
+
+        std::size_t Next = 0;
+        std::size_t InFlight = 0;
+        unsigned Unsubmitted = 0;
+        int Busy = 0;
+        while( Next != Count || InFlight )
+        {
+            unsigned Tail = *SqTail_;
+            while( Next != Count && !Slots_.empty() )
+            {
+                auto Slot = Slots_.back();
+                Slots_.pop_back();
+
+                auto Index = Tail & SqMask_;
+                auto& Sqe = Sqes_[Index];
+                std::memset( &Sqe, 0, sizeof( Sqe ) );
+                Sqe.opcode      = IORING_OP_STATX;
+                Sqe.fd          = AT_FDCWD;
+                Sqe.addr        = reinterpret_cast<std::uintptr_t>( First[Next].path );
+                Sqe.len         = STATX_TYPE;
+                Sqe.off         = reinterpret_cast<std::uintptr_t>( &Results_[Slot].buffer );
+                Sqe.statx_flags = AT_SYMLINK_NOFOLLOW;
+                Sqe.user_data   = Slot;
+                Results_[Slot].request = &First[Next];
+                SqArray_[Index] = Index;
+
+                ++Tail;
+                ++Next;
+                ++Unsubmitted;
+                ++InFlight;
+            }
+            __atomic_store_n( SqTail_, Tail, __ATOMIC_RELEASE );
+
+            // Submit whatever the kernel has not yet consumed and wait for at
+            // least one completion
+            auto Entered = ::syscall( SYS_io_uring_enter, Fd_, Unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0 );
+            if( Entered < 0 )
+            {
+                int Error = errno;
+                if( Error == EINTR )
+                {
+                    continue;
+                }
+                // The kernel is short of memory for requests, or of room in
+                // the completion queue, which reaping what is there makes
+                if( ( Error == EAGAIN || Error == EBUSY ) && ++Busy != max_busy_retries )
+                {
+                    reap( InFlight );
+                    ::sched_yield();
+                    continue;
+                }
+                Error_ = Error;
+                drain( Unsubmitted, InFlight );
+                return false;
+            }
+            Busy = 0;
+            Unsubmitted -= static_cast<unsigned>( Entered );
+            reap( InFlight );
+        }
+        return true;
+    }
+
+private:
+
+    //! Answer the requests whose completions are in the queue
+    void reap( std::size_t& InFlight )
+    {
+        unsigned Head = *CqHead_;
+        unsigned Ready = __atomic_load_n( CqTail_, __ATOMIC_ACQUIRE );
+        for( ; Head != Ready; ++Head )
+        {
+            const auto& Cqe = Cqes_[Head & CqMask_];
+            auto& Result = Results_[Cqe.user_data];
+            if( Cqe.res < 0 )
+            {
+                Result.request->error = -Cqe.res;
+            }
+            else
+            {
+                Result.request->error = 0;
+                Result.request->mode = Result.buffer.stx_mode;
+            }
+            Slots_.push_back( static_cast<std::size_t>( Cqe.user_data ) );
+            --InFlight;
+        }
+        __atomic_store_n( CqHead_, Head, __ATOMIC_RELEASE );
+    }
+
+    //! Withdraw the `unsubmitted` entries the kernel has not consumed, which
+    //! without SQPOLL it only does inside `io_uring_enter`, and wait for the
+    //! rest to complete
+    void drain( unsigned Unsubmitted, std::size_t& InFlight )
+    {
+        __atomic_store_n( SqTail_, *SqTail_ - Unsubmitted, __ATOMIC_RELEASE );
+        InFlight -= Unsubmitted;
+        while( InFlight )
+        {
+            // Completions are posted whether or not waiting for them works
+            if( ::syscall( SYS_io_uring_enter, Fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0 ) < 0 && errno != EINTR )
+            {
+                ::sched_yield();
+            }
+            reap( InFlight );
+        }
+    }
+
+    struct result
+    {
+        struct statx    buffer;
+        lstat_request*  request;
+    };
+
+    void* map( std::size_t Size, off_t Offset )
+    {
+        void* Address = ::mmap( nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Fd_, Offset );
+        return Address == MAP_FAILED ? nullptr : Address;
+    }
+
+    int                 Fd_ = -1;
+    int                 Error_ = 0;
+
+    void*               SqRing_ = nullptr;
+    void*               CqRing_ = nullptr;
+    io_uring_sqe*       Sqes_ = nullptr;
+    std::size_t         SqSize_ = 0;
+    std::size_t         CqSize_ = 0;
+    std::size_t         SqesSize_ = 0;
+
+    unsigned*           SqTail_ = nullptr;
+    unsigned*           SqArray_ = nullptr;
+    unsigned            SqMask_ = 0;
+    unsigned            Entries_ = 0;
+
+    unsigned*           CqHead_ = nullptr;
+    unsigned*           CqTail_ = nullptr;
+    unsigned            CqMask_ = 0;
+    io_uring_cqe*       Cqes_ = nullptr;
+
+    std::vector<result>         Results_;
+    std::vector<std::size_t>    Slots_;
+};
+
+#endif
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
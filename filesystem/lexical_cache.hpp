@@ -0,0 +1,280 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_LEXICAL_CACHE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_LEXICAL_CACHE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Counters describing the use of a cache
+struct cache_statistics
+{
+    std::uint64_t   hits    = 0;
+    std::uint64_t   misses  = 0;
+    std::size_t     size    = 0;
+};
+
+
+//! \brief  A bounded, thread-safe least-recently-used cache split into
+//!         independently locked shards.
+//!
+//!         A key always maps to the same shard so threads working on
+//!         different keys rarely contend for the same lock. Each shard
+//!         holds at most `capacity / shards` entries (at least one) and
+//!         evicts its least recently used entry when full.
+template<class Key, class Value, class Hash = std::hash<Key>>
+class sharded_lru_cache
+{
+public:
+
+    static const std::size_t default_shards = 64;
+
+    explicit sharded_lru_cache( std::size_t Capacity, std::size_t Shards = default_shards, const Hash& Hasher = Hash() )
+    : Hasher_( Hasher )
+    {
+        if( Shards == 0 )
+        {
+            Shards = 1;
+        }
+        std::size_t ShardCapacity = std::max<std::size_t>( 1, Capacity / Shards );
+        Shards_.reserve( Shards );
+        for( std::size_t i = 0; i != Shards; ++i )
+        {
+            Shards_.emplace_back( new shard( ShardCapacity ) );
+        }
+    }
+
+    sharded_lru_cache( const sharded_lru_cache& ) = delete;
+    sharded_lru_cache& operator=( const sharded_lru_cache& ) = delete;
+
+    //! \brief  Copy the value for `key` into `value` and return true if the
+    //!         key is cached, otherwise return false
+    bool find( const Key& K, Value& V )
+    {
+        auto& Shard = shard_for( K );
+        std::lock_guard<std::mutex> Lock( Shard.Mutex );
+        auto Entry = Shard.Index.find( K );
+        if( Entry == Shard.Index.end() )
+        {
+            Shard.Misses.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+        Shard.Lru.splice( Shard.Lru.begin(), Shard.Lru, Entry->second );
+        Shard.Hits.fetch_add( 1, std::memory_order_relaxed );
+        V = Entry->second->second;
+        return true;
+    }
+
+    //! \brief  Cache `value` for `key`, replacing any existing value
+    void insert( const Key& K, Value V )
+    {
+        auto& Shard = shard_for( K );
+        std::lock_guard<std::mutex> Lock( Shard.Mutex );
+        auto Entry = Shard.Index.find( K );
+        if( Entry != Shard.Index.end() )
+        {
+            Entry->second->second = std::move( V );
+            Shard.Lru.splice( Shard.Lru.begin(), Shard.Lru, Entry->second );
+            return;
+        }
+        if( Shard.Index.size() == Shard.Capacity )
+        {
+            Shard.Index.erase( Shard.Lru.back().first );
+            Shard.Lru.pop_back();
+        }
+        Shard.Lru.emplace_front( K, std::move( V ) );
+        Shard.Index.emplace( K, Shard.Lru.begin() );
+    }
+
+    //! \brief  Return the cached value for `key`, computing it with `f()`
+    //!         and caching it on a miss. `f` is called without holding a lock.
+    template<class Function>
+    Value get( const Key& K, Function f )
+    {
+        Value V;
+        if( find( K, V ) )
+        {
+            return V;
+        }
+        V = f();
+        insert( K, V );
+        return V;
+    }
+
+    void clear()
+    {
+        for( auto& Shard: Shards_ )
+        {
+            std::lock_guard<std::mutex> Lock( Shard->Mutex );
+            Shard->Index.clear();
+            Shard->Lru.clear();
+        }
+    }
+
+    cache_statistics statistics() const
+    {
+        cache_statistics Statistics;
+        for( auto& Shard: Shards_ )
+        {
+            Statistics.hits   += Shard->Hits.load( std::memory_order_relaxed );
+            Statistics.misses += Shard->Misses.load( std::memory_order_relaxed );
+            std::lock_guard<std::mutex> Lock( Shard->Mutex );
+            Statistics.size   += Shard->Index.size();
+        }
+        return Statistics;
+    }
+
+private:
+
+    using lru_list_t = std::list<std::pair<Key, Value>>;
+
+    struct shard
+    {
+        explicit shard( std::size_t ShardCapacity )
+        : Capacity( ShardCapacity )
+        {
+        }
+
+        mutable std::mutex                                                  Mutex;
+        lru_list_t                                                          Lru;
+        std::unordered_map<Key, typename lru_list_t::iterator, Hash>        Index;
+        std::size_t                                                         Capacity;
+        std::atomic<std::uint64_t>                                          Hits{ 0 };
+        std::atomic<std::uint64_t>                                          Misses{ 0 };
+    };
+
+    shard& shard_for( const Key& K )
+    {
+        std::size_t Hashed = Hasher_( K );
+        // Mix the high bits in so that shard selection does not reuse the
+        // low bits that the shard's own hash table will bucket on
+        Hashed ^= Hashed >> 29;
+        Hashed *= static_cast<std::size_t>( 0x9e3779b97f4a7c15ull );
+        return *Shards_[ ( Hashed >> ( sizeof( std::size_t ) * 4 ) ) % Shards_.size() ];
+    }
+
+    Hash                                Hasher_;
+    std::vector<std::unique_ptr<shard>> Shards_;
+};
+
+
+//! \brief  Memoised `normalize` and `lexically_relative` for callers that
+//!         repeatedly ask about the same paths from many threads.
+class lexical_cache
+{
+public:
+
+    static const std::size_t default_capacity = 64 * 1024;
+
+    explicit lexical_cache( std::size_t Capacity = default_capacity, std::size_t Shards = sharded_lru_cache<std::string, std::string>::default_shards )
+    : Normalized_( Capacity, Shards )
+    , Relative_( Capacity, Shards )
+    {
+    }
+
+    boost::filesystem::path_t normalize( const boost::filesystem::path_t& p )
+    {
+        return Normalized_.get( p.native(), [&p]()
+        {
+            return boost::filesystem::normalize( p ).native();
+        } );
+    }
+
+    boost::filesystem::path_t lexically_relative( const boost::filesystem::path_t& p, const boost::filesystem::path_t& start )
+    {
+        // A NUL cannot appear in a path so it safely separates the pair
+        std::string Key;
+        Key.reserve( p.native().size() + 1 + start.native().size() );
+        Key.append( p.native() ).push_back( '\0' );
+        Key.append( start.native() );
+
+        return Relative_.get( Key, [&p, &start]()
+        {
+            return boost::filesystem::lexically_relative( p, start ).native();
+        } );
+    }
+
+    cache_statistics normalize_statistics() const
+    {
+        return Normalized_.statistics();
+    }
+
+    cache_statistics relative_statistics() const
+    {
+        return Relative_.statistics();
+    }
+
+    void clear()
+    {
+        Normalized_.clear();
+        Relative_.clear();
+    }
+
+private:
+
+    sharded_lru_cache<std::string, std::string> Normalized_;
+    sharded_lru_cache<std::string, std::string> Relative_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Return `normalize( p )`, memoised in `cache`
+inline
+path_t
+normalize( const path_t& p, xstd::filesystem::lexical_cache& Cache )
+{
+    return Cache.normalize( p );
+}
+
+
+//! \brief  Return `lexically_relative( p, start )`, memoised in `cache`
+inline
+path_t
+lexically_relative( const path_t& p, const path_t& start, xstd::filesystem::lexical_cache& Cache )
+{
+    return Cache.lexically_relative( p, start );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
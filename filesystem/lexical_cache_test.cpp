@@ -0,0 +1,21 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_lexical_cache
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_lexical_cache_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_lexical_cache_results )
+{
+    test_lexical_cache_results();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_lexical_cache_eviction )
+{
+    test_lexical_cache_eviction();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_lexical_cache_concurrent )
+{
+    test_lexical_cache_concurrent();
+}
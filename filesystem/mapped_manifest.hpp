@@ -0,0 +1,393 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_MAPPED_MANIFEST_HPP_INCLUDED
+#define XSTD_FILESYSTEM_MAPPED_MANIFEST_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  A read-only, memory-mapped manifest file holding one path per line.
+//!
+//!         The file is mapped one window at a time with sequential access
+//!         advice so that manifests much larger than physical memory can be
+//!         processed. Each line is presented as a `string_ref` into the
+//!         mapping and is only valid for the duration of the callback.
+//!         Empty lines are skipped.
+class mapped_manifest
+{
+public:
+
+    static const std::size_t default_window_size = 64 * 1024 * 1024;
+
+    explicit mapped_manifest( const path_t& Manifest, std::size_t WindowSize = default_window_size )
+    : Path_( Manifest )
+    , Fd_( ::open( Manifest.c_str(), O_RDONLY | O_CLOEXEC ) )
+    {
+        if( Fd_ < 0 )
+        {
+            throw_error( "boost::filesystem::mapped_manifest" );
+        }
+        struct stat Status;
+        if( ::fstat( Fd_, &Status ) != 0 )
+        {
+            int Error = errno;
+            ::close( Fd_ );
+            errno = Error;
+            throw_error( "boost::filesystem::mapped_manifest" );
+        }
+        Size_ = static_cast<std::size_t>( Status.st_size );
+
+        std::size_t Page = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+        WindowSize_ = std::max( Page, WindowSize - WindowSize % Page );
+    }
+
+    mapped_manifest( const mapped_manifest& ) = delete;
+    mapped_manifest& operator=( const mapped_manifest& ) = delete;
+
+    ~mapped_manifest()
+    {
+        ::close( Fd_ );
+    }
+
+    std::size_t size() const noexcept
+    {
+        return Size_;
+    }
+
+    const path_t& path() const noexcept
+    {
+        return Path_;
+    }
+
+    //! \brief  Call `f( string_ref line )` for each non-empty line in the manifest
+    template<class Function>
+    void for_each_line( Function f ) const
+    {
+        std::size_t Page   = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+        std::size_t Offset = 0;
+
+        while( Offset < Size_ )
+        {
+            std::size_t MapOffset = Offset - Offset % Page;
+            std::size_t Length    = std::min( WindowSize_, Size_ - MapOffset );
+
+            for( ;; )
+            {
+                window Window( *this, MapOffset, Length );
+
+                const char* Begin = Window.data();
+                const char* First = Begin + ( Offset - MapOffset );
+                const char* Last  = Begin + Length;
+                bool AtEnd = ( MapOffset + Length == Size_ );
+
+                while( First != Last )
+                {
+                    auto End = static_cast<const char*>( std::memchr( First, '\n', Last - First ) );
+                    if( !End )
+                    {
+                        if( !AtEnd )
+                        {
+                            break;
+                        }
+                        End = Last;
+                    }
+                    if( End != First )
+                    {
+                        f( boost::string_ref( First, End - First ) );
+                    }
+                    First = ( End == Last ) ? Last : End + 1;
+                }
+
+                std::size_t Consumed = MapOffset + ( First - Begin );
+                if( Consumed == Offset && !AtEnd )
+                {
+                    // A single line is longer than the window so grow it
+                    Length = std::min( Length * 2, Size_ - MapOffset );
+                    continue;
+                }
+                Offset = AtEnd ? Size_ : Consumed;
+                break;
+            }
+        }
+    }
+
+private:
+
+    class window
+    {
+    public:
+
+        window( const mapped_manifest& Manifest, std::size_t Offset, std::size_t Length )
+        : Length_( Length )
+        {
+            Data_ = ::mmap( nullptr, Length, PROT_READ, MAP_PRIVATE, Manifest.Fd_, static_cast<off_t>( Offset ) );
+            if( Data_ == MAP_FAILED )
+            {
+                Manifest.throw_error( "boost::filesystem::mapped_manifest::for_each_line" );
+            }
+            ::madvise( Data_, Length, MADV_SEQUENTIAL );
+            ::madvise( Data_, Length, MADV_WILLNEED );
+        }
+
+        window( const window& ) = delete;
+        window& operator=( const window& ) = delete;
+
+        ~window()
+        {
+            ::munmap( Data_, Length_ );
+        }
+
+        const char* data() const noexcept
+        {
+            return static_cast<const char*>( Data_ );
+        }
+
+    private:
+
+        void*       Data_;
+        std::size_t Length_;
+    };
+
+    void throw_error( const char* What ) const
+    {
+        BOOST_FILESYSTEM_THROW
+        (   boost::filesystem::filesystem_error
+            (   What,
+                Path_,
+                boost::system::error_code( errno, boost::system::system_category() )   )   );
+    }
+
+    path_t      Path_;
+    int         Fd_;
+    std::size_t Size_ = 0;
+    std::size_t WindowSize_ = default_window_size;
+};
+
+
+// Helpers to make implementation easier - not part of the proposal
+
+//! Tracks the common leading elements of a sequence of paths presented as
+//! views, keeping a formatted copy of the prefix and its element count
+class manifest_prefix_helper
+{
+public:
+
+    void add( boost::string_ref Line )
+    {
+        if( !Seen_ )
+        {
+            Seen_ = true;
+            for( auto Elem = xstd::filesystem::first_element( Line.data(), Line.size() ); !is_end( Elem ); Elem = xstd::filesystem::next_element( Line.data(), Line.size(), Elem ) )
+            {
+                xstd::filesystem::append_element( Prefix_, Elem );
+                ++Depth_;
+            }
+            return;
+        }
+
+        std::size_t Matched = 0;
+        std::size_t Keep    = 0;
+
+        auto PrefixElem = xstd::filesystem::first_element( Prefix_.data(), Prefix_.size() );
+        auto LineElem   = xstd::filesystem::first_element( Line.data(), Line.size() );
+
+        for( ; Matched != Depth_ && !is_end( LineElem ); ++Matched )
+        {
+            if( !element_equal( PrefixElem, LineElem ) )
+            {
+                break;
+            }
+            Keep       = PrefixElem.last;
+            PrefixElem = xstd::filesystem::next_element( Prefix_.data(), Prefix_.size(), PrefixElem );
+            LineElem   = xstd::filesystem::next_element( Line.data(), Line.size(), LineElem );
+        }
+        if( Matched != Depth_ )
+        {
+            Depth_ = Matched;
+            Prefix_.resize( Keep );
+        }
+    }
+
+    const std::string& prefix() const noexcept
+    {
+        return Prefix_;
+    }
+
+    std::size_t depth() const noexcept
+    {
+        return Depth_;
+    }
+
+private:
+
+    bool        Seen_  = false;
+    std::string Prefix_;
+    std::size_t Depth_ = 0;
+};
+
+
+//! \brief  Return the common prefix of all of the paths in `manifest`
+//!
+//! \param  manifest - a mapped_manifest holding one path per line
+//!
+//! \return a path representing the common prefix, if any, path() otherwise
+inline
+path_t
+common_prefix( const mapped_manifest& Manifest )
+{
+    manifest_prefix_helper Helper;
+    Manifest.for_each_line( [&Helper]( boost::string_ref Line )
+    {
+        Helper.add( Line );
+    } );
+    return path_t( Helper.prefix() );
+}
+
+
+//! \brief  Return the common prefix of all of the paths in `manifest` and
+//!         call `sink( line, trimmed )` for each path with the prefix removed
+//!
+//! \param  manifest - a mapped_manifest holding one path per line
+//!
+//! \param  sink - a callable taking two `string_ref` arguments. `trimmed`
+//!         is a view of `line` starting at the first element after the
+//!         common prefix, or `"."` when only a trailing separator remains.
+//!         Neither view is valid after `sink` returns.
+//!
+//! \return a path representing the common prefix, if any, path() otherwise
+//!
+//! \note   The manifest is read twice, once to find the prefix and once to
+//!         trim it. No bytes of the manifest are copied into path objects.
+template<class Sink>
+path_t
+remove_common_prefix( const mapped_manifest& Manifest, Sink sink )
+{
+    manifest_prefix_helper Helper;
+    Manifest.for_each_line( [&Helper]( boost::string_ref Line )
+    {
+        Helper.add( Line );
+    } );
+
+    std::size_t Depth = Helper.depth();
+
+    Manifest.for_each_line( [&sink, Depth]( boost::string_ref Line )
+    {
+        auto Elem = xstd::filesystem::first_element( Line.data(), Line.size() );
+        for( std::size_t Count = 0; Count != Depth; ++Count )
+        {
+            Elem = xstd::filesystem::next_element( Line.data(), Line.size(), Elem );
+        }
+        if( is_end( Elem ) )
+        {
+            sink( Line, boost::string_ref() );
+        }
+        else if( Elem.first != Line.size() && Line[Elem.first] == '/' && Elem.kind == xstd::filesystem::element_kind::filename )
+        {
+            sink( Line, boost::string_ref( "." ) );
+        }
+        else
+        {
+            sink( Line, Line.substr( Elem.first ) );
+        }
+    } );
+
+    return path_t( Helper.prefix() );
+}
+
+
+//! \brief  Call `sink( line, rel )` with `rel` holding the lexically relative
+//!         path from `start` to each path in `manifest`
+//!
+//! \param  manifest - a mapped_manifest holding one path per line
+//!
+//! \param  start - the path that we want the relative paths from
+//!
+//! \param  sink - a callable taking two `string_ref` arguments. `rel` is
+//!         formatted as `lexically_relative( path_t( line ), start )` would
+//!         be and is empty if no relative path exists. Neither view is
+//!         valid after `sink` returns.
+template<class Sink>
+void
+lexically_relative( const mapped_manifest& Manifest, const path_t& Start, Sink sink )
+{
+    const std::string& StartString = Start.native();
+
+    std::vector<xstd::filesystem::path_element> StartElems;
+    for( auto Elem = xstd::filesystem::first_element( StartString.data(), StartString.size() ); !is_end( Elem ); Elem = xstd::filesystem::next_element( StartString.data(), StartString.size(), Elem ) )
+    {
+        StartElems.push_back( Elem );
+    }
+
+    std::string Result;
+
+    Manifest.for_each_line( [&]( boost::string_ref Line )
+    {
+        Result.clear();
+
+        auto p_elem     = xstd::filesystem::first_element( Line.data(), Line.size() );
+        auto start_elem = StartElems.begin();
+        auto start_end  = StartElems.end();
+
+        if( !element_equal( p_elem, start_elem != start_end ? *start_elem : xstd::filesystem::end_element( 0 ) ) )
+        {
+            sink( Line, boost::string_ref() );
+            return;
+        }
+
+        for( ; !is_end( p_elem ) && start_elem != start_end; p_elem = xstd::filesystem::next_element( Line.data(), Line.size(), p_elem ), ++start_elem )
+        {
+            if( !element_equal( p_elem, *start_elem ) )
+            {
+                break;
+            }
+        }
+
+        if( start_elem == start_end )
+        {
+            xstd::filesystem::append_element( Result, ".", 1 );
+        }
+        for( ; start_elem != start_end; ++start_elem )
+        {
+            xstd::filesystem::append_element( Result, "..", 2 );
+        }
+        for( ; !is_end( p_elem ); p_elem = xstd::filesystem::next_element( Line.data(), Line.size(), p_elem ) )
+        {
+            xstd::filesystem::append_element( Result, p_elem );
+        }
+        sink( Line, boost::string_ref( Result ) );
+    } );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,21 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_mapped_manifest
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_mapped_manifest_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_manifest_lines )
+{
+    test_manifest_lines();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_manifest_common_prefix )
+{
+    test_manifest_common_prefix();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_manifest_lexically_relative )
+{
+    test_manifest_lexically_relative();
+}
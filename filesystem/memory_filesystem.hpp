@@ -0,0 +1,616 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_MEMORY_FILESYSTEM_HPP_INCLUDED
+#define XSTD_FILESYSTEM_MEMORY_FILESYSTEM_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  A filesystem held entirely in memory, made of directories,
+//!         regular files and symlinks, that answers the queries `relative`
+//!         and its helpers make without system calls.
+//!
+//!         Paths are resolved as POSIX resolves them: symlinks met before
+//!         the last element are always followed, relative symlinks are
+//!         resolved from the directory holding them, ".." moves to the
+//!         parent of the directory reached so far and more than
+//!         `max_symlinks` symlinks in one resolution fail with
+//!         `too_many_symbolic_link_levels`. Relative paths are resolved
+//!         from `current_path`, which starts as "/".
+//!
+//!         A tree is built with the functions named after their Boost
+//!         counterparts, or copied from the real filesystem with `load`.
+//!         Queries may run concurrently with each other but not with
+//!         changes to the tree.
+class memory_filesystem
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    //! The most symlinks followed while resolving one path, as Linux
+    static const std::size_t max_symlinks = 40;
+
+    memory_filesystem()
+    {
+        Nodes_.push_back( node( node_kind::directory, npos ) );
+    }
+
+    // Queries
+
+    //! \brief  Return true if `p` resolves to an entry, following a symlink
+    //!         in its last element. A path that does not resolve is not an
+    //!         error unless a symlink loop was met.
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Found = resolve( p, true, ec );
+        clear_if_missing( ec );
+        return Found.node != npos;
+    }
+
+    //! \brief  Return true if `p` resolves to a directory, following a
+    //!         symlink in its last element
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Found = resolve( p, true, ec );
+        clear_if_missing( ec );
+        return Found.node != npos && Nodes_[Found.node].kind == node_kind::directory;
+    }
+
+    //! \brief  Return true if the last element of `p` is itself a symlink
+    bool is_symlink( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Found = resolve( p, false, ec );
+        clear_if_missing( ec );
+        return Found.node != npos && Nodes_[Found.node].kind == node_kind::symlink;
+    }
+
+    //! \brief  Return the absolute path of `p` with every symlink resolved
+    //!         and no "." or ".." elements. `p` must exist.
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Found = resolve( p, true, ec );
+        if( Found.node == npos )
+        {
+            return path_t();
+        }
+        return Found.path;
+    }
+
+    //! \brief  Return the target of the symlink `p`
+    path_t read_symlink( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Found = resolve( p, false, ec );
+        if( Found.node == npos )
+        {
+            return path_t();
+        }
+        if( Nodes_[Found.node].kind != node_kind::symlink )
+        {
+            ec.assign( boost::system::errc::invalid_argument, boost::system::generic_category() );
+            return path_t();
+        }
+        return Nodes_[Found.node].target;
+    }
+
+    path_t current_path() const
+    {
+        return Current_;
+    }
+
+    //! \brief  Return the number of directories, files and symlinks, "/"
+    //!         included
+    std::size_t size() const noexcept
+    {
+        return Nodes_.size() - Free_.size();
+    }
+
+    // Changes
+
+    //! \brief  Make the existing directory `p` the one relative paths are
+    //!         resolved from
+    void current_path( const path_t& p, boost::system::error_code& ec )
+    {
+        auto Found = resolve( p, true, ec );
+        if( Found.node == npos )
+        {
+            return;
+        }
+        if( Nodes_[Found.node].kind != node_kind::directory )
+        {
+            ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+            return;
+        }
+        Current_ = Found.path;
+    }
+
+    //! \brief  Create the directory `p`, whose parent must exist. Returns
+    //!         false if `p` is already a directory.
+    bool create_directory( const path_t& p, boost::system::error_code& ec )
+    {
+        return create( p, node_kind::directory, path_t(), ec );
+    }
+
+    //! \brief  Create `p` and any of its ancestors that do not exist.
+    //!         Returns false if `p` is already a directory.
+    bool create_directories( const path_t& p, boost::system::error_code& ec )
+    {
+        ec.clear();
+        path_t Prefix;
+        bool Created = false;
+        for( const auto& Element: p )
+        {
+            Prefix /= Element;
+            if( Element == "." || Element == ".." || Prefix == p.root_path() )
+            {
+                continue;
+            }
+            Created = create( Prefix, node_kind::directory, path_t(), ec );
+            if( ec )
+            {
+                return false;
+            }
+        }
+        return Created;
+    }
+
+    //! \brief  Create the symlink `new_symlink` referring to `to`, which
+    //!         need not exist
+    void create_symlink( const path_t& To, const path_t& NewSymlink, boost::system::error_code& ec )
+    {
+        if( !create( NewSymlink, node_kind::symlink, To, ec ) && !ec )
+        {
+            ec.assign( boost::system::errc::file_exists, boost::system::generic_category() );
+        }
+    }
+
+    void create_directory_symlink( const path_t& To, const path_t& NewSymlink, boost::system::error_code& ec )
+    {
+        create_symlink( To, NewSymlink, ec );
+    }
+
+    //! \brief  Create the empty regular file `p`
+    void create_file( const path_t& p, boost::system::error_code& ec )
+    {
+        if( !create( p, node_kind::file, path_t(), ec ) && !ec )
+        {
+            ec.assign( boost::system::errc::file_exists, boost::system::generic_category() );
+        }
+    }
+
+    //! \brief  Remove `p` and, if it is a directory, everything below it. A
+    //!         symlink in the last element is removed, not followed. Returns
+    //!         the number of entries removed.
+    std::uintmax_t remove_all( const path_t& p, boost::system::error_code& ec )
+    {
+        auto Found = resolve( p, false, ec );
+        if( Found.node == npos )
+        {
+            clear_if_missing( ec );
+            return 0;
+        }
+        if( Found.parent == npos )
+        {
+            // "/", or a path ending in "." or ".."
+            ec.assign( boost::system::errc::invalid_argument, boost::system::generic_category() );
+            return 0;
+        }
+        Nodes_[Found.parent].children.erase( Found.name );
+        return release( Found.node );
+    }
+
+    //! \brief  Copy the tree below the real directory `root` to the same
+    //!         place in this filesystem, creating its ancestors as
+    //!         directories. Symlinks are copied, not followed, so the copy
+    //!         resolves as the original did while it stays within trees
+    //!         that have been loaded.
+    void load( const path_t& Root, boost::system::error_code& ec )
+    {
+        auto Real = boost::filesystem::canonical( Root, ec );
+        if( ec )
+        {
+            return;
+        }
+        create_directories( Real, ec );
+        if( ec )
+        {
+            return;
+        }
+
+        boost::filesystem::recursive_directory_iterator Entry( Real, ec ), End;
+        for( ; !ec && Entry != End; Entry.increment( ec ) )
+        {
+            const auto& Path = Entry->path();
+            auto Status = Entry->symlink_status( ec );
+            if( ec )
+            {
+                return;
+            }
+            if( boost::filesystem::is_symlink( Status ) )
+            {
+                auto Target = boost::filesystem::read_symlink( Path, ec );
+                if( ec )
+                {
+                    return;
+                }
+                create_symlink( Target, Path, ec );
+            }
+            else if( boost::filesystem::is_directory( Status ) )
+            {
+                create_directory( Path, ec );
+            }
+            else
+            {
+                create_file( Path, ec );
+            }
+        }
+    }
+
+    // Throwing forms of the changes, for building trees
+
+    bool create_directories( const path_t& p )
+    {
+        boost::system::error_code ec;
+        auto Created = create_directories( p, ec );
+        throw_if( ec, "xstd::filesystem::memory_filesystem::create_directories", p );
+        return Created;
+    }
+
+    void create_symlink( const path_t& To, const path_t& NewSymlink )
+    {
+        boost::system::error_code ec;
+        create_symlink( To, NewSymlink, ec );
+        throw_if( ec, "xstd::filesystem::memory_filesystem::create_symlink", NewSymlink );
+    }
+
+    void create_directory_symlink( const path_t& To, const path_t& NewSymlink )
+    {
+        create_symlink( To, NewSymlink );
+    }
+
+    void create_file( const path_t& p )
+    {
+        boost::system::error_code ec;
+        create_file( p, ec );
+        throw_if( ec, "xstd::filesystem::memory_filesystem::create_file", p );
+    }
+
+    std::uintmax_t remove_all( const path_t& p )
+    {
+        boost::system::error_code ec;
+        auto Removed = remove_all( p, ec );
+        throw_if( ec, "xstd::filesystem::memory_filesystem::remove_all", p );
+        return Removed;
+    }
+
+    void load( const path_t& Root )
+    {
+        boost::system::error_code ec;
+        load( Root, ec );
+        throw_if( ec, "xstd::filesystem::memory_filesystem::load", Root );
+    }
+
+private:
+
+    static const std::size_t npos = static_cast<std::size_t>( -1 );
+
+    enum class node_kind
+    {
+        directory,
+        file,
+        symlink
+    };
+
+    struct node
+    {
+        node( node_kind Kind, std::size_t Parent, path_t Target = path_t() )
+        : kind( Kind )
+        , parent( Parent )
+        , target( std::move( Target ) )
+        {
+        }
+
+        node_kind                                       kind;
+        std::size_t                                     parent;
+        path_t                                          target;
+        std::unordered_map<std::string, std::size_t>    children;
+    };
+
+    //! Where a path resolved to. If the last element is missing but its
+    //! parent is a directory, `node` is npos and `parent` and `name` say
+    //! where it would be created.
+    struct resolution
+    {
+        std::size_t node = npos;
+        std::size_t parent = npos;
+        std::string name;
+        path_t      path;
+    };
+
+    static void clear_if_missing( boost::system::error_code& ec )
+    {
+        if( ec == boost::system::errc::no_such_file_or_directory || ec == boost::system::errc::not_a_directory )
+        {
+            ec.clear();
+        }
+    }
+
+    static void throw_if( const boost::system::error_code& ec, const char* What, const path_t& p )
+    {
+        if( ec )
+        {
+            BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( What, p, ec ) );
+        }
+    }
+
+    //! Queue the elements of `p` to be resolved before those in `pending`,
+    //! which holds the next element to resolve at its back. A trailing
+    //! separator is queued as an empty element, which requires what
+    //! precedes it to be a directory.
+    static void push_front( std::vector<std::string>& Pending, const path_t& p )
+    {
+        const auto& Spelled = p.native();
+        auto End = Spelled.size();
+        if( End && Spelled.back() == '/' && Spelled.find_first_not_of( '/' ) != std::string::npos )
+        {
+            Pending.emplace_back();
+        }
+        while( End )
+        {
+            auto Slash = Spelled.rfind( '/', End - 1 );
+            auto Begin = Slash == std::string::npos ? 0 : Slash + 1;
+            if( Begin != End )
+            {
+                Pending.emplace_back( Spelled, Begin, End - Begin );
+            }
+            if( Slash == std::string::npos )
+            {
+                break;
+            }
+            End = Slash;
+        }
+    }
+
+    resolution resolve( const path_t& p, bool FollowLast, boost::system::error_code& ec ) const
+    {
+        ec.clear();
+        resolution Result;
+
+        // The directories walked through so far, "/" first
+        std::vector<std::size_t> Trail( 1, 0 );
+        std::vector<const std::string*> Names;
+        std::vector<std::string> Pending;
+        if( p.empty() )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::generic_category() );
+            return Result;
+        }
+        push_front( Pending, p );
+        if( !p.has_root_directory() )
+        {
+            push_front( Pending, Current_ );
+        }
+
+        std::size_t Symlinks = 0;
+        while( !Pending.empty() )
+        {
+            auto Name = std::move( Pending.back() );
+            Pending.pop_back();
+
+            // Only a directory can be followed by a separator
+            const auto& Directory = Nodes_[Trail.back()];
+            if( Directory.kind != node_kind::directory )
+            {
+                ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+                return Result;
+            }
+
+            if( Name.empty() )
+            {
+                continue;
+            }
+            if( Name == "." || Name == ".." )
+            {
+                if( Name == ".." && Trail.size() > 1 )
+                {
+                    Trail.pop_back();
+                    Names.pop_back();
+                }
+                // The entry reached is no longer named by its last element
+                Result.parent = npos;
+                continue;
+            }
+
+            // A trailing separator still lets a missing last element be
+            // created, as `mkdir` does
+            bool Last = Pending.empty() || ( Pending.size() == 1 && Pending.back().empty() );
+
+            auto Child = Directory.children.find( Name );
+            if( Child == Directory.children.end() )
+            {
+                ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::generic_category() );
+                if( Last )
+                {
+                    Result.parent = Trail.back();
+                    Result.name = std::move( Name );
+                }
+                return Result;
+            }
+
+            const auto& Entry = Nodes_[Child->second];
+            if( Entry.kind == node_kind::symlink && ( FollowLast || !Pending.empty() ) )
+            {
+                if( ++Symlinks > max_symlinks )
+                {
+                    ec.assign( boost::system::errc::too_many_symbolic_link_levels, boost::system::generic_category() );
+                    return Result;
+                }
+                if( Entry.target.has_root_directory() )
+                {
+                    Trail.resize( 1 );
+                    Names.clear();
+                }
+                push_front( Pending, Entry.target );
+                continue;
+            }
+
+            if( Last )
+            {
+                Result.parent = Trail.back();
+                Result.name = Name;
+            }
+            Trail.push_back( Child->second );
+            Names.push_back( &Child->first );
+        }
+
+        Result.node = Trail.back();
+
+        std::string Path;
+        for( const auto* Name: Names )
+        {
+            Path += '/';
+            Path += *Name;
+        }
+        Result.path = Path.empty() ? path_t( "/" ) : path_t( Path );
+        return Result;
+    }
+
+    //! Create an entry of `kind` at `p`. Returns false without an error if
+    //! a directory is asked for where one already exists.
+    bool create( const path_t& p, node_kind Kind, const path_t& Target, boost::system::error_code& ec )
+    {
+        auto Found = resolve( p, false, ec );
+        if( Found.node != npos )
+        {
+            if( Kind == node_kind::directory )
+            {
+                auto Existing = resolve( p, true, ec );
+                if( Existing.node != npos && Nodes_[Existing.node].kind == node_kind::directory )
+                {
+                    return false;
+                }
+            }
+            ec.assign( boost::system::errc::file_exists, boost::system::generic_category() );
+            return false;
+        }
+        if( Found.parent == npos )
+        {
+            return false;
+        }
+        ec.clear();
+
+        std::size_t Index;
+        if( Free_.empty() )
+        {
+            Index = Nodes_.size();
+            Nodes_.emplace_back( Kind, Found.parent, Target );
+        }
+        else
+        {
+            Index = Free_.back();
+            Free_.pop_back();
+            Nodes_[Index] = node( Kind, Found.parent, Target );
+        }
+        Nodes_[Found.parent].children.emplace( std::move( Found.name ), Index );
+        return true;
+    }
+
+    std::uintmax_t release( std::size_t Index )
+    {
+        std::uintmax_t Released = 1;
+        for( const auto& Child: Nodes_[Index].children )
+        {
+            Released += release( Child.second );
+        }
+        Nodes_[Index] = node( node_kind::file, npos );
+        Free_.push_back( Index );
+        return Released;
+    }
+
+    std::vector<node>           Nodes_;
+    std::vector<std::size_t>    Free_;
+    path_t                      Current_ = "/";
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations that query a memory_filesystem, so that
+//!         `relative`, `proximate` and `weakly_canonical` given them run
+//!         against the tree in memory instead of the real filesystem
+class memory_operations
+{
+public:
+
+    explicit memory_operations( const xstd::filesystem::memory_filesystem& Filesystem )
+    : Filesystem_( &Filesystem )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Filesystem_->exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Filesystem_->is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Filesystem_->canonical( p, ec );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        ec.clear();
+        return Filesystem_->current_path();
+    }
+
+    const xstd::filesystem::memory_filesystem& filesystem() const noexcept
+    {
+        return *Filesystem_;
+    }
+
+private:
+
+    const xstd::filesystem::memory_filesystem* Filesystem_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
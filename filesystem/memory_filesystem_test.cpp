@@ -0,0 +1,46 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_memory_filesystem
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_memory_filesystem_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_memory_filesystem_resolution )
+{
+    test_memory_filesystem_resolution();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_filesystem_load )
+{
+    test_memory_filesystem_load();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_relative_from_current_path )
+{
+    test_memory_relative_from_current_path();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_real_relative_paths )
+{
+    test_memory_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_multiple_nested_symlinks )
+{
+    test_memory_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_real_and_imaginary_relative_paths )
+{
+    test_memory_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_memory_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_memory_relative_paths_through_files )
+{
+    test_memory_relative_paths_through_files();
+}
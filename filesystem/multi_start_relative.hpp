@@ -0,0 +1,225 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_MULTI_START_RELATIVE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_MULTI_START_RELATIVE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/dirfd_resolver.hpp>
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+#include <filesystem/parallel_relative.hpp>
+#include <filesystem/path_elements.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Batch operations - not part of the proposal
+
+
+//! \brief  Return the leading run of elements shared by `lhs` and `rhs`, as
+//!         spelled in `lhs`, or an empty path if they share no more than a
+//!         root
+inline
+path_t
+shared_prefix( const path_t& Lhs, const path_t& Rhs )
+{
+    const auto& l = Lhs.native();
+    const auto& r = Rhs.native();
+
+    std::size_t Elements = 0;
+    std::size_t Last = 0;
+    auto LhsElement = xstd::filesystem::first_element( l.data(), l.size() );
+    auto RhsElement = xstd::filesystem::first_element( r.data(), r.size() );
+    for( ; !is_end( LhsElement ) && !is_end( RhsElement );
+           LhsElement = xstd::filesystem::next_element( l.data(), l.size(), LhsElement ),
+           RhsElement = xstd::filesystem::next_element( r.data(), r.size(), RhsElement ) )
+    {
+        // The "." following a trailing separator ends a directory's spelling
+        if( LhsElement.data != l.data() + LhsElement.first
+            || LhsElement.size != RhsElement.size
+            || std::memcmp( LhsElement.data, RhsElement.data, LhsElement.size ) != 0 )
+        {
+            break;
+        }
+        ++Elements;
+        Last = LhsElement.last;
+    }
+    return Elements > 1 ? path_t( l.substr( 0, Last ) ) : path_t();
+}
+
+
+//! \brief  Compute `relative( p, start, ec, ops )` for every start in
+//!         `starts` using up to `threads` threads, returning the results in
+//!         the order of `starts`
+//!
+//! \param  p - the path we want relative paths to
+//!
+//! \param  starts - the paths that we want the relative paths from
+//!
+//! \param  threads - the number of threads to use, or 0 to use one per core
+//!
+//! \param  ops - the object used to query the filesystem, see `system_operations`
+//!
+//! \param  statistics - if not null, receives what each thread did
+//!
+//! \note   `p` is made canonical once rather than once per start, and each
+//!         distinct spelling of a start once however often it appears.
+//!         Starts are resolved in the order of their spelling, so those
+//!         sharing leading elements are resolved one after another by the
+//!         same thread, where `ops` that cache or anchor directories can
+//!         reuse the work done for the shared part.
+template<class Operations>
+std::vector<path_result>
+relative_from_starts( const path_t& p, const std::vector<path_t>& Starts, std::size_t Threads, const Operations& ops, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    boost::system::error_code base_ec;
+    auto Base = ops.current_path( base_ec );
+    if( base_ec )
+    {
+        return std::vector<path_result>( Starts.size(), path_result{ path_t(), base_ec } );
+    }
+
+    boost::system::error_code p_ec;
+    auto real_p = real_path_helper( p.is_relative() ? absolute( p, Base ) : p, p_ec, ops );
+
+    std::vector<path_t> Absolute;
+    Absolute.reserve( Starts.size() );
+    for( const auto& Start: Starts )
+    {
+        Absolute.push_back( Start.is_relative() ? absolute( Start, Base ) : Start );
+    }
+
+    // Sorted by spelling, which is much cheaper than comparing by element
+    std::vector<std::size_t> Order( Starts.size() );
+    std::iota( Order.begin(), Order.end(), std::size_t( 0 ) );
+    std::sort( Order.begin(), Order.end(), [&]( std::size_t Lhs, std::size_t Rhs )
+    {
+        return Absolute[Lhs].native() < Absolute[Rhs].native();
+    } );
+
+    std::vector<std::size_t> Distinct;
+    std::vector<std::size_t> DistinctOf( Starts.size() );
+    for( auto Start: Order )
+    {
+        if( Distinct.empty() || Absolute[Distinct.back()].native() != Absolute[Start].native() )
+        {
+            Distinct.push_back( Start );
+        }
+        DistinctOf[Start] = Distinct.size() - 1;
+    }
+
+    std::vector<path_result> Resolved( Distinct.size() );
+    auto Workers = xstd::filesystem::work_stealing_for( Distinct.size(), Threads, [&]( std::size_t First, std::size_t Last )
+    {
+        for( ; First != Last; ++First )
+        {
+            auto& Result = Resolved[First];
+            auto real_start = real_start_helper( Absolute[ Distinct[First] ], Result.ec, ops );
+            if( Result.ec )
+            {
+                continue;
+            }
+            if( p_ec )
+            {
+                Result.ec = p_ec;
+                continue;
+            }
+            Result.path = lexically_relative( real_p, real_start );
+        }
+    } );
+    if( Statistics )
+    {
+        *Statistics = std::move( Workers );
+    }
+
+    std::vector<path_result> Results;
+    Results.reserve( Starts.size() );
+    for( auto Start: DistinctOf )
+    {
+        Results.push_back( Resolved[Start] );
+    }
+    return Results;
+}
+
+
+//! \brief  Compute `relative( p, start, ec )` for every start in `starts`
+//!         using up to `threads` threads, returning the results in the
+//!         order of `starts`
+//!
+//! \note   Starts are resolved with a dirfd_resolver in which each leading
+//!         run of elements shared by two starts, adjacent in the order of
+//!         their spelling, is anchored first. A group of starts below one
+//!         directory then walks that directory's path once, and each start
+//!         in the group only the elements that follow it.
+inline
+std::vector<path_result>
+relative_from_starts( const path_t& p, const std::vector<path_t>& Starts, std::size_t Threads = 0, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    auto Base = current_path();
+    std::vector<path_t> Absolute;
+    Absolute.reserve( Starts.size() );
+    for( const auto& Start: Starts )
+    {
+        Absolute.push_back( Start.is_relative() ? absolute( Start, Base ) : Start );
+    }
+    std::sort( Absolute.begin(), Absolute.end(), []( const path_t& Lhs, const path_t& Rhs )
+    {
+        return Lhs.native() < Rhs.native();
+    } );
+
+    // Shorter prefixes sort first, so deeper ones are anchored from them
+    std::vector<path_t> Prefixes;
+    for( std::size_t Start = 1; Start < Absolute.size(); ++Start )
+    {
+        auto Prefix = shared_prefix( Absolute[Start - 1], Absolute[Start] );
+        if( !Prefix.empty() )
+        {
+            Prefixes.push_back( std::move( Prefix ) );
+        }
+    }
+    std::sort( Prefixes.begin(), Prefixes.end(), []( const path_t& Lhs, const path_t& Rhs )
+    {
+        return Lhs.native() < Rhs.native();
+    } );
+    Prefixes.erase( std::unique( Prefixes.begin(), Prefixes.end(), []( const path_t& Lhs, const path_t& Rhs )
+    {
+        return Lhs.native() == Rhs.native();
+    } ), Prefixes.end() );
+
+    xstd::filesystem::dirfd_resolver Resolver;
+    for( const auto& Prefix: Prefixes )
+    {
+        // A prefix that cannot be anchored is simply resolved in full
+        boost::system::error_code ec;
+        if( Prefix.has_root_directory() && !Prefix.has_root_name() )
+        {
+            Resolver.anchor( Prefix, ec );
+        }
+    }
+    return relative_from_starts( p, Starts, Threads, dirfd_operations( Resolver ), Statistics );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,31 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_multi_start_relative
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_multi_start_relative_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_shared_prefix )
+{
+    test_shared_prefix();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_multi_start_package_tree )
+{
+    test_multi_start_package_tree();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_multi_start_real_relative_paths )
+{
+    test_multi_start_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_multi_start_imaginary_relative_paths )
+{
+    test_multi_start_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_multi_start_real_and_imaginary_relative_paths )
+{
+    test_multi_start_real_and_imaginary_relative_paths();
+}
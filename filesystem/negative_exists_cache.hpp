@@ -0,0 +1,339 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_NEGATIVE_EXISTS_CACHE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_NEGATIVE_EXISTS_CACHE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/lexical_cache.hpp>
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Remembers absolute paths that were found not to exist so that
+//!         asking again can be answered without a system call.
+//!
+//!         An entry is trusted until its time to live runs out or until
+//!         `invalidate` is called on the path or on any directory it is
+//!         spelled below, whichever is first. Hits are answered without
+//!         looking at the filesystem, so there is no staleness check of
+//!         their own: the generations kept per directory only record calls
+//!         to `invalidate`. Callers that create files should invalidate the
+//!         directory they created them in. A file created by another
+//!         process or tool stays "known missing" until its entry expires,
+//!         which is why the default time to live is short.
+//!
+//!         Paths are compared as spelled, without normalization, because
+//!         `..` after a symlink does not resolve lexically.
+//!
+//!         Invalidations are recorded in shards, as entries are, and each is
+//!         kept for one time to live. Once a record is dropped every entry
+//!         made before it is treated as invalidated, which can only turn a
+//!         hit into a miss.
+class negative_exists_cache
+{
+public:
+
+    using clock_t    = std::chrono::steady_clock;
+    using duration_t = clock_t::duration;
+
+    static const std::size_t default_capacity = 64 * 1024;
+
+    //! The number of shards invalidation records are spread across
+    static const std::size_t invalidation_shards = 16;
+
+    //! The time to live bounds how long a file created without a call to
+    //! `invalidate` is reported missing
+    explicit negative_exists_cache( duration_t TimeToLive = std::chrono::milliseconds( 100 ), std::size_t Capacity = default_capacity )
+    : TimeToLive_( TimeToLive )
+    , Missing_( Capacity )
+    {
+        Invalidated_.reserve( invalidation_shards );
+        for( std::size_t i = 0; i != invalidation_shards; ++i )
+        {
+            Invalidated_.emplace_back( new invalidation_shard );
+        }
+    }
+
+    negative_exists_cache( const negative_exists_cache& ) = delete;
+    negative_exists_cache& operator=( const negative_exists_cache& ) = delete;
+
+    //! \brief  Return true if `p` is known not to exist
+    bool known_missing( const boost::filesystem::path_t& p )
+    {
+        entry Entry;
+        if( !Missing_.find( p.native(), Entry )
+            || clock_t::now() >= Entry.expires
+            || invalidated_since( p, Entry.generation ) )
+        {
+            Misses_.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+        Hits_.fetch_add( 1, std::memory_order_relaxed );
+        return true;
+    }
+
+    //! \brief  Return the current invalidation generation, to be read
+    //!         before probing a path that may be passed to `insert_missing`
+    std::uint64_t generation() const noexcept
+    {
+        return Generation_.load( std::memory_order_acquire );
+    }
+
+    //! \brief  Record that `p` was found not to exist by a probe made after
+    //!         `generation` was read. An invalidation made between the two
+    //!         leaves the entry stale, so the race is always resolved by
+    //!         probing again.
+    void insert_missing( const boost::filesystem::path_t& p, std::uint64_t Generation )
+    {
+        entry Entry;
+        Entry.expires    = clock_t::now() + TimeToLive_;
+        Entry.generation = Generation;
+        Missing_.insert( p.native(), Entry );
+    }
+
+    //! \brief  Forget that `p`, and any path spelled below it, was missing
+    void invalidate( const boost::filesystem::path_t& p )
+    {
+        auto Now = clock_t::now();
+        {
+            auto& Shard = shard_for( p.native() );
+            std::lock_guard<std::mutex> Lock( Shard.Mutex );
+            // Taken under the shard's lock so that the records of each shard
+            // are in the order of their generations
+            auto Generation = Generation_.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+            Shard.Generations[ p.native() ] = Generation;
+            Shard.Order.push_back( invalidation{ Now, Generation, p.native() } );
+            prune( Shard, Now );
+        }
+
+        // Shards that are rarely invalidated are pruned in turn by others
+        auto Next = NextPruned_.fetch_add( 1, std::memory_order_relaxed ) % Invalidated_.size();
+        auto& Other = *Invalidated_[Next];
+        std::lock_guard<std::mutex> Lock( Other.Mutex );
+        prune( Other, Now );
+    }
+
+    //! \brief  Forget everything
+    void clear()
+    {
+        raise_floor( Generation_.load( std::memory_order_acquire ) );
+        for( auto& Shard: Invalidated_ )
+        {
+            std::lock_guard<std::mutex> Lock( Shard->Mutex );
+            Shard->Generations.clear();
+            Shard->Order.clear();
+        }
+        Missing_.clear();
+    }
+
+    //! \brief  Return the number of invalidations still recorded
+    std::size_t invalidations() const
+    {
+        std::size_t Count = 0;
+        for( auto& Shard: Invalidated_ )
+        {
+            std::lock_guard<std::mutex> Lock( Shard->Mutex );
+            Count += Shard->Generations.size();
+        }
+        return Count;
+    }
+
+    cache_statistics statistics() const
+    {
+        cache_statistics Statistics = Missing_.statistics();
+        Statistics.hits   = Hits_.load( std::memory_order_relaxed );
+        Statistics.misses = Misses_.load( std::memory_order_relaxed );
+        return Statistics;
+    }
+
+private:
+
+    struct entry
+    {
+        clock_t::time_point expires;
+        std::uint64_t       generation = 0;
+    };
+
+    struct invalidation
+    {
+        clock_t::time_point time;
+        std::uint64_t       generation;
+        std::string         path;
+    };
+
+    struct invalidation_shard
+    {
+        std::mutex                                      Mutex;
+        std::unordered_map<std::string, std::uint64_t>  Generations;
+        std::deque<invalidation>                        Order;
+    };
+
+    invalidation_shard& shard_for( const std::string& Path ) const
+    {
+        return *Invalidated_[ std::hash<std::string>()( Path ) % Invalidated_.size() ];
+    }
+
+    //! Drop the records of `shard` older than one time to live, first
+    //! raising the floor so that entries they covered stay invalidated
+    void prune( invalidation_shard& Shard, clock_t::time_point Now )
+    {
+        while( !Shard.Order.empty() && Now - Shard.Order.front().time >= TimeToLive_ )
+        {
+            const auto& Oldest = Shard.Order.front();
+            raise_floor( Oldest.generation );
+            auto Record = Shard.Generations.find( Oldest.path );
+            if( Record != Shard.Generations.end() && Record->second == Oldest.generation )
+            {
+                Shard.Generations.erase( Record );
+            }
+            Shard.Order.pop_front();
+        }
+    }
+
+    void raise_floor( std::uint64_t Generation )
+    {
+        auto Floor = Floor_.load( std::memory_order_relaxed );
+        while( Floor < Generation && !Floor_.compare_exchange_weak( Floor, Generation, std::memory_order_release, std::memory_order_relaxed ) )
+        {
+        }
+    }
+
+    bool invalidated_since( const boost::filesystem::path_t& p, std::uint64_t Generation ) const
+    {
+        // Nothing at all has been invalidated since the entry was made
+        if( Generation_.load( std::memory_order_acquire ) == Generation )
+        {
+            return false;
+        }
+        for( auto Ancestor = p; !Ancestor.empty(); Ancestor = Ancestor.parent_path() )
+        {
+            auto& Shard = shard_for( Ancestor.native() );
+            std::lock_guard<std::mutex> Lock( Shard.Mutex );
+            auto Invalidated = Shard.Generations.find( Ancestor.native() );
+            if( Invalidated != Shard.Generations.end() && Invalidated->second > Generation )
+            {
+                return true;
+            }
+        }
+        // Checked last, as a record is only dropped after the floor is raised
+        return Generation < Floor_.load( std::memory_order_acquire );
+    }
+
+    duration_t                                          TimeToLive_;
+    sharded_lru_cache<std::string, entry>               Missing_;
+    std::atomic<std::uint64_t>                          Generation_{ 0 };
+    std::atomic<std::uint64_t>                          Floor_{ 0 };
+    std::atomic<std::size_t>                            NextPruned_{ 0 };
+    std::vector<std::unique_ptr<invalidation_shard>>    Invalidated_;
+    std::atomic<std::uint64_t>                          Hits_{ 0 };
+    std::atomic<std::uint64_t>                          Misses_{ 0 };
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations for `relative` and `proximate` that answer
+//!         `exists` for absolute paths known not to exist from a
+//!         negative_exists_cache, and forward everything else to `Operations`.
+template<class Operations = system_operations>
+class negative_exists_operations
+{
+public:
+
+    explicit negative_exists_operations( xstd::filesystem::negative_exists_cache& Cache, const Operations& Ops = Operations() )
+    : Cache_( Cache )
+    , Ops_( Ops )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        // A relative path depends on the current directory so is not cached
+        if( p.is_relative() )
+        {
+            return Ops_.exists( p, ec );
+        }
+        if( Cache_.known_missing( p ) )
+        {
+            // Report the miss the same way `exists` does
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::system_category() );
+            return false;
+        }
+        auto Generation = Cache_.generation();
+        bool path_exists = Ops_.exists( p, ec );
+        if( !path_exists && is_not_found( ec ) )
+        {
+            Cache_.insert_missing( p, Generation );
+        }
+        return path_exists;
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.canonical( p, ec );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return Ops_.current_path( ec );
+    }
+
+private:
+
+    //! `exists` reports a missing path either with no error or with the
+    //! error from the failed lookup, depending on the Boost version
+    static bool is_not_found( const boost::system::error_code& ec )
+    {
+        return !ec
+            || ec == boost::system::errc::no_such_file_or_directory
+            || ec == boost::system::errc::not_a_directory;
+    }
+
+    xstd::filesystem::negative_exists_cache&    Cache_;
+    Operations                                  Ops_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
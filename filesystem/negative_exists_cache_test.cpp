@@ -0,0 +1,26 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_negative_exists_cache
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_negative_exists_cache_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_negative_exists_imaginary_relative_paths )
+{
+    test_negative_exists_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_negative_exists_invalidation )
+{
+    test_negative_exists_invalidation();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_negative_exists_expiry )
+{
+    test_negative_exists_expiry();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_negative_exists_invalidation_records )
+{
+    test_negative_exists_invalidation_records();
+}
@@ -0,0 +1,211 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_ASYNC_OPERATIONS_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_ASYNC_OPERATIONS_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/async_operations.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <exception>
+#include <functional>
+#include <future>
+#include <utility>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+#if defined( XSTD_FILESYSTEM_HAS_COROUTINES )
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! A coroutine that starts at once and signals a future when it finishes
+struct test_task
+{
+    struct promise_type
+    {
+        std::promise<void> Done;
+
+        test_task get_return_object()
+        {
+            return test_task{ Done.get_future() };
+        }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void()
+        {
+            Done.set_value();
+        }
+
+        void unhandled_exception()
+        {
+            Done.set_exception( std::current_exception() );
+        }
+    };
+
+    std::future<void> Finished;
+};
+
+
+template<class Awaitable>
+test_task await_into( Awaitable Operation, path_t& Result )
+{
+    Result = co_await std::move( Operation );
+}
+
+
+//! Block until `operation` completes and return its result
+template<class Awaitable>
+path_t wait_for( Awaitable Operation )
+{
+    path_t Result;
+    await_into( std::move( Operation ), Result ).Finished.get();
+    return Result;
+}
+
+
+//! Runs posted work at once on the posting thread, counting it
+struct inline_executor
+{
+    void post( std::function<void()> Work )
+    {
+        ++Posts;
+        Work();
+    }
+
+    int Posts = 0;
+};
+
+
+void check_async_relative( const path_t& Path, const path_t& Start )
+{
+    test_relative( Path, Start );
+
+    boost::system::error_code ec;
+    auto Expected = boost::filesystem::relative( Path, Start, ec );
+
+    boost::system::error_code async_ec;
+    auto Relative = wait_for( boost::filesystem::async_relative( Path, Start, async_ec ) );
+
+    BOOST_CHECK_MESSAGE( Relative == Expected, "From " << Start << " to " << Path << ": " << Relative << " != " << Expected );
+    BOOST_CHECK( async_ec == ec );
+
+    auto Proximate = wait_for( boost::filesystem::async_proximate( Path, Start, async_ec ) );
+    BOOST_CHECK( Proximate == boost::filesystem::proximate( Path, Start, ec ) );
+    BOOST_CHECK( async_ec == ec );
+
+    auto WeaklyCanonical = wait_for( boost::filesystem::async_weakly_canonical( Path, async_ec ) );
+    BOOST_CHECK( WeaklyCanonical == weakly_canonical( Path, ec ) );
+    BOOST_CHECK( async_ec == ec );
+
+    if( exists( Path ) )
+    {
+        BOOST_CHECK( wait_for( boost::filesystem::async_canonical( Path, async_ec ) ) == canonical( Path ) );
+        BOOST_CHECK( !async_ec );
+    }
+}
+
+
+void test_async_real_relative_paths()
+{
+    test_real_relative_paths( check_async_relative );
+}
+
+
+void test_async_multiple_nested_symlinks()
+{
+    multiple_nested_symlinks( check_async_relative );
+}
+
+
+void test_async_imaginary_relative_paths()
+{
+    test_imaginary_relative_paths( check_async_relative );
+}
+
+
+void test_async_real_and_imaginary_relative_paths()
+{
+    test_real_and_imaginary_relative_paths( check_async_relative );
+}
+
+
+void test_async_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    test_real_and_imaginary_relative_paths_with_parent_and_current_directories( check_async_relative );
+}
+
+
+//! Cancels a source the first time `exists` is called
+struct cancelling_operations : boost::filesystem::system_operations
+{
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        Source->cancel();
+        return boost::filesystem::system_operations::exists( p, ec );
+    }
+
+    xstd::filesystem::cancellation_source* Source;
+};
+
+
+void test_async_executor_and_cancellation()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a_level_1 = test_base / "a_level_1";
+    create_directories( a_level_1 );
+
+    inline_executor Executor;
+    boost::system::error_code ec;
+
+    auto Relative = wait_for( boost::filesystem::async_relative( test_base, a_level_1, ec, boost::filesystem::system_operations(), Executor ) );
+    BOOST_CHECK( Relative == ".." && !ec );
+    BOOST_CHECK( Executor.Posts == 1 );
+
+    // Cancelled before it runs
+    xstd::filesystem::cancellation_source Source;
+    Source.cancel();
+
+    Relative = wait_for( boost::filesystem::async_relative( test_base, a_level_1, ec, Source.token() ) );
+    BOOST_CHECK( Relative.empty() && ec == boost::system::errc::operation_canceled );
+
+    BOOST_CHECK_THROW( wait_for( boost::filesystem::async_proximate( test_base, a_level_1, Source.token() ) ), boost::filesystem::filesystem_error );
+
+    // Cancelled part way through
+    xstd::filesystem::cancellation_source During;
+    cancelling_operations Cancelling;
+    Cancelling.Source = &During;
+
+    Relative = wait_for( boost::filesystem::async_relative( test_base, a_level_1, ec, Cancelling, Executor, During.token() ) );
+    BOOST_CHECK( Relative.empty() && ec == boost::system::errc::operation_canceled );
+
+    // Errors are reported as by the synchronous overloads
+    auto file = test_base / "file";
+    boost::filesystem::ofstream( file ) << "file";
+
+    Relative = wait_for( boost::filesystem::async_relative( a_level_1, file, ec ) );
+    BOOST_CHECK( Relative.empty() && ec == boost::system::errc::not_a_directory );
+
+    BOOST_CHECK_THROW( wait_for( boost::filesystem::async_relative( a_level_1, file ) ), boost::filesystem::filesystem_error );
+
+    remove_all( test_base );
+}
+
+
+#endif
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_ASYNC_OPERATIONS_TESTS_HPP_INCLUDED
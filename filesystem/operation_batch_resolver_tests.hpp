@@ -0,0 +1,197 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_BATCH_RESOLVER_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_BATCH_RESOLVER_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/batch_resolver.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <memory>
+#include <utility>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_batch_resolver_paths( xstd::filesystem::batch_resolver::backend Backend )
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+
+    create_directories( a_level_2 );
+
+    auto file = a_level_2 / "file";
+    boost::filesystem::ofstream( file ) << "file";
+
+    auto b_level_1 = test_base / "b_level_1";
+
+    create_directories( b_level_1 );
+
+    create_directory_symlink( "../a_level_1/a_level_2", b_level_1 / "to_a_level_2" );
+    create_directory_symlink( a_level_2, b_level_1 / "absolute" );
+    create_symlink( "to_a_level_2/file", b_level_1 / "to_file" );
+    create_symlink( "missing/x", b_level_1 / "dangling" );
+    create_symlink( "loop_b", b_level_1 / "loop_a" );
+    create_symlink( "loop_a", b_level_1 / "loop_b" );
+
+    std::vector<path_t> Paths =
+    {
+        "/",
+        test_base,
+        a_level_2 / ".." / ".",
+        path_t( a_level_2.native() + "/" ),
+        file,
+        file / "x",
+        file / "..",
+        a_level_2 / "missing" / ".." / "y",
+        b_level_1 / "to_a_level_2" / "..",
+        b_level_1 / "absolute" / "file",
+        b_level_1 / "to_file",
+        b_level_1 / "to_file" / "z",
+        b_level_1 / "dangling",
+        b_level_1 / "dangling" / ".." / "w",
+        b_level_1 / "loop_a" / "x",
+        "test_level_0/b_level_1/to_a_level_2",
+    };
+
+    xstd::filesystem::batch_resolver Resolver( Backend, 3 );
+
+    std::vector<int> Calls( Paths.size() );
+    Resolver.resolve( Paths, [&]( std::size_t Index, xstd::filesystem::batch_resolution&& Result )
+    {
+        const auto& p = Paths[Index];
+        ++Calls[Index];
+
+        boost::system::error_code ec;
+        bool Exists = exists( p, ec );
+        auto Expected = Exists ? canonical( p ) : weakly_canonical( p );
+
+        BOOST_TEST_MESSAGE( "Path            = " << p );
+        BOOST_TEST_MESSAGE( "Resolved        = " << Result.real_path );
+        BOOST_TEST_MESSAGE( "Expected        = " << Expected );
+
+        BOOST_CHECK_MESSAGE( Result.found == Exists, p );
+        BOOST_CHECK_MESSAGE( Result.real_path == Expected, p << ": " << Result.real_path << " != " << Expected );
+        BOOST_CHECK( Result.is_directory == ( Exists && is_directory( p ) ) );
+    } );
+
+    for( auto Count: Calls )
+    {
+        BOOST_CHECK( Count == 1 );
+    }
+
+    remove_all( test_base );
+}
+
+
+//! Records each pair and checks a batch of every pair so far against
+//! calling `relative` and `proximate` for each in turn
+template<class Scenario>
+void run_batched( Scenario Run, xstd::filesystem::batch_resolver::backend Backend )
+{
+    auto Resolver = std::make_shared<xstd::filesystem::batch_resolver>( Backend, 4, 8 );
+    auto Pairs = std::make_shared<std::vector<std::pair<path_t, path_t>>>();
+
+    Run( [Resolver, Pairs]( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        Pairs->emplace_back( Path, Start );
+
+        std::vector<int> Calls( Pairs->size() );
+        boost::filesystem::batch_relative( *Pairs, [&]( std::size_t Pair, path_t&& Relative, const boost::system::error_code& batch_ec )
+        {
+            ++Calls[Pair];
+
+            const auto& p = ( *Pairs )[Pair].first;
+            const auto& start = ( *Pairs )[Pair].second;
+
+            boost::system::error_code ec;
+            auto Expected = boost::filesystem::relative( p, start, ec );
+
+            BOOST_CHECK_MESSAGE( Relative == Expected, "From " << start << " to " << p << ": " << Relative << " != " << Expected );
+            BOOST_CHECK( batch_ec == ec );
+        },
+        *Resolver );
+
+        boost::filesystem::batch_proximate( *Pairs, [&]( std::size_t Pair, path_t&& Proximate, const boost::system::error_code& )
+        {
+            const auto& p = ( *Pairs )[Pair].first;
+            const auto& start = ( *Pairs )[Pair].second;
+
+            boost::system::error_code ec;
+            BOOST_CHECK( Proximate == boost::filesystem::proximate( p, start, ec ) );
+        },
+        *Resolver );
+
+        for( auto Count: Calls )
+        {
+            BOOST_CHECK( Count == 1 );
+        }
+    } );
+}
+
+
+template<class Scenario>
+void run_with_each_backend( Scenario Run )
+{
+    BOOST_TEST_MESSAGE( "io_uring available = " << xstd::filesystem::batch_resolver().uses_io_uring() );
+
+    run_batched( Run, xstd::filesystem::batch_resolver::backend::automatic );
+    run_batched( Run, xstd::filesystem::batch_resolver::backend::threads );
+}
+
+
+void test_batch_resolver_backends()
+{
+    test_batch_resolver_paths( xstd::filesystem::batch_resolver::backend::automatic );
+    test_batch_resolver_paths( xstd::filesystem::batch_resolver::backend::threads );
+}
+
+
+void test_batch_real_relative_paths()
+{
+    run_with_each_backend( test_real_relative_paths );
+}
+
+
+void test_batch_multiple_nested_symlinks()
+{
+    run_with_each_backend( multiple_nested_symlinks );
+}
+
+
+void test_batch_imaginary_relative_paths()
+{
+    run_with_each_backend( test_imaginary_relative_paths );
+}
+
+
+void test_batch_real_and_imaginary_relative_paths()
+{
+    run_with_each_backend( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_batch_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_with_each_backend( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_BATCH_RESOLVER_TESTS_HPP_INCLUDED
@@ -6,6 +6,8 @@
 // I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
 
 // Filesystem Includes
+#include "filesystem/common_prefix_accumulator.hpp"
+#include "filesystem/group_by_prefix.hpp"
 #include "filesystem/operations.hpp"
 #include "filesystem/path.hpp"
 
@@ -13,7 +15,9 @@
 #include <boost/filesystem.hpp>
 
 // C++ Standard Library Includes
-// None
+#include <algorithm>
+#include <string>
+#include <vector>
 
 // I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
 
@@ -113,5 +117,143 @@ void test_common_prefix_from_initializer_list()
 }
 
 
+void test_common_prefix_accumulator()
+{
+    std::vector<path_t> Paths = {
+        "/a/b/c/d/e/f/g/h", "/a/b/c/d/j/k", "/a/b/c/p/q/r", "/a/b/c", "/a/b/c/", "/a/b/cd"
+    };
+
+    boost::filesystem::common_prefix_accumulator Accumulator;
+
+    BOOST_CHECK( Accumulator.prefix().empty() );
+
+    for( auto Last = Paths.begin() + 1; Last <= Paths.end(); ++Last )
+    {
+        Accumulator.add( *( Last - 1 ) );
+        auto Expected = common_prefix( Paths.begin(), Last );
+
+        BOOST_TEST_MESSAGE( "Accumulated = [" << Accumulator.prefix() << "], Expected = [" << Expected << "]" );
+        BOOST_CHECK( Accumulator.prefix() == Expected );
+        BOOST_CHECK( Accumulator.prefix().native() == Expected.native() );
+    }
+
+    BOOST_CHECK( Accumulator.size() == Paths.size() );
+    BOOST_CHECK( Accumulator.depth() == 3 );
+
+    Accumulator.add( "//root_x/a/b" );
+    BOOST_CHECK( Accumulator.prefix().empty() );
+
+    Accumulator.clear();
+    Accumulator.add( "a/b//c/" );
+    BOOST_CHECK( Accumulator.prefix().native() == boost::filesystem::common_prefix( { path_t( "a/b//c/" ) } ).native() );
+}
+
+
+void test_common_prefix_accumulator_merge()
+{
+    path_t Common = "/a/b/c";
+
+    std::vector<path_t> Paths;
+    for( const auto& RelPath: { "d/e/f/g/h", "d/j/k", "d/e/x", "d/e/f/y", "p/q/r", "d/e" } )
+    {
+        Paths.push_back( Common / RelPath );
+    }
+
+    for( std::size_t Split = 0; Split <= Paths.size(); ++Split )
+    {
+        boost::filesystem::common_prefix_accumulator Left;
+        boost::filesystem::common_prefix_accumulator Right;
+
+        for( std::size_t i = 0; i != Paths.size(); ++i )
+        {
+            ( i < Split ? Left : Right ).add( Paths[i] );
+        }
+        BOOST_CHECK( Left.size() == 0 || Left.prefix() == common_prefix( Paths.begin(), Paths.begin() + Split ) );
+
+        Left.merge( Right );
+
+        BOOST_CHECK( Left.size() == Paths.size() );
+        BOOST_CHECK( Left.prefix() == common_prefix( Paths.begin(), Paths.end() ) );
+        BOOST_CHECK( Left.prefix() == Common );
+    }
+
+    boost::filesystem::common_prefix_accumulator Empty;
+    boost::filesystem::common_prefix_accumulator WithEmptyPath;
+    WithEmptyPath.add( path_t() );
+    Empty.merge( WithEmptyPath );
+    Empty.add( Common );
+
+    BOOST_CHECK( Empty.prefix().empty() );
+}
+
+
+void test_group_by_common_prefix()
+{
+    std::vector<path_t> Paths = {
+        "/a/b/c/d/e", "/x/y/z/1", "/a/b/c/d/f", "/a/b/g/h", "/x/y/z/2", "/a/b/c/i", "/x/q", "/a", "relative/path", "/x/y/z/3/4"
+    };
+
+    for( std::size_t Threads: { 1, 2, 4 } )
+    {
+        auto Groups = boost::filesystem::group_by_common_prefix( Paths.begin(), Paths.end(), 3, Threads );
+
+        BOOST_REQUIRE( Groups.size() == 5 );
+
+        BOOST_CHECK( Groups[0].prefix == path_t( "/a" ) );
+        BOOST_CHECK( Groups[0].members == std::vector<path_t>( { "" } ) );
+
+        BOOST_CHECK( Groups[1].prefix == path_t( "/a/b" ) );
+        BOOST_CHECK( Groups[1].members == std::vector<path_t>( { "c/d/e", "c/d/f", "g/h", "c/i" } ) );
+
+        BOOST_CHECK( Groups[2].prefix == path_t( "/x/q" ) );
+
+        BOOST_CHECK( Groups[3].prefix == path_t( "/x/y/z" ) );
+        BOOST_CHECK( Groups[3].members == std::vector<path_t>( { "1", "2", "3/4" } ) );
+
+        BOOST_CHECK( Groups[4].prefix == path_t( "relative/path" ) );
+
+        std::size_t Members = 0;
+        for( const auto& Group: Groups )
+        {
+            BOOST_TEST_MESSAGE( "Group prefix = [" << Group.prefix << "] members = " << Group.members.size() );
+            for( const auto& Member: Group.members )
+            {
+                auto Path = Group.prefix / Member;
+                BOOST_CHECK( std::find( Paths.begin(), Paths.end(), Member.empty() ? Group.prefix : Path ) != Paths.end() );
+            }
+            Members += Group.members.size();
+        }
+        BOOST_CHECK( Members == Paths.size() );
+    }
+
+    auto Single = boost::filesystem::group_by_common_prefix( Paths.begin(), Paths.begin() + 6, 0 );
+
+    BOOST_REQUIRE( Single.size() == 1 );
+    BOOST_CHECK( Single[0].prefix == common_prefix( Paths.begin(), Paths.begin() + 6 ) );
+}
+
+
+void test_group_by_common_prefix_large()
+{
+    std::vector<path_t> Paths;
+    for( int i = 0; i != 5000; ++i )
+    {
+        Paths.push_back( path_t( "/build" ) / ( "shard_" + std::to_string( i % 37 ) ) / ( "dir_" + std::to_string( i % 11 ) ) / ( "file_" + std::to_string( i ) ) );
+    }
+
+    auto Serial   = boost::filesystem::group_by_common_prefix( Paths.begin(), Paths.end(), 3, 1 );
+    auto Parallel = boost::filesystem::group_by_common_prefix( Paths.begin(), Paths.end(), 3, 8 );
+
+    BOOST_REQUIRE( Serial.size() == 37 );
+    BOOST_REQUIRE( Parallel.size() == Serial.size() );
+
+    for( std::size_t i = 0; i != Serial.size(); ++i )
+    {
+        BOOST_CHECK( Serial[i].prefix == Parallel[i].prefix );
+        BOOST_CHECK( Serial[i].members == Parallel[i].members );
+    }
+}
+
+
 // G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
 #endif//FILESYSTEM_OPERATION_COMMON_PREFIX_TESTS_HPP_INCLUDED
@@ -0,0 +1,200 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_CONCURRENT_PATH_MAP_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_CONCURRENT_PATH_MAP_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/concurrent_path_map.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_concurrent_path_map_insert_and_find()
+{
+    xstd::filesystem::concurrent_path_map Map( 3 );
+
+    BOOST_CHECK( Map.bucket_count() == 4 );
+    BOOST_CHECK( Map.find( "/a" ) == nullptr );
+
+    for( int i = 0; i != 100; ++i )
+    {
+        auto Key = path_t( "/a" ) / std::to_string( i );
+        BOOST_CHECK( Map.insert( Key, Key / "real" ) == Key / "real" );
+    }
+    BOOST_CHECK( Map.size() == 100 );
+
+    // The first value inserted for a key is kept
+    BOOST_CHECK( Map.insert( "/a/7", "/other" ) == "/a/7/real" );
+    BOOST_CHECK( Map.size() == 100 );
+
+    for( int i = 0; i != 100; ++i )
+    {
+        auto Key = path_t( "/a" ) / std::to_string( i );
+        auto Value = Map.find( Key );
+        BOOST_CHECK( Value && *Value == Key / "real" );
+    }
+    BOOST_CHECK( Map.find( "/a/100" ) == nullptr );
+}
+
+
+void test_concurrent_path_map_concurrent_insert()
+{
+    xstd::filesystem::concurrent_path_map Map( 16 );
+
+    const int Keys = 500;
+    std::atomic<int> Mismatches( 0 );
+
+    std::vector<std::thread> Threads;
+    for( int Thread = 0; Thread != 8; ++Thread )
+    {
+        Threads.emplace_back( [&, Thread]()
+        {
+            for( int Round = 0; Round != 4 * Keys; ++Round )
+            {
+                auto Key = path_t( "/k" ) / std::to_string( ( Round * 7 + Thread ) % Keys );
+                auto Value = Map.find( Key );
+                if( !Value )
+                {
+                    Value = &Map.insert( Key, Key / "v" );
+                }
+                if( *Value != Key / "v" )
+                {
+                    ++Mismatches;
+                }
+            }
+        } );
+    }
+    for( auto& Thread: Threads )
+    {
+        Thread.join();
+    }
+
+    BOOST_CHECK( Mismatches.load() == 0 );
+    BOOST_CHECK( Map.size() == Keys );
+}
+
+
+//! \brief  A check for the relative scenarios that compares `relative` using
+//!         a shared concurrent_path_map against plain `relative`.
+//!
+//!         Each time a pair is checked the expected result is computed
+//!         serially, then several threads resolve every pair seen so far in
+//!         the scenario through the same map so that lookups and inserts
+//!         of the same directories race with each other.
+class concurrent_relative_check
+{
+public:
+
+    static const int threads = 8;
+
+    void operator()( const path_t& Path, const path_t& Start )
+    {
+        boost::system::error_code ec;
+        auto Expected = boost::filesystem::relative( Path, Start, ec );
+        Pairs_.push_back( pair{ Path, Start, Expected, ec } );
+
+        std::atomic<int> Mismatches( 0 );
+        boost::filesystem::cached_canonical_operations<> Ops( Map_ );
+
+        std::vector<std::thread> Workers;
+        for( int Thread = 0; Thread != threads; ++Thread )
+        {
+            Workers.emplace_back( [this, &Ops, &Mismatches, Thread]()
+            {
+                for( std::size_t i = 0; i != Pairs_.size(); ++i )
+                {
+                    // Start each thread at a different pair to vary the races
+                    const auto& Pair = Pairs_[ ( i + Thread * 3 ) % Pairs_.size() ];
+                    boost::system::error_code ec;
+                    auto Result = boost::filesystem::relative( Pair.path, Pair.start, ec, Ops );
+                    if( Result != Pair.expected || ec != Pair.ec )
+                    {
+                        ++Mismatches;
+                    }
+                }
+            } );
+        }
+        for( auto& Worker: Workers )
+        {
+            Worker.join();
+        }
+
+        BOOST_CHECK_MESSAGE( Mismatches.load() == 0, "From " << Start << " to " << Path );
+    }
+
+    std::size_t cached() const
+    {
+        return Map_.size();
+    }
+
+private:
+
+    struct pair
+    {
+        path_t                      path;
+        path_t                      start;
+        path_t                      expected;
+        boost::system::error_code   ec;
+    };
+
+    xstd::filesystem::concurrent_path_map   Map_;
+    std::vector<pair>                       Pairs_;
+};
+
+
+template<class Scenario>
+void run_concurrently( Scenario Run )
+{
+    // A fresh map per scenario as each one recreates the same directories
+    auto Check = std::make_shared<concurrent_relative_check>();
+    Run( [Check]( const path_t& Path, const path_t& Start )
+    {
+        ( *Check )( Path, Start );
+    } );
+    BOOST_CHECK( Check->cached() != 0 );
+}
+
+
+void test_concurrent_real_relative_paths()
+{
+    run_concurrently( test_real_relative_paths );
+}
+
+
+void test_concurrent_multiple_nested_symlinks()
+{
+    run_concurrently( multiple_nested_symlinks );
+}
+
+
+void test_concurrent_real_and_imaginary_relative_paths()
+{
+    run_concurrently( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_concurrent_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_concurrently( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_CONCURRENT_PATH_MAP_TESTS_HPP_INCLUDED
@@ -0,0 +1,266 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_DIRFD_RESOLVER_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_DIRFD_RESOLVER_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/dirfd_resolver.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Check that the resolver agrees with `exists` and `canonical` about `p`
+void check_dirfd_resolution( const xstd::filesystem::dirfd_resolver& Resolver, const path_t& p )
+{
+    boost::system::error_code ec;
+    auto Result = Resolver.resolve( p, ec );
+
+    boost::system::error_code expected_ec;
+    auto Expected = canonical( p, expected_ec );
+
+    BOOST_TEST_MESSAGE( "Path            = " << p );
+    BOOST_TEST_MESSAGE( "Resolved        = " << Result.real_path );
+    BOOST_TEST_MESSAGE( "Canonical       = " << Expected );
+
+    if( !expected_ec )
+    {
+        BOOST_CHECK_MESSAGE( Result.found && !ec, p );
+        BOOST_CHECK_MESSAGE( Result.real_path == Expected.native(), p );
+        BOOST_CHECK( S_ISDIR( Result.mode ) == is_directory( p ) );
+    }
+    else if( expected_ec == boost::system::errc::no_such_file_or_directory
+             || expected_ec == boost::system::errc::not_a_directory )
+    {
+        BOOST_CHECK_MESSAGE( !Result.found && !ec, p );
+    }
+    else
+    {
+        BOOST_CHECK_MESSAGE( !Result.found && ec == expected_ec, p << ": " << ec.message() << " != " << expected_ec.message() );
+    }
+}
+
+
+void test_dirfd_resolver_paths()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+    auto a_level_3 = a_level_2 / "a_level_3";
+
+    create_directories( a_level_3 );
+
+    auto file = a_level_2 / "file";
+    boost::filesystem::ofstream( file ) << "file";
+
+    auto b_level_1 = test_base / "b_level_1";
+
+    create_directories( b_level_1 );
+
+    // Relative, absolute, chained and dangling symlinks, one to a file and
+    // a pair that loop
+    create_directory_symlink( "../a_level_1/a_level_2", b_level_1 / "to_a_level_2" );
+    create_directory_symlink( a_level_3, b_level_1 / "to_a_level_3" );
+    create_directory_symlink( "to_a_level_2/a_level_3/..", b_level_1 / "chain" );
+    create_symlink( "../a_level_1/a_level_2/file", b_level_1 / "to_file" );
+    create_symlink( "missing", b_level_1 / "dangling" );
+    create_symlink( "loop_b", b_level_1 / "loop_a" );
+    create_symlink( "loop_a", b_level_1 / "loop_b" );
+
+    std::vector<path_t> Paths =
+    {
+        "/",
+        test_base,
+        a_level_3,
+        a_level_3 / "..",
+        a_level_3 / ".." / ".." / "..",
+        a_level_2 / ".",
+        path_t( a_level_2.native() + "/" ),
+        path_t( a_level_2.native() + "//a_level_3///" ),
+        file,
+        file / "x",
+        file / "..",
+        a_level_3 / "missing",
+        a_level_3 / "missing" / "..",
+        b_level_1 / "to_a_level_2",
+        b_level_1 / "to_a_level_2" / "..",
+        b_level_1 / "to_a_level_2" / "a_level_3",
+        b_level_1 / "to_a_level_3" / ".." / "file",
+        b_level_1 / "chain",
+        b_level_1 / "chain" / "a_level_3",
+        b_level_1 / "to_file",
+        b_level_1 / "to_file" / "..",
+        b_level_1 / "dangling",
+        b_level_1 / "loop_a",
+        b_level_1 / "loop_a" / "x",
+    };
+
+    xstd::filesystem::dirfd_resolver Resolver;
+
+    for( const auto& p: Paths )
+    {
+        check_dirfd_resolution( Resolver, p );
+    }
+
+    boost::system::error_code ec;
+    BOOST_CHECK( Resolver.anchor( a_level_2, ec ) );
+    BOOST_CHECK( Resolver.anchor( b_level_1 / "to_a_level_3", ec ) );
+    BOOST_CHECK( !Resolver.anchor( file, ec ) && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Resolver.anchors() == 2 );
+
+    // The same answers when starting from anchors part way down
+    for( const auto& p: Paths )
+    {
+        check_dirfd_resolution( Resolver, p );
+    }
+
+    // A target spelled with a leading "//name" is resolved by the kernel as
+    // "/name", which Boost's canonical spells differently, so compare with
+    // what the kernel finds instead
+    create_directory_symlink( "/" + a_level_2.native(), b_level_1 / "to_a_level_2_root_name" );
+    for( const auto& p: { b_level_1 / "to_a_level_2_root_name", b_level_1 / "to_a_level_2_root_name" / "a_level_3", b_level_1 / "to_a_level_2_root_name" / "file" } )
+    {
+        auto Result = Resolver.resolve( p, ec );
+        BOOST_CHECK_MESSAGE( Result.found && !ec, p );
+        BOOST_CHECK_MESSAGE( Result.found && equivalent( Result.real_path, p ), p << " resolved to " << Result.real_path );
+        BOOST_CHECK( Result.real_path.compare( 0, 2, "//" ) != 0 );
+    }
+    BOOST_CHECK( exists( b_level_1 / "to_a_level_2_root_name" / "a_level_3" ) );
+    BOOST_CHECK( boost::filesystem::dirfd_operations( Resolver ).exists( b_level_1 / "to_a_level_2_root_name" / "a_level_3", ec ) );
+
+    Resolver.clear();
+    BOOST_CHECK( Resolver.anchors() == 0 );
+
+    auto Result = Resolver.resolve( "relative/path", ec );
+    BOOST_CHECK( !Result.found && ec == boost::system::errc::invalid_argument );
+
+    remove_all( test_base );
+}
+
+
+void test_dirfd_retargeted_symlink()
+{
+    path_t tree = boost::filesystem::current_path() / "test_level_0";
+
+    create_directories( tree / "A" / "x" );
+    create_directories( tree / "B" / "x" );
+    create_directory_symlink( "A", tree / "link" );
+
+    xstd::filesystem::dirfd_resolver Resolver;
+    boost::filesystem::dirfd_operations Ops( Resolver );
+    boost::system::error_code ec;
+
+    BOOST_CHECK( Resolver.anchor( tree / "link", ec ) );
+    BOOST_CHECK( Resolver.anchor( tree / "A", ec ) );
+    BOOST_CHECK( Resolver.anchors() == 1 );
+    BOOST_CHECK( boost::filesystem::relative( tree / "link", tree, ec, Ops ) == "./A" );
+    check_dirfd_resolution( Resolver, tree / "link" / "x" );
+
+    // The anchor is found by its spelling but no longer stands for it
+    remove( tree / "link" );
+    create_directory_symlink( "B", tree / "link" );
+
+    BOOST_CHECK( boost::filesystem::relative( tree / "link", tree, ec ) == "./B" );
+    BOOST_CHECK( boost::filesystem::relative( tree / "link", tree, ec, Ops ) == "./B" );
+    BOOST_CHECK( boost::filesystem::relative( tree / "link" / "x", tree / "A", ec, Ops ) == "../B/x" );
+    check_dirfd_resolution( Resolver, tree / "link" / "x" );
+    check_dirfd_resolution( Resolver, tree / "A" / "x" );
+    BOOST_CHECK( !Resolver.anchored( tree / "link" ) );
+
+    // A directory replaced at an anchored real path replaces the anchor
+    remove_all( tree / "A" );
+    create_directories( tree / "A" / "y" );
+
+    check_dirfd_resolution( Resolver, tree / "A" / "y" );
+    check_dirfd_resolution( Resolver, tree / "A" / "x" );
+    BOOST_CHECK( Resolver.anchor( tree / "A", ec ) );
+    BOOST_CHECK( Resolver.anchors() == 1 );
+    check_dirfd_resolution( Resolver, tree / "A" / "y" );
+
+    remove_all( tree );
+}
+
+
+//! One resolver for every scenario, which each recreate the same directories
+//! and so leave its anchors standing for ones that have been removed
+xstd::filesystem::dirfd_resolver& long_lived_dirfd_resolver()
+{
+    static xstd::filesystem::dirfd_resolver Resolver;
+    return Resolver;
+}
+
+
+template<class Scenario>
+void run_with_dirfd_operations( Scenario Run )
+{
+    Run( []( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        auto& Resolver = long_lived_dirfd_resolver();
+        boost::filesystem::dirfd_operations Ops( Resolver );
+
+        boost::system::error_code anchor_ec;
+        if( Start.has_root_directory() && !Start.has_root_name() )
+        {
+            Resolver.anchor( Start, anchor_ec );
+        }
+
+        boost::system::error_code ec;
+        auto Expected = boost::filesystem::relative( Path, Start, ec );
+
+        boost::system::error_code dirfd_ec;
+        auto Relative = boost::filesystem::relative( Path, Start, dirfd_ec, Ops );
+
+        BOOST_CHECK_MESSAGE( Relative == Expected, "From " << Start << " to " << Path << ": " << Relative << " != " << Expected );
+        BOOST_CHECK( dirfd_ec == ec );
+    } );
+}
+
+
+void test_dirfd_real_relative_paths()
+{
+    run_with_dirfd_operations( test_real_relative_paths );
+}
+
+
+void test_dirfd_multiple_nested_symlinks()
+{
+    run_with_dirfd_operations( multiple_nested_symlinks );
+}
+
+
+void test_dirfd_imaginary_relative_paths()
+{
+    run_with_dirfd_operations( test_imaginary_relative_paths );
+}
+
+
+void test_dirfd_real_and_imaginary_relative_paths()
+{
+    run_with_dirfd_operations( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_dirfd_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_with_dirfd_operations( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_DIRFD_RESOLVER_TESTS_HPP_INCLUDED
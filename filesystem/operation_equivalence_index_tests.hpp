@@ -0,0 +1,181 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_EQUIVALENCE_INDEX_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_EQUIVALENCE_INDEX_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/equivalence_index.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <fstream>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_equivalence_index_queries()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a = test_base / "a";
+    auto b = test_base / "b";
+    auto file = a / "file";
+    auto hard_link = b / "hard_link";
+    auto link = test_base / "link";
+    auto missing = test_base / "missing";
+
+    remove_all( test_base );
+    create_directories( a );
+    create_directories( b );
+    std::ofstream( file.c_str() ) << "file";
+    create_hard_link( file, hard_link );
+    create_directory_symlink( a, link );
+
+    xstd::filesystem::equivalence_index Index;
+    boost::system::error_code ec;
+
+    BOOST_CHECK( Index.equivalent( file, hard_link ) );
+    BOOST_CHECK( Index.equivalent( link / "file", hard_link ) );
+    BOOST_CHECK( Index.equivalent( a / ".." / "a", link ) );
+    BOOST_CHECK( !Index.equivalent( a, b ) );
+    BOOST_CHECK( Index.lookups() == 7 );
+
+    // Answered from the index
+    BOOST_CHECK( Index.equivalent( hard_link, file ) );
+    BOOST_CHECK( Index.equivalent( link, a / ".." / "a" ) );
+    BOOST_CHECK( Index.lookups() == 7 );
+
+    // As `boost::filesystem::equivalent` for paths that do not resolve
+    BOOST_CHECK( !Index.equivalent( missing, a, ec ) && !ec );
+    BOOST_CHECK( !Index.equivalent( a, missing, ec ) && !ec );
+    BOOST_CHECK( !Index.equivalent( missing, missing / "x", ec ) && ec );
+    BOOST_CHECK_THROW( Index.equivalent( missing, missing ), boost::filesystem::filesystem_error );
+
+    // Results are kept until cleared
+    remove( link );
+    create_directory_symlink( b, link );
+    BOOST_CHECK( Index.equivalent( link, a ) );
+    Index.clear();
+    BOOST_CHECK( Index.equivalent( link, b ) );
+
+    remove_all( test_base );
+}
+
+
+void test_equivalence_index_classes()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a = test_base / "a";
+    auto b = test_base / "b";
+    auto file = a / "file";
+
+    remove_all( test_base );
+    create_directories( a );
+    create_directories( b );
+    std::ofstream( file.c_str() ) << "file";
+    create_hard_link( file, b / "hard_link" );
+    create_directory_symlink( a, test_base / "link_to_a" );
+    create_directory_symlink( b, test_base / "link_to_b" );
+
+    std::vector<path_t> Paths =
+    {
+        a,                                      // 0
+        test_base / "missing",                  // 1
+        b / "hard_link",                        // 2
+        test_base / "link_to_b",                // 3
+        test_base / "link_to_a" / "file",       // 4
+        a / ".." / "link_to_a",                 // 5
+        b / ".",                                // 6
+        file,                                   // 7
+        a                                       // 8
+    };
+
+    xstd::filesystem::equivalence_index Index;
+    auto Classes = Index.classes( Paths, 4 );
+
+    std::vector<std::vector<std::size_t>> Expected = { { 0, 5, 8 }, { 2, 4, 7 }, { 3, 6 } };
+    BOOST_CHECK( Classes == Expected );
+
+    // Each distinct spelling was looked up once
+    BOOST_CHECK( Index.lookups() == 8 );
+    BOOST_CHECK( Index.size() == 8 );
+
+    for( const auto& Class : Classes )
+    {
+        for( auto Member : Class )
+        {
+            BOOST_CHECK( equivalent( Paths[Class.front()], Paths[Member] ) );
+        }
+    }
+
+    remove_all( test_base );
+}
+
+
+//! Checks `relative` against `equivalent` as `test_relative` does, but looks
+//! the paths up in `index`
+void equivalence_index_relative_check( xstd::filesystem::equivalence_index& Index, const path_t& Path, const path_t& Start )
+{
+    test_relative( Path, Start );
+
+    boost::system::error_code ec;
+    auto Relative = boost::filesystem::relative( Path, Start, ec );
+    auto LexicallyRelative = lexically_relative( Path, Start );
+
+    std::vector<path_t> Paths = { Start / Relative, Start / LexicallyRelative, Path };
+    Index.add( Paths );
+
+    boost::system::error_code IndexEc;
+    boost::system::error_code BoostEc;
+    for( const auto& Candidate : { Start / Relative, Start / LexicallyRelative } )
+    {
+        BOOST_CHECK( Index.equivalent( Candidate, Path, IndexEc ) == equivalent( Candidate, Path, BoostEc ) );
+        BOOST_CHECK( !IndexEc == !BoostEc );
+    }
+}
+
+
+//! Runs `scenario` with one index shared by all of its checks. The scenarios
+//! only add to their trees once checking has begun, under names not looked
+//! up before, so what the index recorded stays true throughout.
+template<class Scenario>
+void run_with_equivalence_index( Scenario Run )
+{
+    xstd::filesystem::equivalence_index Index;
+    std::size_t Paths = 0;
+
+    Run( [&]( const path_t& Path, const path_t& Start )
+    {
+        equivalence_index_relative_check( Index, Path, Start );
+        Paths += 3;
+    } );
+
+    // Paths spelled the same by more than one check were looked up once
+    BOOST_CHECK( Index.lookups() == Index.size() );
+    BOOST_CHECK( Index.lookups() < Paths );
+}
+
+
+void test_equivalence_index_real_relative_paths()
+{
+    run_with_equivalence_index( test_real_relative_paths );
+}
+
+
+void test_equivalence_index_real_and_imaginary_relative_paths()
+{
+    run_with_equivalence_index( test_real_and_imaginary_relative_paths );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_EQUIVALENCE_INDEX_TESTS_HPP_INCLUDED
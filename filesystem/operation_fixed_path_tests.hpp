@@ -0,0 +1,129 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_FIXED_PATH_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_FIXED_PATH_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/fixed_path.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstring>
+#include <string>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+using xstd::filesystem::make_fixed_path;
+
+
+template<class FixedPath>
+void check_same( const FixedPath& Fixed, const path_t& Expected )
+{
+    BOOST_TEST_MESSAGE( "fixed = [" << Fixed.c_str() << "], path = [" << Expected.string() << "]" );
+    BOOST_CHECK( Fixed.str() == Expected.string() );
+}
+
+
+void test_fixed_normalize()
+{
+    constexpr auto Base = make_fixed_path( "/a/b/c" );
+
+    static_assert( normalize( Base ) == "/a/b/c", "" );
+    static_assert( normalize( make_fixed_path( "/a/./b/../c" ) ) == "/a/c", "" );
+    static_assert( normalize( make_fixed_path( "/a//b///c/" ) ) == "/a/b/c", "" );
+    static_assert( normalize( make_fixed_path( "a/../../b" ) ) == "../b", "" );
+    static_assert( normalize( make_fixed_path( "./." ) ) == "", "" );
+    static_assert( normalize( make_fixed_path( "//root_x/a/.." ) ) == "//root_x/", "" );
+    static_assert( normalize( make_fixed_path( "//" ) ) == "//", "" );
+    static_assert( normalize( make_fixed_path( "/test_level_0/a_level_1/a_level_2/../a_level_4" ) ) == "/test_level_0/a_level_1/a_level_4", "" );
+
+    const char* Paths[] = {
+        "/a/b/c", "/a/./b/../c", "/a//b///c/", "a/../../b", "./.", "..", "/..", "/a/../..",
+        "//root_x/a/..", "//root_x/imaginary_root_1/../x", "a/b/./../../..", "", "//", "///a//"
+    };
+    for( const auto* Path: Paths )
+    {
+        auto Fixed = xstd::filesystem::fixed_path<64>( Path, std::strlen( Path ) );
+        check_same( normalize( Fixed ), normalize( path_t( Path ) ) );
+    }
+}
+
+
+void test_fixed_lexically_relative()
+{
+//        path         start    =    rel_path
+//       ------       -------       ----------
+//
+//  1.   /a/d         /a/b/c          ../../d
+//  2.   /a/b/c       /a/d            ../b/c
+//  3.   //c_drive/y  //c_drive/x     ../y
+//  4.   //d_drive/y  //c_drive/x     (none)
+
+    static_assert( lexically_relative( make_fixed_path( "/a/d" ), make_fixed_path( "/a/b/c" ) ) == "../../d", "" );
+    static_assert( lexically_relative( make_fixed_path( "/a/b/c" ), make_fixed_path( "/a/d" ) ) == "../b/c", "" );
+    static_assert( lexically_relative( make_fixed_path( "//C_drive/y" ), make_fixed_path( "//C_drive/x" ) ) == "../y", "" );
+    static_assert( lexically_relative( make_fixed_path( "//D_drive/y" ), make_fixed_path( "//C_drive/x" ) ).empty(), "" );
+
+    // A lone "//" is a root-name, as Boost iterates it, not a root-directory
+    static_assert( lexically_relative( make_fixed_path( "//" ), make_fixed_path( "//" ) ) == ".", "" );
+    static_assert( lexically_relative( make_fixed_path( "/a" ), make_fixed_path( "//" ) ).empty(), "" );
+    static_assert( lexically_relative( make_fixed_path( "//" ), make_fixed_path( "/" ) ).empty(), "" );
+
+    static_assert( lexically_relative( make_fixed_path( "/imaginary_root/test_level_0" ), make_fixed_path( "/imaginary_root/test_level_0" ) ) == ".", "" );
+    static_assert( lexically_relative( make_fixed_path( "/imaginary_root/test_level_0/a_level_1/a_level_2" ), make_fixed_path( "/imaginary_root/test_level_0" ) ) == "./a_level_1/a_level_2", "" );
+    static_assert( lexically_relative( make_fixed_path( "/imaginary_root/test_level_0" ), make_fixed_path( "/imaginary_root/test_level_0/a_level_1/a_level_2" ) ) == "../..", "" );
+    static_assert( lexically_relative( make_fixed_path( "//root_x/imaginary_root_1/a_level_1" ), make_fixed_path( "//root_y/imaginary_root_2" ) ).empty(), "" );
+
+    const char* Base = "/imaginary_root/test_level_0";
+    const char* Levels[] = {
+        "", "/a_level_1", "/a_level_1/a_level_2", "/a_level_1/a_level_2/a_level_3",
+        "/b_level_1", "/b_level_1/b_level_2", "/b_level_1/b_level_2/b_level_3"
+    };
+    for( const auto* PathLevel: Levels )
+    {
+        for( const auto* StartLevel: Levels )
+        {
+            auto Path  = std::string( Base ) + PathLevel;
+            auto Start = std::string( Base ) + StartLevel;
+
+            auto FixedPath  = xstd::filesystem::fixed_path<64>( Path.c_str(), Path.size() );
+            auto FixedStart = xstd::filesystem::fixed_path<64>( Start.c_str(), Start.size() );
+
+            check_same( lexically_relative( FixedPath, FixedStart ), lexically_relative( path_t( Path ), path_t( Start ) ) );
+        }
+    }
+}
+
+
+void test_fixed_common_prefix()
+{
+    static_assert( common_prefix( make_fixed_path( "/a/b/c/d/e/f/g/h" ), make_fixed_path( "/a/b/c/d/j/k" ) ) == "/a/b/c/d", "" );
+    static_assert( common_prefix( make_fixed_path( "/a/b/c/d/e/f/g/h" ), make_fixed_path( "/a/b/c/d/j/k" ), make_fixed_path( "/a/b/c/p/q/r" ) ) == "/a/b/c", "" );
+    static_assert( common_prefix( make_fixed_path( "//root_x/a" ), make_fixed_path( "//root_y/a" ) ).empty(), "" );
+    static_assert( common_prefix( make_fixed_path( "a/b" ), make_fixed_path( "" ) ).empty(), "" );
+    static_assert( common_prefix( make_fixed_path( "//" ), make_fixed_path( "/a" ) ).empty(), "" );
+
+    path_t Common = "/a/b/c";
+
+    path_t Path1 = Common / "d/e/f/g/h";
+    path_t Path2 = Common / "d/j/k";
+    path_t Path3 = Common / "p/q/r";
+
+    auto Fixed1 = xstd::filesystem::fixed_path<64>( Path1.c_str(), Path1.size() );
+    auto Fixed2 = xstd::filesystem::fixed_path<64>( Path2.c_str(), Path2.size() );
+    auto Fixed3 = xstd::filesystem::fixed_path<64>( Path3.c_str(), Path3.size() );
+
+    check_same( common_prefix( Fixed1, Fixed2 ), common_prefix( Path1, Path2 ) );
+    check_same( common_prefix( Fixed1, Fixed2, Fixed3 ), boost::filesystem::common_prefix( { Path1, Path2, Path3 } ) );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_FIXED_PATH_TESTS_HPP_INCLUDED
@@ -0,0 +1,158 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_FRONT_CODING_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_FRONT_CODING_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/front_coding.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+std::vector<path_t> front_coding_paths()
+{
+    std::vector<path_t> Paths = {
+        "", "/", "//root_x", "//root_x/", "//root_x/a", "a", "a/", "a/b/", "a/b//", "a/b/c",
+        "a//b/c", "/a/./b/../c", "../x", "/usr//lib/", "/usr/lib"
+    };
+    path_t Base = "/opt/install/prefix";
+    for( int i = 0; i != 40; ++i )
+    {
+        for( int j = 0; j != 25; ++j )
+        {
+            Paths.push_back( Base / ( "package_" + std::to_string( i ) ) / "share/doc" / ( "file_" + std::to_string( j ) + ".txt" ) );
+        }
+    }
+    std::sort( Paths.begin(), Paths.end() );
+    return Paths;
+}
+
+
+std::string encode( const std::vector<path_t>& Paths, std::size_t RestartInterval )
+{
+    std::ostringstream Out;
+    boost::filesystem::front_coded_encoder Encoder( Out, RestartInterval );
+    for( const auto& Path: Paths )
+    {
+        Encoder.add( Path );
+    }
+    Encoder.finish();
+    return Out.str();
+}
+
+
+void test_front_coding_round_trip()
+{
+    auto Paths = front_coding_paths();
+
+    for( std::size_t RestartInterval: { 1, 3, 16, 1000000 } )
+    {
+        auto Encoded = encode( Paths, RestartInterval );
+        boost::filesystem::front_coded_decoder Decoder( Encoded );
+
+        BOOST_REQUIRE( Decoder.size() == Paths.size() );
+
+        std::vector<path_t> Decoded;
+        Decoder.for_each( [&Decoded]( boost::string_ref Path )
+        {
+            Decoded.emplace_back( Path.to_string() );
+        } );
+
+        BOOST_REQUIRE( Decoded.size() == Paths.size() );
+        for( std::size_t i = 0; i != Paths.size(); ++i )
+        {
+            BOOST_CHECK( Decoded[i].native() == Paths[i].native() );
+        }
+    }
+}
+
+
+void test_front_coding_random_access()
+{
+    auto Paths = front_coding_paths();
+    auto Encoded = encode( Paths, 16 );
+
+    boost::filesystem::front_coded_decoder Decoder( Encoded );
+
+    for( std::size_t i = Paths.size(); i-- > 0; )
+    {
+        BOOST_CHECK( Decoder.at( i ).native() == Paths[i].native() );
+    }
+
+    auto Cursor = Decoder.seek( 100 );
+    for( std::size_t i = 100; i != Paths.size(); ++i )
+    {
+        BOOST_REQUIRE( Cursor.next() );
+        BOOST_CHECK( Cursor.index() == i );
+        BOOST_CHECK( Cursor.path() == boost::string_ref( Paths[i].native() ) );
+    }
+    BOOST_CHECK( !Cursor.next() );
+
+    BOOST_CHECK_THROW( Decoder.at( Paths.size() ), std::out_of_range );
+
+    // Seeking to or past the end of a list whose last restart block is
+    // short gives a cursor at the end
+    std::vector<path_t> Short( Paths.begin(), Paths.begin() + 20 );
+    auto ShortEncoded = encode( Short, 16 );
+    boost::filesystem::front_coded_decoder ShortDecoder( ShortEncoded );
+    for( std::size_t Index: { 20, 25 } )
+    {
+        auto End = ShortDecoder.seek( Index );
+        BOOST_CHECK( !End.next() );
+        BOOST_CHECK( !End.next() );
+    }
+    auto Last = ShortDecoder.seek( 19 );
+    BOOST_REQUIRE( Last.next() );
+    BOOST_CHECK( Last.path() == boost::string_ref( Short[19].native() ) );
+    BOOST_CHECK( !Last.next() );
+}
+
+
+void test_front_coding_compression()
+{
+    auto Paths = front_coding_paths();
+    auto Encoded = encode( Paths, 16 );
+
+    std::size_t Plain = 0;
+    for( const auto& Path: Paths )
+    {
+        Plain += Path.native().size() + 1;
+    }
+    BOOST_TEST_MESSAGE( "plain = " << Plain << ", encoded = " << Encoded.size() );
+    BOOST_CHECK( Encoded.size() * 2 < Plain );
+}
+
+
+void test_front_coding_empty_and_corrupt()
+{
+    auto Encoded = encode( {}, 16 );
+    boost::filesystem::front_coded_decoder Decoder( Encoded );
+
+    BOOST_CHECK( Decoder.size() == 0 );
+    BOOST_CHECK( !Decoder.begin().next() );
+
+    BOOST_CHECK_THROW( boost::filesystem::front_coded_decoder( Encoded.data(), 3 ), std::runtime_error );
+
+    auto Truncated = encode( front_coding_paths(), 16 );
+    Truncated.erase( 0, 10 );
+    BOOST_CHECK_THROW( boost::filesystem::front_coded_decoder( Truncated ).for_each( []( boost::string_ref ){} ), std::runtime_error );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_FRONT_CODING_TESTS_HPP_INCLUDED
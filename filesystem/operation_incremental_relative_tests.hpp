@@ -0,0 +1,180 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_INCREMENTAL_RELATIVE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_INCREMENTAL_RELATIVE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/front_coding.hpp"
+#include "filesystem/incremental_relative.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Paths spelled in every way the element scanner treats specially: roots,
+//! root-names, repeated and trailing separators, `.` and `..`
+std::vector<std::string> awkward_paths()
+{
+    return
+    {
+        "", "/", "//", "///", "//net", "//net/a", "//net/a/b", "/a", "/a/", "/a//", "/a/b",
+        "/a//b", "/a/b/", "/a/b/.", "/a/b/..", "/a/b/c", "/a/b/c/", "/a/bc", "/a/bc/d",
+        "/a/./b", "/a/../b", "/ab", "/b", "a", "a/", "a/b", "a//b", "a/b/", "a/b/c", ".",
+        "..", "./a", "../a", "../../a/b"
+    };
+}
+
+
+//! Return `count` random paths of up to `depth` elements drawn from a small
+//! set of names, so that many share prefixes
+std::vector<std::string> random_paths( std::size_t Count, std::size_t Depth, bool Absolute, unsigned Seed )
+{
+    const char* Names[] = { "a", "b", "bc", "c", ".", "..", "include", "lib", "x" };
+    std::mt19937 Random( Seed );
+    std::vector<std::string> Paths;
+    for( std::size_t Path = 0; Path != Count; ++Path )
+    {
+        std::string Text = Absolute ? "/" : "";
+        auto Elements = 1 + Random() % Depth;
+        for( std::size_t Element = 0; Element != Elements; ++Element )
+        {
+            if( Element )
+            {
+                Text += Random() % 8 ? "/" : "//";
+            }
+            Text += Names[ Random() % 9 ];
+        }
+        if( Random() % 8 == 0 )
+        {
+            Text += "/";
+        }
+        Paths.push_back( Text );
+    }
+    return Paths;
+}
+
+
+void check_incremental_relative( const std::vector<std::string>& Paths, const std::vector<std::string>& Starts )
+{
+    for( const auto& Start : Starts )
+    {
+        boost::filesystem::incremental_lexically_relative Relativise( Start );
+        for( const auto& Path : Paths )
+        {
+            auto Expected = lexically_relative( path_t( Path ), path_t( Start ) );
+            auto Result = Relativise.relativise( Path );
+            BOOST_CHECK_MESSAGE( Result == Expected.native(), "lexically_relative( " << Path << ", " << Start << " ) = " << Expected << ", not " << Result );
+        }
+    }
+}
+
+
+void test_incremental_relative_awkward_paths()
+{
+    auto Paths = awkward_paths();
+
+    // Every pair in every order against every start
+    std::vector<std::string> Pairs;
+    for( const auto& First : Paths )
+    {
+        for( const auto& Second : Paths )
+        {
+            Pairs.push_back( First );
+            Pairs.push_back( Second );
+        }
+    }
+    check_incremental_relative( Pairs, Paths );
+}
+
+
+void test_incremental_relative_random_paths()
+{
+    for( bool Absolute : { true, false } )
+    {
+        auto Paths = random_paths( 2000, 8, Absolute, Absolute ? 1 : 2 );
+        auto Starts = random_paths( 20, 6, Absolute, Absolute ? 3 : 4 );
+        Starts.push_back( Absolute ? "/" : "." );
+
+        check_incremental_relative( Paths, Starts );
+
+        std::sort( Paths.begin(), Paths.end() );
+        check_incremental_relative( Paths, Starts );
+    }
+}
+
+
+void test_incremental_relative_front_coded_paths()
+{
+    auto Paths = random_paths( 2000, 8, true, 5 );
+    std::sort( Paths.begin(), Paths.end() );
+
+    std::ostringstream Out;
+    boost::filesystem::front_coded_encoder Encoder( Out, 64 );
+    for( const auto& Path : Paths )
+    {
+        Encoder.add( boost::string_ref( Path ) );
+    }
+    Encoder.finish();
+    auto Encoded = Out.str();
+    boost::filesystem::front_coded_decoder Decoder( Encoded );
+
+    for( const auto& Start : random_paths( 10, 6, true, 6 ) )
+    {
+        boost::filesystem::incremental_lexically_relative Relativise( Start );
+        auto Cursor = Decoder.begin();
+        while( Cursor.next() )
+        {
+            auto Expected = lexically_relative( path_t( Cursor.path().to_string() ), path_t( Start ) );
+            BOOST_CHECK( Relativise.relativise( Cursor.path(), Cursor.shared() ) == Expected.native() );
+        }
+    }
+}
+
+
+void test_incremental_relative_compares_only_changes()
+{
+    // A sorted listing of a deep tree below `start`
+    std::string Start = "/home/user/src/project/build/output";
+    std::vector<std::string> Paths;
+    for( int Directory = 0; Directory != 10; ++Directory )
+    {
+        for( int File = 0; File != 100; ++File )
+        {
+            Paths.push_back( Start + "/obj/module_" + std::to_string( Directory ) + "/src/file_" + std::to_string( File ) + ".o" );
+        }
+    }
+    std::sort( Paths.begin(), Paths.end() );
+
+    boost::filesystem::incremental_lexically_relative Relativise( Start );
+    for( const auto& Path : Paths )
+    {
+        BOOST_CHECK( path_t( Relativise.relativise( Path ).to_string() ) == lexically_relative( path_t( Path ), path_t( Start ) ) );
+    }
+
+    // Only the first path is compared with each element of `start`
+    BOOST_CHECK( Relativise.compared() == 7 );
+
+    BOOST_CHECK( Relativise( "/home/user/src/other" ) == "../../../other" );
+    BOOST_CHECK( Relativise( "home/user" ).empty() );
+    Relativise.reset();
+    BOOST_CHECK( Relativise( Start ) == "." );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_INCREMENTAL_RELATIVE_TESTS_HPP_INCLUDED
@@ -0,0 +1,133 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_LEXICAL_CACHE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_LEXICAL_CACHE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/lexical_cache.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+std::vector<path_t> lexical_cache_paths()
+{
+    std::vector<path_t> Paths;
+    for( int i = 0; i != 20; ++i )
+    {
+        Paths.push_back( path_t( "/a/b/./c" ) / ( "d_" + std::to_string( i ) ) / "../e" );
+        Paths.push_back( path_t( "x/../../y" ) / ( "z_" + std::to_string( i ) ) );
+    }
+    return Paths;
+}
+
+
+void test_lexical_cache_results()
+{
+    xstd::filesystem::lexical_cache Cache( 1024, 4 );
+
+    auto Paths = lexical_cache_paths();
+    path_t Start = "/a/b/c/d_3";
+
+    for( int Round = 0; Round != 3; ++Round )
+    {
+        for( const auto& Path: Paths )
+        {
+            BOOST_CHECK( normalize( Path, Cache ).native() == normalize( Path ).native() );
+            BOOST_CHECK( lexically_relative( Path, Start, Cache ).native() == lexically_relative( Path, Start ).native() );
+            BOOST_CHECK( lexically_relative( Start, Path, Cache ).native() == lexically_relative( Start, Path ).native() );
+        }
+    }
+
+    auto Normalized = Cache.normalize_statistics();
+    auto Relative   = Cache.relative_statistics();
+
+    BOOST_CHECK( Normalized.misses == Paths.size() );
+    BOOST_CHECK( Normalized.hits == 2 * Paths.size() );
+    BOOST_CHECK( Normalized.size == Paths.size() );
+
+    BOOST_CHECK( Relative.misses == 2 * Paths.size() );
+    BOOST_CHECK( Relative.hits == 4 * Paths.size() );
+}
+
+
+void test_lexical_cache_eviction()
+{
+    xstd::filesystem::sharded_lru_cache<std::string, int> Cache( 4, 1 );
+
+    for( int i = 0; i != 4; ++i )
+    {
+        Cache.insert( std::to_string( i ), i );
+    }
+
+    int Value = 0;
+    BOOST_CHECK( Cache.find( "0", Value ) && Value == 0 );
+
+    Cache.insert( "4", 4 );
+
+    BOOST_CHECK( !Cache.find( "1", Value ) );
+    BOOST_CHECK( Cache.find( "0", Value ) );
+    BOOST_CHECK( Cache.find( "4", Value ) && Value == 4 );
+    BOOST_CHECK( Cache.statistics().size == 4 );
+
+    Cache.clear();
+    BOOST_CHECK( Cache.statistics().size == 0 );
+}
+
+
+void test_lexical_cache_concurrent()
+{
+    xstd::filesystem::lexical_cache Cache( 64 );
+
+    auto Paths = lexical_cache_paths();
+    std::atomic<int> Mismatches( 0 );
+
+    std::vector<std::thread> Threads;
+    for( int Thread = 0; Thread != 8; ++Thread )
+    {
+        Threads.emplace_back( [&, Thread]()
+        {
+            for( int Round = 0; Round != 200; ++Round )
+            {
+                const auto& Path  = Paths[ ( Round + Thread ) % Paths.size() ];
+                const auto& Start = Paths[ ( Round * 7 + Thread ) % Paths.size() ];
+                if( Cache.normalize( Path ) != normalize( Path ) )
+                {
+                    ++Mismatches;
+                }
+                if( Cache.lexically_relative( Path, Start ) != lexically_relative( Path, Start ) )
+                {
+                    ++Mismatches;
+                }
+            }
+        } );
+    }
+    for( auto& Thread: Threads )
+    {
+        Thread.join();
+    }
+
+    BOOST_CHECK( Mismatches.load() == 0 );
+
+    auto Normalized = Cache.normalize_statistics();
+    BOOST_CHECK( Normalized.hits + Normalized.misses == 8 * 200 );
+    BOOST_CHECK( Normalized.size <= 64 );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_LEXICAL_CACHE_TESTS_HPP_INCLUDED
@@ -0,0 +1,121 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_MAPPED_MANIFEST_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_MAPPED_MANIFEST_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/mapped_manifest.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <string>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+std::vector<path_t> write_manifest( const path_t& Manifest, const path_t& Common, std::size_t Count )
+{
+    std::vector<path_t> Paths;
+    boost::filesystem::ofstream Out( Manifest );
+    for( std::size_t i = 0; i != Count; ++i )
+    {
+        auto Path = Common / ( "dir_" + std::to_string( i % 7 ) ) / ( "sub_" + std::to_string( i % 13 ) ) / ( "file_" + std::to_string( i ) );
+        Paths.push_back( Path );
+        Out << Path.string() << "\n";
+        if( i % 100 == 0 )
+        {
+            Out << "\n";
+        }
+    }
+    return Paths;
+}
+
+
+void test_manifest_lines()
+{
+    path_t Manifest = boost::filesystem::current_path() / "manifest_lines.txt";
+    auto Paths = write_manifest( Manifest, "/a/b/c", 2000 );
+
+    // A single page window forces lines to straddle window boundaries
+    boost::filesystem::mapped_manifest Mapped( Manifest, 1 );
+
+    std::vector<path_t> Lines;
+    Mapped.for_each_line( [&Lines]( boost::string_ref Line )
+    {
+        Lines.emplace_back( std::string( Line.begin(), Line.end() ) );
+    } );
+
+    BOOST_CHECK( Lines == Paths );
+
+    remove( Manifest );
+}
+
+
+void test_manifest_common_prefix()
+{
+    path_t Manifest = boost::filesystem::current_path() / "manifest_common_prefix.txt";
+    auto Paths = write_manifest( Manifest, "/a/b/c", 500 );
+
+    boost::filesystem::mapped_manifest Mapped( Manifest, 1 );
+
+    auto Prefix = common_prefix( Mapped );
+
+    BOOST_CHECK( Prefix == path_t( "/a/b/c" ) );
+    BOOST_CHECK( Prefix == common_prefix( Paths.begin(), Paths.end() ) );
+
+    std::vector<path_t> Trimmed;
+    auto Removed = remove_common_prefix( Mapped, [&Trimmed]( boost::string_ref, boost::string_ref Rest )
+    {
+        Trimmed.emplace_back( std::string( Rest.begin(), Rest.end() ) );
+    } );
+
+    auto Expected = Paths;
+    auto ExpectedPrefix = remove_common_prefix( Expected.begin(), Expected.end() );
+
+    BOOST_CHECK( Removed == ExpectedPrefix );
+    BOOST_CHECK( Trimmed == Expected );
+
+    remove( Manifest );
+}
+
+
+void test_manifest_lexically_relative()
+{
+    path_t Manifest = boost::filesystem::current_path() / "manifest_lexically_relative.txt";
+    auto Paths = write_manifest( Manifest, "/a/b/c", 500 );
+
+    boost::filesystem::mapped_manifest Mapped( Manifest );
+
+    std::vector<path_t> Starts = { "/a/b/c", "/a/b/c/dir_3", "/a/b/c/dir_3/sub_4", "/a/x/y", "/", "//root_x/a", "" };
+
+    for( const auto& Start: Starts )
+    {
+        std::vector<path_t> Relative;
+        lexically_relative( Mapped, Start, [&Relative]( boost::string_ref, boost::string_ref Rel )
+        {
+            Relative.emplace_back( std::string( Rel.begin(), Rel.end() ) );
+        } );
+
+        BOOST_REQUIRE( Relative.size() == Paths.size() );
+        for( std::size_t i = 0; i != Paths.size(); ++i )
+        {
+            BOOST_CHECK( Relative[i].string() == lexically_relative( Paths[i], Start ).string() );
+        }
+    }
+
+    remove( Manifest );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_MAPPED_MANIFEST_TESTS_HPP_INCLUDED
@@ -0,0 +1,350 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_MEMORY_FILESYSTEM_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_MEMORY_FILESYSTEM_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/memory_filesystem.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <fstream>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Builds the scenario trees in a memory_filesystem, below a base that does
+//! not exist on disk
+class memory_scenario_filesystem : public scenario_filesystem
+{
+public:
+
+    explicit memory_scenario_filesystem( xstd::filesystem::memory_filesystem& Filesystem )
+    : Filesystem_( Filesystem )
+    {
+        Filesystem_.create_directories( "/memory_root/work" );
+        boost::system::error_code ec;
+        Filesystem_.current_path( "/memory_root/work", ec );
+    }
+
+    path_t current_path() const override
+    {
+        return Filesystem_.current_path();
+    }
+
+    void create_directories( const path_t& p ) const override
+    {
+        Filesystem_.create_directories( p );
+    }
+
+    void create_directory_symlink( const path_t& To, const path_t& NewSymlink ) const override
+    {
+        Filesystem_.create_directory_symlink( To, NewSymlink );
+    }
+
+    void create_file( const path_t& p ) const override
+    {
+        Filesystem_.create_file( p );
+    }
+
+    void remove_all( const path_t& p ) const override
+    {
+        Filesystem_.remove_all( p );
+    }
+
+private:
+
+    xstd::filesystem::memory_filesystem& Filesystem_;
+};
+
+
+//! Builds the scenario trees both on disk and, at the same paths, in a
+//! memory_filesystem, so that the two can be compared
+class mirrored_scenario_filesystem : public scenario_filesystem
+{
+public:
+
+    explicit mirrored_scenario_filesystem( xstd::filesystem::memory_filesystem& Filesystem )
+    : Filesystem_( Filesystem )
+    {
+    }
+
+    path_t current_path() const override
+    {
+        // The memory filesystem does not know of symlinks above the base
+        return boost::filesystem::canonical( boost::filesystem::current_path() );
+    }
+
+    void create_directories( const path_t& p ) const override
+    {
+        scenario_filesystem::create_directories( p );
+        Filesystem_.create_directories( p );
+    }
+
+    void create_directory_symlink( const path_t& To, const path_t& NewSymlink ) const override
+    {
+        scenario_filesystem::create_directory_symlink( To, NewSymlink );
+        Filesystem_.create_directory_symlink( To, NewSymlink );
+    }
+
+    void create_file( const path_t& p ) const override
+    {
+        scenario_filesystem::create_file( p );
+        Filesystem_.create_file( p );
+    }
+
+    void remove_all( const path_t& p ) const override
+    {
+        scenario_filesystem::remove_all( p );
+        Filesystem_.remove_all( p );
+    }
+
+private:
+
+    xstd::filesystem::memory_filesystem& Filesystem_;
+};
+
+
+void test_memory_filesystem_resolution()
+{
+    xstd::filesystem::memory_filesystem Filesystem;
+    boost::system::error_code ec;
+
+    BOOST_CHECK( Filesystem.exists( "/", ec ) && !ec );
+    BOOST_CHECK( Filesystem.is_directory( "/", ec ) );
+    BOOST_CHECK( Filesystem.size() == 1 );
+
+    Filesystem.create_directories( "/a/b/c" );
+    Filesystem.create_file( "/a/b/c/file" );
+    Filesystem.create_symlink( "../../b", "/a/b/c/up" );
+    Filesystem.create_symlink( "/a/b/c", "/link" );
+    Filesystem.create_symlink( "loop_2", "/loop_1" );
+    Filesystem.create_symlink( "loop_1", "/loop_2" );
+    Filesystem.create_symlink( "missing", "/dangling" );
+
+    BOOST_CHECK( Filesystem.size() == 10 );
+    BOOST_CHECK( !Filesystem.create_directories( "/a/b" ) );
+    BOOST_CHECK( !Filesystem.create_directories( "/link" ) );
+
+    BOOST_CHECK( Filesystem.canonical( "/link/up/c/file", ec ) == "/a/b/c/file" && !ec );
+    BOOST_CHECK( Filesystem.canonical( "/link/up/../b/./c", ec ) == "/a/b/c" && !ec );
+    BOOST_CHECK( Filesystem.canonical( "/../a/..", ec ) == "/" && !ec );
+    BOOST_CHECK( Filesystem.is_directory( "/link/up", ec ) );
+    BOOST_CHECK( !Filesystem.is_directory( "/link/file", ec ) && Filesystem.exists( "/link/file", ec ) );
+    BOOST_CHECK( Filesystem.is_symlink( "/link", ec ) && !Filesystem.is_symlink( "/link/up/c", ec ) );
+    BOOST_CHECK( Filesystem.read_symlink( "/link/up/c/up", ec ) == "../../b" && !ec );
+
+    // Missing paths are not errors for the queries, but are for canonical
+    BOOST_CHECK( !Filesystem.exists( "/a/x", ec ) && !ec );
+    BOOST_CHECK( !Filesystem.exists( "/link/file/x", ec ) && !ec );
+    BOOST_CHECK( !Filesystem.exists( "/dangling", ec ) && !ec );
+    BOOST_CHECK( Filesystem.is_symlink( "/dangling", ec ) );
+    BOOST_CHECK( Filesystem.canonical( "/a/x", ec ).empty() && ec == boost::system::errc::no_such_file_or_directory );
+    BOOST_CHECK( Filesystem.canonical( "/link/file/x", ec ).empty() && ec == boost::system::errc::not_a_directory );
+
+    // Only a directory may be followed by ".", ".." or a separator
+    BOOST_CHECK( !Filesystem.exists( "/a/b/c/file/.", ec ) && !ec );
+    BOOST_CHECK( !Filesystem.exists( "/a/b/c/file/", ec ) && !ec );
+    BOOST_CHECK( !Filesystem.exists( "/a/b/c/file/..", ec ) && !ec );
+    BOOST_CHECK( !Filesystem.exists( "/link/up/c/file/.", ec ) && !ec );
+    BOOST_CHECK( Filesystem.canonical( "/a/b/c/file/.", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Filesystem.canonical( "/a/b/c/file/", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Filesystem.canonical( "/a/b/../b/c/file/..", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Filesystem.canonical( "/a/b/c/", ec ) == "/a/b/c" && !ec );
+    BOOST_CHECK( Filesystem.canonical( "/link/", ec ) == "/a/b/c" && !ec );
+    BOOST_CHECK( Filesystem.is_directory( "/link/", ec ) );
+
+        BOOST_CHECK( !Filesystem.exists( "/loop_1", ec ) && ec == boost::system::errc::too_many_symbolic_link_levels );
+    BOOST_CHECK( Filesystem.is_symlink( "/loop_1", ec ) && !ec );
+
+    // Relative paths are resolved from the current path
+    Filesystem.current_path( "/link", ec );
+    BOOST_CHECK( !ec && Filesystem.current_path() == "/a/b/c" );
+    BOOST_CHECK( Filesystem.canonical( "up/c/file", ec ) == "/a/b/c/file" && !ec );
+    Filesystem.current_path( "/link/file", ec );
+    BOOST_CHECK( ec == boost::system::errc::not_a_directory && Filesystem.current_path() == "/a/b/c" );
+
+    // Changes
+    Filesystem.create_file( "/a/x/y", ec );
+    BOOST_CHECK( ec == boost::system::errc::no_such_file_or_directory );
+    Filesystem.create_file( "/link", ec );
+    BOOST_CHECK( ec == boost::system::errc::file_exists );
+    BOOST_CHECK_THROW( Filesystem.create_directories( "/a/b/c/file/d" ), boost::filesystem::filesystem_error );
+
+    BOOST_CHECK( Filesystem.remove_all( "/link" ) == 1 );
+    BOOST_CHECK( Filesystem.exists( "/a/b/c", ec ) );
+    BOOST_CHECK( Filesystem.remove_all( "/a/b" ) == 4 );
+    BOOST_CHECK( !Filesystem.exists( "/a/b", ec ) && Filesystem.exists( "/a", ec ) );
+    BOOST_CHECK( Filesystem.remove_all( "/a/b" ) == 0 );
+    BOOST_CHECK( Filesystem.size() == 5 );
+
+    Filesystem.create_directories( "/a/b/d" );
+    BOOST_CHECK( Filesystem.size() == 7 && Filesystem.is_directory( "/a/b/d", ec ) );
+}
+
+
+void test_memory_filesystem_load()
+{
+    auto test_base = boost::filesystem::canonical( boost::filesystem::current_path() ) / "test_level_0";
+    auto a_level_2 = test_base / "a_level_1" / "a_level_2";
+
+    create_directories( a_level_2 );
+    std::ofstream( ( a_level_2 / "file" ).c_str() );
+    create_directory_symlink( "a_level_1/a_level_2", test_base / "link" );
+
+    xstd::filesystem::memory_filesystem Filesystem;
+    Filesystem.load( test_base );
+
+    remove_all( test_base );
+
+    boost::system::error_code ec;
+    BOOST_CHECK( Filesystem.is_directory( a_level_2, ec ) );
+    BOOST_CHECK( Filesystem.exists( a_level_2 / "file", ec ) && !Filesystem.is_directory( a_level_2 / "file", ec ) );
+    BOOST_CHECK( Filesystem.is_symlink( test_base / "link", ec ) );
+    BOOST_CHECK( Filesystem.canonical( test_base / "link/file", ec ) == a_level_2 / "file" );
+
+    boost::filesystem::memory_operations Ops( Filesystem );
+    auto Relative = boost::filesystem::relative( test_base / "link/file", test_base / "a_level_1", ec, Ops );
+    BOOST_CHECK( normalize( test_base / "a_level_1" / Relative ) == a_level_2 / "file" );
+
+    BOOST_CHECK_THROW( Filesystem.load( test_base ), boost::filesystem::filesystem_error );
+}
+
+
+void test_memory_relative_from_current_path()
+{
+    xstd::filesystem::memory_filesystem Filesystem;
+    Filesystem.create_directories( "/a/b/c" );
+    Filesystem.create_directory_symlink( "b/c", "/a/link" );
+
+    boost::system::error_code ec;
+    Filesystem.current_path( "/a", ec );
+    BOOST_CHECK( !ec );
+
+    // Relative arguments are made absolute from the memory filesystem's
+    // current path, never from the process's
+    boost::filesystem::memory_operations Ops( Filesystem );
+    BOOST_CHECK( Filesystem.exists( "b", ec ) );
+    BOOST_CHECK( boost::filesystem::relative( "b", "/a", ec, Ops ) == "./b" && !ec );
+    BOOST_CHECK( boost::filesystem::relative( "b/c", "b", ec, Ops ) == "./c" && !ec );
+    BOOST_CHECK( boost::filesystem::relative( "link/x", ".", ec, Ops ) == "./b/c/x" && !ec );
+    BOOST_CHECK( boost::filesystem::relative( "/a/b", "link", ec, Ops ) == ".." && !ec );
+    BOOST_CHECK( boost::filesystem::weakly_canonical( "b", ec, Ops ) == "/a/b" && !ec );
+    BOOST_CHECK( boost::filesystem::weakly_canonical( "link/x/y", ec, Ops ) == "/a/b/c/x/y" && !ec );
+
+    Filesystem.current_path( "/a/b", ec );
+    BOOST_CHECK( boost::filesystem::relative( "c", "..", ec, Ops ) == "./b/c" && !ec );
+    BOOST_CHECK( boost::filesystem::proximate( "../link", "c", ec, Ops ) == "." && !ec );
+}
+
+
+//! Checks that `relative` given memory_operations answers every pair. The
+//! answers themselves are not checked here: computing the expected path
+//! with `weakly_canonical` and the same operations would only repeat what
+//! `relative` does. The mirrored runs check the answers against disk.
+relative_check_t memory_relative_check( const xstd::filesystem::memory_filesystem& Filesystem )
+{
+    return [&Filesystem]( const path_t& Path, const path_t& Start )
+    {
+        boost::filesystem::memory_operations Ops( Filesystem );
+        boost::system::error_code ec;
+
+        auto Relative = boost::filesystem::relative( Path, Start, ec, Ops );
+        BOOST_CHECK_MESSAGE
+        (   !ec && !Relative.empty(),
+            "From " << Start << " to " << Path << ": " << ec.message()   );
+    };
+}
+
+
+//! Compares `relative` given memory_operations with `relative` on disk
+void mirrored_relative_check( const xstd::filesystem::memory_filesystem& Filesystem, const path_t& Path, const path_t& Start )
+{
+    boost::system::error_code OnDiskEc;
+    boost::system::error_code InMemoryEc;
+    auto OnDisk = boost::filesystem::relative( Path, Start, OnDiskEc );
+    auto InMemory = boost::filesystem::relative( Path, Start, InMemoryEc, boost::filesystem::memory_operations( Filesystem ) );
+
+    BOOST_CHECK_MESSAGE( OnDisk == InMemory, "From " << Start << " to " << Path << ": " << OnDisk << " != " << InMemory );
+    BOOST_CHECK_MESSAGE( !OnDiskEc == !InMemoryEc, "From " << Start << " to " << Path << ": " << OnDiskEc.message() << " != " << InMemoryEc.message() );
+}
+
+
+//! Runs `scenario` against a tree that exists only in memory, checking
+//! that nothing reaches the disk
+template<class Scenario>
+void run_in_memory( Scenario Run )
+{
+    xstd::filesystem::memory_filesystem Filesystem;
+    memory_scenario_filesystem Memory( Filesystem );
+    scenario_filesystem_guard Guard( Memory );
+
+    Run( memory_relative_check( Filesystem ) );
+
+    // Nothing was written to disk and the scenario cleaned up after itself
+    BOOST_CHECK( !boost::filesystem::exists( "/memory_root" ) );
+    BOOST_CHECK( Filesystem.size() == 3 );
+}
+
+
+//! Runs `scenario` against the same tree on disk and in memory, checking
+//! that `relative` gives the same answer from both
+template<class Scenario>
+void run_mirrored( Scenario Run )
+{
+    xstd::filesystem::memory_filesystem Filesystem;
+    mirrored_scenario_filesystem Mirrored( Filesystem );
+    scenario_filesystem_guard Guard( Mirrored );
+
+    Run( [&Filesystem]( const path_t& Path, const path_t& Start )
+    {
+        mirrored_relative_check( Filesystem, Path, Start );
+    } );
+}
+
+
+void test_memory_real_relative_paths()
+{
+    run_in_memory( test_real_relative_paths );
+    run_mirrored( test_real_relative_paths );
+}
+
+
+void test_memory_multiple_nested_symlinks()
+{
+    run_in_memory( multiple_nested_symlinks );
+    run_mirrored( multiple_nested_symlinks );
+}
+
+
+void test_memory_real_and_imaginary_relative_paths()
+{
+    run_in_memory( test_real_and_imaginary_relative_paths );
+    run_mirrored( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_memory_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_in_memory( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+    run_mirrored( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+void test_memory_relative_paths_through_files()
+{
+    run_mirrored( test_relative_paths_through_files );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_MEMORY_FILESYSTEM_TESTS_HPP_INCLUDED
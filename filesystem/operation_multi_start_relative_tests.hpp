@@ -0,0 +1,169 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_MULTI_START_RELATIVE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_MULTI_START_RELATIVE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/concurrent_path_map.hpp"
+#include "filesystem/multi_start_relative.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Check `relative_from_starts( p, starts )`, with each backend and thread
+//! count, against calling `relative( p, start )` for each start in turn
+void check_relative_from_starts( const path_t& p, const std::vector<path_t>& Starts )
+{
+    std::vector<boost::system::error_code> Errors( Starts.size() );
+    std::vector<path_t> Expected;
+    for( std::size_t Start = 0; Start != Starts.size(); ++Start )
+    {
+        Expected.push_back( boost::filesystem::relative( p, Starts[Start], Errors[Start] ) );
+    }
+
+    xstd::filesystem::concurrent_path_map Canonical;
+    for( std::size_t Threads: { 1, 4 } )
+    {
+        std::vector<xstd::filesystem::worker_statistics> Statistics;
+        std::vector<std::vector<boost::filesystem::path_result>> Runs
+        {
+            boost::filesystem::relative_from_starts( p, Starts, Threads, &Statistics ),
+            boost::filesystem::relative_from_starts( p, Starts, Threads, boost::filesystem::system_operations() ),
+            boost::filesystem::relative_from_starts( p, Starts, Threads, boost::filesystem::cached_canonical_operations<>( Canonical ) )
+        };
+        for( const auto& Results: Runs )
+        {
+            BOOST_REQUIRE( Results.size() == Starts.size() );
+            for( std::size_t Start = 0; Start != Starts.size(); ++Start )
+            {
+                BOOST_CHECK_MESSAGE( Results[Start].path == Expected[Start], "From " << Starts[Start] << " to " << p << ": " << Results[Start].path << " != " << Expected[Start] );
+                BOOST_CHECK_MESSAGE( Results[Start].ec == Errors[Start], "From " << Starts[Start] << " to " << p << ": " << Results[Start].ec.message() << " != " << Errors[Start].message() );
+            }
+        }
+        std::size_t Items = 0;
+        for( const auto& Worker: Statistics )
+        {
+            Items += Worker.items;
+        }
+        BOOST_CHECK( Items <= Starts.size() );
+    }
+}
+
+
+//! Records every start and checks each path against all the starts seen so
+//! far, so that each scenario's paths are tried from every directory it uses
+template<class Scenario>
+void run_from_starts( Scenario Run )
+{
+    auto Starts = std::make_shared<std::vector<path_t>>();
+
+    Run( [Starts]( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        if( std::find( Starts->begin(), Starts->end(), Start ) == Starts->end() )
+        {
+            Starts->push_back( Start );
+        }
+        check_relative_from_starts( Path, *Starts );
+    } );
+}
+
+
+void test_multi_start_real_relative_paths()
+{
+    run_from_starts( test_real_relative_paths );
+}
+
+
+void test_multi_start_imaginary_relative_paths()
+{
+    run_from_starts( test_imaginary_relative_paths );
+}
+
+
+void test_multi_start_real_and_imaginary_relative_paths()
+{
+    run_from_starts( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+void test_multi_start_package_tree()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    remove_all( test_base );
+
+    // Many packages with the same layout, one reached through a symlink,
+    // and a target below one of them
+    auto packages = test_base / "packages";
+    std::vector<path_t> Starts;
+    for( int Package = 0; Package != 40; ++Package )
+    {
+        auto package = packages / ( "p_" + std::to_string( Package ) );
+        create_directories( package / "lib" / "pkgconfig" );
+        create_directories( package / "include" );
+        Starts.push_back( package / "lib" );
+        Starts.push_back( package / "lib" / "pkgconfig" );
+        Starts.push_back( package / "include" );
+    }
+    create_directory_symlink( packages / "p_3", test_base / "current" );
+    std::ofstream( ( packages / "p_7" / "lib" / "libx.so" ).c_str() ) << "x";
+
+    // Starts through the symlink, repeated, relative, not yet created, a
+    // file, and the root
+    Starts.push_back( test_base / "current" / "lib" );
+    Starts.push_back( test_base / "current" / "lib" / ".." / "include" );
+    Starts.push_back( packages / "p_0" / "lib" );
+    Starts.push_back( "test_level_0/packages/p_1/include" );
+    Starts.push_back( packages / "p_9" / "share" / "doc" );
+    Starts.push_back( packages / "p_7" / "lib" / "libx.so" );
+    Starts.push_back( "/" );
+
+    check_relative_from_starts( packages / "p_7" / "lib" / "libx.so", Starts );
+    check_relative_from_starts( test_base / "current" / "include" / "x.h", Starts );
+    check_relative_from_starts( "test_level_0/packages/p_7/lib/../include", Starts );
+    check_relative_from_starts( test_base, Starts );
+    check_relative_from_starts( test_base / "current" / "lib" / "libx.so", std::vector<path_t>() );
+
+    // A start that is a file fails on its own; the others are unaffected
+    auto Results = boost::filesystem::relative_from_starts( packages / "p_0" / "include", Starts, 4 );
+    BOOST_CHECK( Results[ Starts.size() - 2 ].ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Results[0].path == "../include" );
+    BOOST_CHECK( !Results[0].ec );
+
+    remove_all( test_base );
+}
+
+
+void test_shared_prefix()
+{
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a/b/c", "/a/b/d" ) == "/a/b" );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a/b/c", "/a/bc" ) == "/a" );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a//b/c", "/a/b/c/d" ) == "/a//b/c" );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a/b/", "/a/b/c" ) == "/a/b" );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a/b", "/a/b/c" ) == "/a/b" );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/a", "/b" ).empty() );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "/", "/" ).empty() );
+    BOOST_CHECK( boost::filesystem::shared_prefix( "a/b", "a/c" ).empty() );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_MULTI_START_RELATIVE_TESTS_HPP_INCLUDED
@@ -0,0 +1,192 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_NEGATIVE_EXISTS_CACHE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_NEGATIVE_EXISTS_CACHE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/negative_exists_cache.hpp"
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_negative_exists_imaginary_relative_paths()
+{
+    xstd::filesystem::negative_exists_cache Cache( std::chrono::hours( 1 ) );
+    boost::filesystem::negative_exists_operations<> Ops( Cache );
+
+    int Checked = 0;
+    std::uint64_t SecondRoundHits = 0;
+
+    // Every pair is resolved twice so the second resolution is answered
+    // from the cache, and must match resolving without it
+    test_imaginary_relative_paths( [&]( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        boost::system::error_code ec;
+        auto Expected = boost::filesystem::relative( Path, Start, ec );
+
+        for( int Round = 0; Round != 2; ++Round )
+        {
+            auto Hits = Cache.statistics().hits;
+
+            boost::system::error_code cached_ec;
+            BOOST_CHECK( boost::filesystem::relative( Path, Start, cached_ec, Ops ) == Expected );
+            BOOST_CHECK( cached_ec == ec );
+
+            if( Round == 1 )
+            {
+                SecondRoundHits += Cache.statistics().hits - Hits;
+            }
+        }
+        ++Checked;
+    } );
+
+    // At least `start` and `p`, neither of which exist, are answered from
+    // the cache on the second resolution of each pair
+    BOOST_CHECK( SecondRoundHits >= 2u * Checked );
+    BOOST_CHECK( Cache.statistics().size != 0 );
+}
+
+
+void test_negative_exists_invalidation()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    create_directories( test_base );
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+
+    xstd::filesystem::negative_exists_cache Cache( std::chrono::hours( 1 ) );
+    boost::filesystem::negative_exists_operations<> Ops( Cache );
+
+    boost::system::error_code ec;
+
+    BOOST_CHECK( !Ops.exists( a_level_1, ec ) );
+    BOOST_CHECK( !Ops.exists( a_level_2, ec ) );
+    BOOST_CHECK( Cache.known_missing( a_level_2 ) );
+
+    create_directories( a_level_2 );
+
+    // Not yet told, so the cached answer stands until the entry expires
+    BOOST_CHECK( !Ops.exists( a_level_2, ec ) );
+
+    // Invalidating a directory covers everything spelled below it
+    Cache.invalidate( test_base );
+
+    BOOST_CHECK( !Cache.known_missing( a_level_1 ) );
+    BOOST_CHECK( Ops.exists( a_level_1, ec ) );
+    BOOST_CHECK( Ops.exists( a_level_2, ec ) );
+
+    remove_all( test_base );
+
+    // An entry made after an invalidation is trusted again
+    BOOST_CHECK( !Ops.exists( a_level_2, ec ) );
+    BOOST_CHECK( Cache.known_missing( a_level_2 ) );
+
+    Cache.invalidate( a_level_1 / "other" );
+    BOOST_CHECK( Cache.known_missing( a_level_2 ) );
+
+    Cache.invalidate( a_level_2 );
+    BOOST_CHECK( !Cache.known_missing( a_level_2 ) );
+}
+
+
+void test_negative_exists_expiry()
+{
+    xstd::filesystem::negative_exists_cache Cache( std::chrono::seconds( 0 ) );
+    boost::filesystem::negative_exists_operations<> Ops( Cache );
+
+    auto Missing = path_t( "/imaginary_root" ) / "test_level_0";
+
+    boost::system::error_code ec;
+    BOOST_CHECK( !Ops.exists( Missing, ec ) );
+    BOOST_CHECK( !Ops.exists( Missing, ec ) );
+    BOOST_CHECK( !Cache.known_missing( Missing ) );
+    BOOST_CHECK( Cache.statistics().hits == 0 );
+
+    // Relative paths depend on the current directory and are never cached
+    xstd::filesystem::negative_exists_cache Lasting( std::chrono::hours( 1 ) );
+    boost::filesystem::negative_exists_operations<> LastingOps( Lasting );
+
+    BOOST_CHECK( !LastingOps.exists( "imaginary_level_0", ec ) );
+    BOOST_CHECK( !Lasting.known_missing( "imaginary_level_0" ) );
+
+    // Without a call to `invalidate`, a file created behind the cache's back
+    // is only seen once the default time to live has run out
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    create_directories( test_base );
+    auto Created = test_base / "created_level_1";
+
+    xstd::filesystem::negative_exists_cache Default;
+    boost::filesystem::negative_exists_operations<> DefaultOps( Default );
+
+    BOOST_CHECK( !DefaultOps.exists( Created, ec ) );
+    create_directories( Created );
+    BOOST_CHECK( Default.known_missing( Created ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 150 ) );
+    BOOST_CHECK( DefaultOps.exists( Created, ec ) );
+
+    remove_all( test_base );
+}
+
+
+void test_negative_exists_invalidation_records()
+{
+    xstd::filesystem::negative_exists_cache Cache( std::chrono::milliseconds( 50 ) );
+
+    auto Root = path_t( "/imaginary_root" );
+    auto Stale = Root / "a_level_1" / "stale";
+    auto Fresh = Root / "b_level_1" / "fresh";
+
+    Cache.insert_missing( Stale, Cache.generation() );
+    for( int i = 0; i != 100; ++i )
+    {
+        Cache.invalidate( Root / "a_level_1" / std::to_string( i ) );
+    }
+    Cache.invalidate( Root / "a_level_1" );
+    BOOST_CHECK( Cache.invalidations() == 101 );
+    BOOST_CHECK( !Cache.known_missing( Stale ) );
+
+    // Once they are older than the time to live, invalidating anything
+    // prunes the records, a shard at a time
+    std::this_thread::sleep_for( std::chrono::milliseconds( 60 ) );
+    auto Generation = Cache.generation();
+    for( std::size_t i = 0; i != xstd::filesystem::negative_exists_cache::invalidation_shards; ++i )
+    {
+        Cache.invalidate( Root / "c_level_1" / std::to_string( i ) );
+    }
+    BOOST_CHECK( Cache.invalidations() == xstd::filesystem::negative_exists_cache::invalidation_shards );
+
+    // An entry made before a dropped record is still treated as invalidated,
+    // and one made after is trusted
+    BOOST_CHECK( !Cache.known_missing( Stale ) );
+    Cache.insert_missing( Fresh, Generation );
+    BOOST_CHECK( Cache.known_missing( Fresh ) );
+
+    Cache.clear();
+    BOOST_CHECK( Cache.invalidations() == 0 );
+    BOOST_CHECK( !Cache.known_missing( Fresh ) );
+    Cache.insert_missing( Fresh, Cache.generation() );
+    BOOST_CHECK( Cache.known_missing( Fresh ) );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_NEGATIVE_EXISTS_CACHE_TESTS_HPP_INCLUDED
@@ -0,0 +1,155 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_PARALLEL_RELATIVE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_PARALLEL_RELATIVE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+#include "filesystem/parallel.hpp"
+#include "filesystem/parallel_relative.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_work_stealing_for_uneven_work()
+{
+    const std::size_t Count = 2000;
+    std::unique_ptr<std::atomic<int>[]> Calls( new std::atomic<int>[Count] );
+    for( std::size_t Index = 0; Index != Count; ++Index )
+    {
+        Calls[Index] = 0;
+    }
+
+    // All the expensive indices are in the first thread's share
+    auto Statistics = xstd::filesystem::work_stealing_for( Count, 4, [&]( std::size_t First, std::size_t Last )
+    {
+        for( ; First != Last; ++First )
+        {
+            ++Calls[First];
+            if( First < Count / 4 && First % 10 == 0 )
+            {
+                std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+            }
+        }
+    },
+    4 );
+
+    for( std::size_t Index = 0; Index != Count; ++Index )
+    {
+        BOOST_CHECK( Calls[Index] == 1 );
+    }
+
+    BOOST_REQUIRE( Statistics.size() == 4 );
+
+    std::size_t Items = 0;
+    std::size_t Steals = 0;
+    for( const auto& Worker: Statistics )
+    {
+        BOOST_TEST_MESSAGE( "items = " << Worker.items << ", steals = " << Worker.steals << ", utilisation = " << Worker.utilisation );
+        Items += Worker.items;
+        Steals += Worker.steals;
+        BOOST_CHECK( Worker.utilisation >= 0 && Worker.utilisation <= 1 );
+    }
+    BOOST_CHECK( Items == Count );
+    BOOST_CHECK( Steals != 0 );
+
+    // A single thread and an empty range
+    Statistics = xstd::filesystem::work_stealing_for( 10, 1, []( std::size_t, std::size_t ) {} );
+    BOOST_CHECK( Statistics.size() == 1 && Statistics[0].items == 10 );
+
+    Statistics = xstd::filesystem::work_stealing_for( 0, 4, []( std::size_t, std::size_t ) { BOOST_ERROR( "called" ); } );
+    BOOST_CHECK( Statistics.size() == 1 && Statistics[0].items == 0 );
+
+    // Exceptions reach the caller
+    BOOST_CHECK_THROW
+    (   xstd::filesystem::work_stealing_for( 100, 4, []( std::size_t First, std::size_t Last )
+        {
+            if( First <= 50 && 50 < Last )
+            {
+                throw std::runtime_error( "50" );
+            }
+        },
+        1 ),
+        std::runtime_error   );
+}
+
+
+//! Records each pair and checks the parallel results for every pair so far
+//! against calling `relative` and `proximate` for each in turn
+template<class Scenario>
+void run_in_parallel( Scenario Run )
+{
+    auto Pairs = std::make_shared<std::vector<std::pair<path_t, path_t>>>();
+
+    Run( [Pairs]( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        Pairs->emplace_back( Path, Start );
+
+        std::vector<xstd::filesystem::worker_statistics> Statistics;
+        auto Relative  = boost::filesystem::parallel_relative( *Pairs, 4, &Statistics );
+        auto Proximate = boost::filesystem::parallel_proximate( *Pairs, 4 );
+
+        BOOST_REQUIRE( Relative.size() == Pairs->size() && Proximate.size() == Pairs->size() );
+        for( std::size_t Pair = 0; Pair != Pairs->size(); ++Pair )
+        {
+            const auto& p = ( *Pairs )[Pair].first;
+            const auto& start = ( *Pairs )[Pair].second;
+
+            boost::system::error_code ec;
+            auto Expected = boost::filesystem::relative( p, start, ec );
+
+            BOOST_CHECK_MESSAGE( Relative[Pair].path == Expected, "From " << start << " to " << p << ": " << Relative[Pair].path << " != " << Expected );
+            BOOST_CHECK( Relative[Pair].ec == ec );
+            BOOST_CHECK( Proximate[Pair].path == boost::filesystem::proximate( p, start, ec ) );
+        }
+
+        std::size_t Items = 0;
+        for( const auto& Worker: Statistics )
+        {
+            Items += Worker.items;
+        }
+        BOOST_CHECK( Items == Pairs->size() );
+    } );
+}
+
+
+void test_parallel_real_relative_paths()
+{
+    run_in_parallel( test_real_relative_paths );
+}
+
+
+void test_parallel_imaginary_relative_paths()
+{
+    run_in_parallel( test_imaginary_relative_paths );
+}
+
+
+void test_parallel_real_and_imaginary_relative_paths()
+{
+    run_in_parallel( test_real_and_imaginary_relative_paths );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_PARALLEL_RELATIVE_TESTS_HPP_INCLUDED
@@ -13,13 +13,93 @@
 #include <boost/filesystem.hpp>
 
 // C++ Standard Library Includes
-// None
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
 
 // I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
 
 
 using path_t = boost::filesystem::path_t;
 
+//! Called by the scenarios below for each pair of paths to check
+using relative_check_t = std::function<void( const path_t& Path, const path_t& Start )>;
+
+
+//! Builds the trees the scenarios below check against, on the real
+//! filesystem unless a test installs another with `scenario_filesystem_guard`
+class scenario_filesystem
+{
+public:
+
+    virtual ~scenario_filesystem() = default;
+
+    virtual path_t current_path() const
+    {
+        return boost::filesystem::current_path();
+    }
+
+    virtual void create_directories( const path_t& p ) const
+    {
+        boost::filesystem::create_directories( p );
+    }
+
+    virtual void create_directory_symlink( const path_t& To, const path_t& NewSymlink ) const
+    {
+        boost::filesystem::create_directory_symlink( To, NewSymlink );
+    }
+
+    virtual void create_file( const path_t& p ) const
+    {
+        std::ofstream( p.c_str() );
+    }
+
+    virtual void remove_all( const path_t& p ) const
+    {
+        boost::filesystem::remove_all( p );
+    }
+};
+
+
+inline const scenario_filesystem*& installed_scenario_filesystem()
+{
+    static scenario_filesystem Disk;
+    static const scenario_filesystem* Installed = &Disk;
+    return Installed;
+}
+
+
+inline const scenario_filesystem& scenario_filesystem_in_use()
+{
+    return *installed_scenario_filesystem();
+}
+
+
+//! Makes the scenarios build their trees with `filesystem` while in scope
+class scenario_filesystem_guard
+{
+public:
+
+    explicit scenario_filesystem_guard( const scenario_filesystem& Filesystem )
+    : Previous_( installed_scenario_filesystem() )
+    {
+        installed_scenario_filesystem() = &Filesystem;
+    }
+
+    scenario_filesystem_guard( const scenario_filesystem_guard& ) = delete;
+    scenario_filesystem_guard& operator=( const scenario_filesystem_guard& ) = delete;
+
+    ~scenario_filesystem_guard()
+    {
+        installed_scenario_filesystem() = Previous_;
+    }
+
+private:
+
+    const scenario_filesystem* Previous_;
+};
+
 
 void test_relative( const path_t& Path, const path_t& Start )
 {
@@ -51,6 +131,9 @@ void test_relative( const path_t& Path, const path_t& Start )
     }
     else
     {
+        // Computed independently of `relative`, which resolves an imaginary
+        // path through `weakly_canonical`: the common path is made canonical
+        // if it exists and the rest of each path is normalized lexically
         auto RealPath   = Path;
         auto RealStart  = Start;
         auto CommonPath = remove_common_prefix( RealPath, RealStart );
@@ -72,9 +155,11 @@ void test_relative( const path_t& Path, const path_t& Start )
 }
 
 
-void test_real_relative_paths()
+void test_real_relative_paths( const relative_check_t& Check = test_relative )
 {
-    path_t Base = boost::filesystem::current_path();
+    const auto& Filesystem = scenario_filesystem_in_use();
+
+    path_t Base = Filesystem.current_path();
 
     auto test_base = Base / "test_level_0";
 
@@ -84,7 +169,7 @@ void test_real_relative_paths()
     auto a_level_4 = a_level_3 / "a_level_4";
     auto a_level_5 = a_level_4 / "a_level_5";
 
-    create_directories( a_level_5 );
+    Filesystem.create_directories( a_level_5 );
 
     auto b_level_1 = test_base / "b_level_1";
     auto b_level_2 = b_level_1 / "b_level_2";
@@ -92,122 +177,122 @@ void test_real_relative_paths()
     auto b_level_4 = b_level_3 / "b_level_4";
     auto b_level_5 = b_level_4 / "b_level_5";
 
-    create_directories( b_level_5 );
+    Filesystem.create_directories( b_level_5 );
 
     auto c_level_1 = test_base / "c_level_1";
     auto c_level_2 = c_level_1 / "c_level_2";
 
-    create_directories( c_level_2 );
+    Filesystem.create_directories( c_level_2 );
 
     auto c_level_3 = c_level_2 / "c_level_3";
 
-    create_directory_symlink( b_level_3, c_level_3 );
+    Filesystem.create_directory_symlink( b_level_3, c_level_3 );
 
     auto c_level_4 = c_level_3 / "c_level_4";
 
-    create_directories( c_level_4 );
+    Filesystem.create_directories( c_level_4 );
 
     auto c_level_5 = c_level_4 / "c_level_5";
 
-    create_directory_symlink( a_level_1, c_level_5 );
-
-    test_relative( test_base, test_base );
-
-    test_relative( a_level_1, test_base );
-    test_relative( a_level_2, test_base );
-    test_relative( a_level_3, test_base );
-    test_relative( a_level_4, test_base );
-    test_relative( a_level_5, test_base );
-
-    test_relative( test_base, a_level_1 );
-    test_relative( test_base, a_level_2 );
-    test_relative( test_base, a_level_3 );
-    test_relative( test_base, a_level_4 );
-    test_relative( test_base, a_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_1, b_level_2 );
-    test_relative( a_level_1, b_level_3 );
-    test_relative( a_level_1, b_level_4 );
-    test_relative( a_level_1, b_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_1 );
-    test_relative( a_level_3, b_level_1 );
-    test_relative( a_level_4, b_level_1 );
-    test_relative( a_level_5, b_level_1 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_2 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_4 );
-    test_relative( a_level_5, b_level_5 );
-
-    test_relative( a_level_2, b_level_4 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_2 );
-
-    test_relative( c_level_1, test_base );
-    test_relative( c_level_2, test_base );
-    test_relative( c_level_3, test_base );
-    test_relative( c_level_4, test_base );
-    test_relative( c_level_5, test_base );
-
-    test_relative( test_base, c_level_1 );
-    test_relative( test_base, c_level_2 );
-    test_relative( test_base, c_level_3 );
-    test_relative( test_base, c_level_4 );
-    test_relative( test_base, c_level_5 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_1, b_level_2 );
-    test_relative( c_level_1, b_level_3 );
-    test_relative( c_level_1, b_level_4 );
-    test_relative( c_level_1, b_level_5 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_1 );
-    test_relative( c_level_3, b_level_1 );
-    test_relative( c_level_4, b_level_1 );
-    test_relative( c_level_5, b_level_1 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_2 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_4 );
-    test_relative( c_level_5, b_level_5 );
-
-    test_relative( c_level_2, b_level_4 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_2 );
-
-    test_relative( c_level_1, a_level_1 );
-    test_relative( c_level_1, a_level_2 );
-    test_relative( c_level_1, a_level_3 );
-    test_relative( c_level_1, a_level_4 );
-    test_relative( c_level_1, a_level_5 );
-
-    test_relative( c_level_1, a_level_1 );
-    test_relative( c_level_2, a_level_1 );
-    test_relative( c_level_3, a_level_1 );
-    test_relative( c_level_4, a_level_1 );
-    test_relative( c_level_5, a_level_1 );
-
-    test_relative( c_level_1, a_level_1 );
-    test_relative( c_level_2, a_level_2 );
-    test_relative( c_level_3, a_level_3 );
-    test_relative( c_level_4, a_level_4 );
-    test_relative( c_level_5, a_level_5 );
-
-    test_relative( c_level_2, a_level_4 );
-    test_relative( c_level_3, a_level_3 );
-    test_relative( c_level_4, a_level_2 );
-
-    remove_all( test_base );
+    Filesystem.create_directory_symlink( a_level_1, c_level_5 );
+
+    Check( test_base, test_base );
+
+    Check( a_level_1, test_base );
+    Check( a_level_2, test_base );
+    Check( a_level_3, test_base );
+    Check( a_level_4, test_base );
+    Check( a_level_5, test_base );
+
+    Check( test_base, a_level_1 );
+    Check( test_base, a_level_2 );
+    Check( test_base, a_level_3 );
+    Check( test_base, a_level_4 );
+    Check( test_base, a_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_1, b_level_2 );
+    Check( a_level_1, b_level_3 );
+    Check( a_level_1, b_level_4 );
+    Check( a_level_1, b_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_1 );
+    Check( a_level_3, b_level_1 );
+    Check( a_level_4, b_level_1 );
+    Check( a_level_5, b_level_1 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_2 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_4 );
+    Check( a_level_5, b_level_5 );
+
+    Check( a_level_2, b_level_4 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_2 );
+
+    Check( c_level_1, test_base );
+    Check( c_level_2, test_base );
+    Check( c_level_3, test_base );
+    Check( c_level_4, test_base );
+    Check( c_level_5, test_base );
+
+    Check( test_base, c_level_1 );
+    Check( test_base, c_level_2 );
+    Check( test_base, c_level_3 );
+    Check( test_base, c_level_4 );
+    Check( test_base, c_level_5 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_1, b_level_2 );
+    Check( c_level_1, b_level_3 );
+    Check( c_level_1, b_level_4 );
+    Check( c_level_1, b_level_5 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_1 );
+    Check( c_level_3, b_level_1 );
+    Check( c_level_4, b_level_1 );
+    Check( c_level_5, b_level_1 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_2 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_4 );
+    Check( c_level_5, b_level_5 );
+
+    Check( c_level_2, b_level_4 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_2 );
+
+    Check( c_level_1, a_level_1 );
+    Check( c_level_1, a_level_2 );
+    Check( c_level_1, a_level_3 );
+    Check( c_level_1, a_level_4 );
+    Check( c_level_1, a_level_5 );
+
+    Check( c_level_1, a_level_1 );
+    Check( c_level_2, a_level_1 );
+    Check( c_level_3, a_level_1 );
+    Check( c_level_4, a_level_1 );
+    Check( c_level_5, a_level_1 );
+
+    Check( c_level_1, a_level_1 );
+    Check( c_level_2, a_level_2 );
+    Check( c_level_3, a_level_3 );
+    Check( c_level_4, a_level_4 );
+    Check( c_level_5, a_level_5 );
+
+    Check( c_level_2, a_level_4 );
+    Check( c_level_3, a_level_3 );
+    Check( c_level_4, a_level_2 );
+
+    Filesystem.remove_all( test_base );
 }
 
 
-void multiple_nested_symlinks()
+void multiple_nested_symlinks( const relative_check_t& Check = test_relative )
 {
 //     a / b / c / testfile
 //     a / d / e --> ../../a/b
@@ -221,7 +306,9 @@ void multiple_nested_symlinks()
 //     |-- c
 //     |-- testfile
 
-    path_t Base = boost::filesystem::current_path();
+    const auto& Filesystem = scenario_filesystem_in_use();
+
+    path_t Base = Filesystem.current_path();
 
     auto test_base = Base / "test_level_0";
 
@@ -229,72 +316,72 @@ void multiple_nested_symlinks()
     auto dir_b = dir_a / "dir_b";
     auto dir_c = dir_b / "dir_c";
 
-    create_directories( dir_c );
+    Filesystem.create_directories( dir_c );
 
     auto testdir = dir_c / "testdir";
 
-    create_directories( testdir );
+    Filesystem.create_directories( testdir );
 
     auto dir_d = dir_a / "dir_d";
 
-    create_directories( dir_d );
+    Filesystem.create_directories( dir_d );
 
     auto dir_e = dir_d/ "dir_e";
 
-    create_directory_symlink( "../../dir_a/dir_b", dir_e );
+    Filesystem.create_directory_symlink( "../../dir_a/dir_b", dir_e );
 
     auto dir_m = test_base / "dir_m";
 
-    create_directories( dir_m );
+    Filesystem.create_directories( dir_m );
 
     auto dir_n = dir_m / "dir_n";
 
-    create_directory_symlink( dir_a, dir_n );
+    Filesystem.create_directory_symlink( dir_a, dir_n );
 
     auto dir_x = test_base / "dir_x";
     auto dir_y = dir_x / "dir_y";
 
-    create_directories( dir_y );
+    Filesystem.create_directories( dir_y );
 
     auto dir_z = dir_y / "dir_z";
 
-    create_directory_symlink( dir_m / "dir_n/dir_d", dir_z );
+    Filesystem.create_directory_symlink( dir_m / "dir_n/dir_d", dir_z );
 
-    test_relative( dir_x, testdir );
-    test_relative( testdir, dir_x );
+    Check( dir_x, testdir );
+    Check( testdir, dir_x );
 
-    test_relative( dir_y, testdir );
-    test_relative( testdir, dir_y );
+    Check( dir_y, testdir );
+    Check( testdir, dir_y );
 
-    test_relative( dir_z, testdir );
-    test_relative( testdir, dir_z );
+    Check( dir_z, testdir );
+    Check( testdir, dir_z );
 
-    test_relative( dir_m, testdir );
-    test_relative( testdir, dir_m );
+    Check( dir_m, testdir );
+    Check( testdir, dir_m );
 
-    test_relative( dir_n, testdir );
-    test_relative( testdir, dir_n );
+    Check( dir_n, testdir );
+    Check( testdir, dir_n );
 
-    test_relative( dir_d, testdir );
-    test_relative( testdir, dir_d );
+    Check( dir_d, testdir );
+    Check( testdir, dir_d );
 
-    test_relative( dir_e, testdir );
-    test_relative( testdir, dir_e );
+    Check( dir_e, testdir );
+    Check( testdir, dir_e );
 
-    test_relative( dir_d, dir_x );
-    test_relative( dir_x, dir_d );
+    Check( dir_d, dir_x );
+    Check( dir_x, dir_d );
 
-    test_relative( dir_d, dir_y );
-    test_relative( dir_y, dir_d );
+    Check( dir_d, dir_y );
+    Check( dir_y, dir_d );
 
-    test_relative( dir_e, dir_y );
-    test_relative( dir_y, dir_e );
+    Check( dir_e, dir_y );
+    Check( dir_y, dir_e );
 
-    remove_all( test_base );
+    Filesystem.remove_all( test_base );
 }
 
 
-void test_imaginary_relative_paths()
+void test_imaginary_relative_paths( const relative_check_t& Check = test_relative )
 {
     auto test_base = path_t( "/imaginary_root" ) / "test_level_0";
 
@@ -310,47 +397,49 @@ void test_imaginary_relative_paths()
     auto b_level_4 = b_level_3 / "b_level_4";
     auto b_level_5 = b_level_4 / "b_level_5";
 
-    test_relative( test_base, test_base );
-
-    test_relative( a_level_1, test_base );
-    test_relative( a_level_2, test_base );
-    test_relative( a_level_3, test_base );
-    test_relative( a_level_4, test_base );
-    test_relative( a_level_5, test_base );
-
-    test_relative( test_base, a_level_1 );
-    test_relative( test_base, a_level_2 );
-    test_relative( test_base, a_level_3 );
-    test_relative( test_base, a_level_4 );
-    test_relative( test_base, a_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_1, b_level_2 );
-    test_relative( a_level_1, b_level_3 );
-    test_relative( a_level_1, b_level_4 );
-    test_relative( a_level_1, b_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_1 );
-    test_relative( a_level_3, b_level_1 );
-    test_relative( a_level_4, b_level_1 );
-    test_relative( a_level_5, b_level_1 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_2 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_4 );
-    test_relative( a_level_5, b_level_5 );
-
-    test_relative( a_level_2, b_level_4 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_2 );
+    Check( test_base, test_base );
+
+    Check( a_level_1, test_base );
+    Check( a_level_2, test_base );
+    Check( a_level_3, test_base );
+    Check( a_level_4, test_base );
+    Check( a_level_5, test_base );
+
+    Check( test_base, a_level_1 );
+    Check( test_base, a_level_2 );
+    Check( test_base, a_level_3 );
+    Check( test_base, a_level_4 );
+    Check( test_base, a_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_1, b_level_2 );
+    Check( a_level_1, b_level_3 );
+    Check( a_level_1, b_level_4 );
+    Check( a_level_1, b_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_1 );
+    Check( a_level_3, b_level_1 );
+    Check( a_level_4, b_level_1 );
+    Check( a_level_5, b_level_1 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_2 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_4 );
+    Check( a_level_5, b_level_5 );
+
+    Check( a_level_2, b_level_4 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_2 );
 }
 
 
-void test_real_and_imaginary_relative_paths()
+void test_real_and_imaginary_relative_paths( const relative_check_t& Check = test_relative )
 {
-    path_t Base = boost::filesystem::current_path();
+    const auto& Filesystem = scenario_filesystem_in_use();
+
+    path_t Base = Filesystem.current_path();
 
     auto test_base = Base / "test_level_0";
 
@@ -360,7 +449,7 @@ void test_real_and_imaginary_relative_paths()
     auto a_level_4 = a_level_3 / "a_level_4";
     auto a_level_5 = a_level_4 / "a_level_5";
 
-    create_directories( a_level_5 );
+    Filesystem.create_directories( a_level_5 );
 
     auto b_level_1 = test_base / "_b_level_1";
     auto b_level_2 = b_level_1 / "_b_level_2";
@@ -368,83 +457,85 @@ void test_real_and_imaginary_relative_paths()
     auto b_level_4 = b_level_3 / "_b_level_4";
     auto b_level_5 = b_level_4 / "_b_level_5";
 
-    test_relative( a_level_1, test_base );
-    test_relative( a_level_2, test_base );
-    test_relative( a_level_3, test_base );
-    test_relative( a_level_4, test_base );
-    test_relative( a_level_5, test_base );
-
-    test_relative( test_base, a_level_1 );
-    test_relative( test_base, a_level_2 );
-    test_relative( test_base, a_level_3 );
-    test_relative( test_base, a_level_4 );
-    test_relative( test_base, a_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_1, b_level_2 );
-    test_relative( a_level_1, b_level_3 );
-    test_relative( a_level_1, b_level_4 );
-    test_relative( a_level_1, b_level_5 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_1 );
-    test_relative( a_level_3, b_level_1 );
-    test_relative( a_level_4, b_level_1 );
-    test_relative( a_level_5, b_level_1 );
-
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_2 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_4 );
-    test_relative( a_level_5, b_level_5 );
-
-    test_relative( a_level_2, b_level_4 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_2 );
+    Check( a_level_1, test_base );
+    Check( a_level_2, test_base );
+    Check( a_level_3, test_base );
+    Check( a_level_4, test_base );
+    Check( a_level_5, test_base );
+
+    Check( test_base, a_level_1 );
+    Check( test_base, a_level_2 );
+    Check( test_base, a_level_3 );
+    Check( test_base, a_level_4 );
+    Check( test_base, a_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_1, b_level_2 );
+    Check( a_level_1, b_level_3 );
+    Check( a_level_1, b_level_4 );
+    Check( a_level_1, b_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_1 );
+    Check( a_level_3, b_level_1 );
+    Check( a_level_4, b_level_1 );
+    Check( a_level_5, b_level_1 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_2 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_4 );
+    Check( a_level_5, b_level_5 );
+
+    Check( a_level_2, b_level_4 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_2 );
 
     auto c_level_1 = test_base / "c_level_1";
     auto c_level_2 = c_level_1 / "c_level_2";
 
-    create_directories( c_level_2 );
+    Filesystem.create_directories( c_level_2 );
 
     auto c_level_3 = c_level_2 / "c_level_3";
 
-    create_directory_symlink( a_level_3, c_level_3 );
+    Filesystem.create_directory_symlink( a_level_3, c_level_3 );
 
     auto c_level_4 = c_level_3 / "c_level_4";
     auto c_level_5 = c_level_4 / "c_level_5";
 
-    create_directories( c_level_5 );
+    Filesystem.create_directories( c_level_5 );
 
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_1, b_level_2 );
-    test_relative( c_level_1, b_level_3 );
-    test_relative( c_level_1, b_level_4 );
-    test_relative( c_level_1, b_level_5 );
+    Check( c_level_1, b_level_1 );
+    Check( c_level_1, b_level_2 );
+    Check( c_level_1, b_level_3 );
+    Check( c_level_1, b_level_4 );
+    Check( c_level_1, b_level_5 );
 
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_1 );
-    test_relative( c_level_3, b_level_1 );
-    test_relative( c_level_4, b_level_1 );
-    test_relative( c_level_5, b_level_1 );
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_1 );
+    Check( c_level_3, b_level_1 );
+    Check( c_level_4, b_level_1 );
+    Check( c_level_5, b_level_1 );
 
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_2 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_4 );
-    test_relative( c_level_5, b_level_5 );
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_2 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_4 );
+    Check( c_level_5, b_level_5 );
 
-    test_relative( c_level_2, b_level_4 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_2 );
+    Check( c_level_2, b_level_4 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_2 );
 
-    remove_all( test_base );
+    Filesystem.remove_all( test_base );
 }
 
 
-void test_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+void test_real_and_imaginary_relative_paths_with_parent_and_current_directories( const relative_check_t& Check = test_relative )
 {
-    path_t Base = boost::filesystem::current_path();
+    const auto& Filesystem = scenario_filesystem_in_use();
+
+    path_t Base = Filesystem.current_path();
 
     auto test_base = Base / "test_level_0";
 
@@ -454,7 +545,7 @@ void test_real_and_imaginary_relative_paths_with_parent_and_current_directories(
     auto a_level_4 = a_level_3 / "a_level_4";
     auto a_level_5 = a_level_4 / "a_level_5";
 
-    create_directories( a_level_5 );
+    Filesystem.create_directories( a_level_5 );
 
     auto b_level_1 = test_base / "_b_level_1";
     auto b_level_2 = b_level_1 / "_b_level_2";
@@ -462,75 +553,188 @@ void test_real_and_imaginary_relative_paths_with_parent_and_current_directories(
     auto b_level_4 = b_level_3 / "_b_level_4";
     auto b_level_5 = b_level_4 / "_b_level_5";
 
-    test_relative( a_level_1, test_base );
-    test_relative( a_level_2, test_base );
-    test_relative( a_level_3, test_base );
-    test_relative( a_level_4, test_base );
-    test_relative( a_level_5, test_base );
+    Check( a_level_1, test_base );
+    Check( a_level_2, test_base );
+    Check( a_level_3, test_base );
+    Check( a_level_4, test_base );
+    Check( a_level_5, test_base );
+
+    Check( test_base, a_level_1 );
+    Check( test_base, a_level_2 );
+    Check( test_base, a_level_3 );
+    Check( test_base, a_level_4 );
+    Check( test_base, a_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_1, b_level_2 );
+    Check( a_level_1, b_level_3 );
+    Check( a_level_1, b_level_4 );
+    Check( a_level_1, b_level_5 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_1 );
+    Check( a_level_3, b_level_1 );
+    Check( a_level_4, b_level_1 );
+    Check( a_level_5, b_level_1 );
+
+    Check( a_level_1, b_level_1 );
+    Check( a_level_2, b_level_2 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_4 );
+    Check( a_level_5, b_level_5 );
+
+    Check( a_level_2, b_level_4 );
+    Check( a_level_3, b_level_3 );
+    Check( a_level_4, b_level_2 );
 
-    test_relative( test_base, a_level_1 );
-    test_relative( test_base, a_level_2 );
-    test_relative( test_base, a_level_3 );
-    test_relative( test_base, a_level_4 );
-    test_relative( test_base, a_level_5 );
+    auto c_level_1 = test_base / "c_level_1";
+    auto c_level_2 = c_level_1 / "c_level_2";
 
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_1, b_level_2 );
-    test_relative( a_level_1, b_level_3 );
-    test_relative( a_level_1, b_level_4 );
-    test_relative( a_level_1, b_level_5 );
+    Filesystem.create_directories( c_level_2 );
 
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_1 );
-    test_relative( a_level_3, b_level_1 );
-    test_relative( a_level_4, b_level_1 );
-    test_relative( a_level_5, b_level_1 );
+    auto c_level_3 = c_level_2 / "c_level_3";
 
-    test_relative( a_level_1, b_level_1 );
-    test_relative( a_level_2, b_level_2 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_4 );
-    test_relative( a_level_5, b_level_5 );
+    Filesystem.create_directory_symlink( a_level_3, c_level_3 );
+
+    auto c_level_4 = c_level_3 / "..";
+    auto c_level_5 = c_level_4 / "c_level_5";
+
+    Filesystem.create_directories( c_level_5 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_1, b_level_2 );
+    Check( c_level_1, b_level_3 );
+    Check( c_level_1, b_level_4 );
+    Check( c_level_1, b_level_5 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_1 );
+    Check( c_level_3, b_level_1 );
+    Check( c_level_4, b_level_1 );
+    Check( c_level_5, b_level_1 );
+
+    Check( c_level_1, b_level_1 );
+    Check( c_level_2, b_level_2 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_4 );
+    Check( c_level_5, b_level_5 );
+
+    Check( c_level_2, b_level_4 );
+    Check( c_level_3, b_level_3 );
+    Check( c_level_4, b_level_2 );
+
+    Filesystem.remove_all( test_base );
+}
+
+
+//! Paths that continue past a regular file with ".", ".." or a trailing
+//! separator, which do not exist because only a directory may be followed
+//! by a separator
+void test_relative_paths_through_files( const relative_check_t& Check = test_relative )
+{
+    const auto& Filesystem = scenario_filesystem_in_use();
+
+    path_t Base = Filesystem.current_path();
+
+    auto test_base = Base / "test_level_0";
+    auto a_level_1 = test_base / "a_level_1";
+    auto d_level_2 = a_level_1 / "d_level_2";
+    auto file = a_level_1 / "file";
+
+    Filesystem.create_directories( d_level_2 );
+    Filesystem.create_file( file );
+
+    Check( d_level_2, file / "." );
+    Check( d_level_2, path_t( file.native() + "/" ) );
+    Check( d_level_2, file / ".." );
+    Check( d_level_2, d_level_2 / ".." / "file" / "." );
+    Check( d_level_2, file / "." / "x" );
+
+    Check( file / ".", d_level_2 );
+    Check( path_t( file.native() + "/" ), d_level_2 );
+    Check( file / "..", d_level_2 );
+    Check( d_level_2 / ".." / "file" / ".", a_level_1 );
+
+    Check( path_t( d_level_2.native() + "/" ), path_t( a_level_1.native() + "/" ) );
+
+    Filesystem.remove_all( test_base );
+}
 
-    test_relative( a_level_2, b_level_4 );
-    test_relative( a_level_3, b_level_3 );
-    test_relative( a_level_4, b_level_2 );
+
+//! Answers filesystem queries with `system_operations`, counting `exists` calls
+struct counting_operations : boost::filesystem::system_operations
+{
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        ++*Probes;
+        return boost::filesystem::exists( p, ec );
+    }
+
+    std::shared_ptr<int> Probes = std::make_shared<int>( 0 );
+};
+
+
+void test_weakly_canonical_paths()
+{
+    path_t Base = boost::filesystem::current_path();
+
+    auto test_base = Base / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+
+    create_directories( a_level_2 );
 
     auto c_level_1 = test_base / "c_level_1";
+
+    create_directories( c_level_1 );
+
     auto c_level_2 = c_level_1 / "c_level_2";
 
-    create_directories( c_level_2 );
+    create_directory_symlink( a_level_2, c_level_2 );
 
-    auto c_level_3 = c_level_2 / "c_level_3";
+    auto real_a_level_1 = canonical( a_level_1 );
 
-    create_directory_symlink( a_level_3, c_level_3 );
+    BOOST_CHECK( weakly_canonical( a_level_2 ) == canonical( a_level_2 ) );
+    BOOST_CHECK( weakly_canonical( c_level_2 / "x/y" ) == real_a_level_1 / "a_level_2/x/y" );
+    BOOST_CHECK( weakly_canonical( c_level_2 / "x/../y/." ) == real_a_level_1 / "a_level_2/y" );
 
-    auto c_level_4 = c_level_3 / "..";
-    auto c_level_5 = c_level_4 / "c_level_5";
+    // The parent of the symlink target, not of the symlink, as `..` follows
+    // the real directory structure up to the deepest existing ancestor
+    auto through_link = c_level_2 / ".." / "imaginary";
+
+    BOOST_CHECK( weakly_canonical( through_link ) == real_a_level_1 / "imaginary" );
+    BOOST_CHECK( relative( through_link, a_level_1 ) == "./imaginary" );
+    BOOST_CHECK( relative( a_level_1 / "x", c_level_2 / "z" ) == "../../x" );
+
+    BOOST_CHECK( relative( through_link, test_base ) == "./a_level_1/imaginary" );
+    BOOST_CHECK( relative( through_link, c_level_2 / "z" ) == "../../imaginary" );
+    BOOST_CHECK( relative( c_level_2 / "z", through_link ) == "../a_level_2/z" );
+
+    // Resolving below a deep existing directory takes a logarithmic number
+    // of probes: one for the whole path, then a binary search over depth
+    auto deep = a_level_2;
+    for( int Level = 0; Level != 24; ++Level )
+    {
+        deep /= "d_" + std::to_string( Level );
+    }
+    create_directories( deep );
+
+    auto imaginary = deep;
+    for( int Level = 0; Level != 8; ++Level )
+    {
+        imaginary /= "i_" + std::to_string( Level );
+    }
+
+    counting_operations Ops;
+    boost::system::error_code ec;
+
+    BOOST_CHECK( weakly_canonical( imaginary, ec, Ops ) == normalize( canonical( deep ) / lexically_relative( imaginary, deep ) ) );
+    BOOST_CHECK( !ec );
+    BOOST_TEST_MESSAGE( "Probes          = " << *Ops.Probes );
+    BOOST_CHECK( *Ops.Probes <= 7 );
 
-    create_directories( c_level_5 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_1, b_level_2 );
-    test_relative( c_level_1, b_level_3 );
-    test_relative( c_level_1, b_level_4 );
-    test_relative( c_level_1, b_level_5 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_1 );
-    test_relative( c_level_3, b_level_1 );
-    test_relative( c_level_4, b_level_1 );
-    test_relative( c_level_5, b_level_1 );
-
-    test_relative( c_level_1, b_level_1 );
-    test_relative( c_level_2, b_level_2 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_4 );
-    test_relative( c_level_5, b_level_5 );
-
-    test_relative( c_level_2, b_level_4 );
-    test_relative( c_level_3, b_level_3 );
-    test_relative( c_level_4, b_level_2 );
+    BOOST_CHECK( weakly_canonical( path_t( "/imaginary_root/test_level_0/../x" ) ) == "/imaginary_root/x" );
 
     remove_all( test_base );
 }
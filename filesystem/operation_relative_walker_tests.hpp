@@ -0,0 +1,166 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_RELATIVE_WALKER_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_RELATIVE_WALKER_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operations.hpp"
+#include "filesystem/relative_walker.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+using walked_t = std::map<std::string, boost::filesystem::file_type>;
+
+
+//! Build a tree with files, empty and nested directories, a directory large
+//! enough to need several `getdents64` calls and symlinks to directories
+//! that must not be followed
+path_t make_walk_tree()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    remove_all( test_base );
+
+    create_directories( test_base / "a" / "b" / "c" / "d" );
+    create_directories( test_base / "empty" );
+    create_directories( test_base / "large" );
+    std::ofstream( ( test_base / "file" ).c_str() ) << "file";
+    std::ofstream( ( test_base / "a" / "b" / "c" / "d" / "file" ).c_str() ) << "file";
+    std::ofstream( ( test_base / ".hidden" ).c_str() ) << "file";
+    for( int File = 0; File != 500; ++File )
+    {
+        std::ofstream( ( test_base / "large" / ( "a_long_name_for_file_" + std::to_string( File ) ) ).c_str() ) << File;
+    }
+    create_directory_symlink( test_base / "a", test_base / "large" / "link_to_a" );
+    create_directory_symlink( "..", test_base / "a" / "b" / "loop" );
+    create_symlink( "missing", test_base / "dangling" );
+
+    return test_base;
+}
+
+
+//! What boost::filesystem::recursive_directory_iterator finds below `root`
+walked_t expected_walk( const path_t& Root )
+{
+    walked_t Expected;
+    for( boost::filesystem::recursive_directory_iterator Entry( Root ), End; Entry != End; ++Entry )
+    {
+        Expected[ Entry->path().string().substr( Root.string().size() + 1 ) ] = Entry->symlink_status().type();
+    }
+    return Expected;
+}
+
+
+void test_relative_walker()
+{
+    auto test_base = make_walk_tree();
+    auto Expected = expected_walk( test_base );
+    BOOST_REQUIRE( Expected.size() == 512 );
+
+    for( bool UseGetdents : { false, true } )
+    {
+        xstd::filesystem::walk_options Options;
+        Options.use_getdents = UseGetdents;
+        Options.buffer_size = 1024;
+
+        walked_t Walked;
+        xstd::filesystem::relative_walker Walker( test_base, Options );
+        while( Walker.next() )
+        {
+            BOOST_CHECK( Walked.emplace( Walker.path(), Walker.type() ).second );
+            BOOST_CHECK( Walker.depth() == static_cast<std::size_t>( std::count( Walker.path().begin(), Walker.path().end(), '/' ) ) );
+        }
+        BOOST_CHECK( Walked == Expected );
+        BOOST_CHECK( !Walker.next() );
+    }
+
+    // Directories come before their entries and can be skipped
+    xstd::filesystem::relative_walker Walker( test_base );
+    walked_t Walked;
+    while( Walker.next() )
+    {
+        if( Walker.type() == boost::filesystem::directory_file )
+        {
+            BOOST_CHECK( Walked.lower_bound( Walker.path() + '/' ) == Walked.lower_bound( Walker.path() + '0' ) );
+        }
+        Walked.emplace( Walker.path(), Walker.type() );
+        if( Walker.path() == "large" || Walker.path() == "a/b" )
+        {
+            Walker.skip_directory();
+        }
+    }
+    BOOST_CHECK( Walked.size() == 512 - 501 - 4 );
+    BOOST_CHECK( Walked.count( "a/b" ) && !Walked.count( "a/b/c" ) );
+
+    // A root that is a symlink is followed
+    create_directory_symlink( test_base / "a", test_base.parent_path() / "test_level_0_link" );
+    xstd::filesystem::relative_walker Linked( test_base.parent_path() / "test_level_0_link" );
+    walked_t LinkedWalk;
+    while( Linked.next() )
+    {
+        LinkedWalk.emplace( Linked.path(), Linked.type() );
+    }
+    BOOST_CHECK( LinkedWalk == expected_walk( test_base / "a" ) );
+    remove( test_base.parent_path() / "test_level_0_link" );
+
+    boost::system::error_code ec;
+    xstd::filesystem::relative_walker Missing( test_base / "missing", xstd::filesystem::walk_options(), ec );
+    BOOST_CHECK( ec && !Missing.next( ec ) );
+    BOOST_CHECK_THROW( xstd::filesystem::relative_walker( test_base / "file" ), boost::filesystem::filesystem_error );
+
+    remove_all( test_base );
+}
+
+
+void test_walk_relative()
+{
+    auto test_base = make_walk_tree();
+    auto Expected = expected_walk( test_base );
+
+    for( std::size_t Threads : { 1, 4 } )
+    {
+        for( bool UseGetdents : { false, true } )
+        {
+            xstd::filesystem::walk_options Options;
+            Options.use_getdents = UseGetdents;
+            Options.threads = Threads;
+
+            std::mutex Mutex;
+            walked_t Walked;
+            std::vector<xstd::filesystem::walk_failure> Failures;
+            boost::system::error_code ec;
+            xstd::filesystem::walk_relative( test_base, Options, [&]( const std::string& Path, boost::filesystem::file_type Type )
+            {
+                std::lock_guard<std::mutex> Lock( Mutex );
+                BOOST_CHECK( Walked.emplace( Path, Type ).second );
+            }, ec, &Failures );
+            BOOST_CHECK( !ec );
+            BOOST_CHECK( Failures.empty() );
+            BOOST_CHECK( Walked == Expected );
+        }
+    }
+
+    boost::system::error_code ec;
+    xstd::filesystem::walk_relative( test_base / "missing", xstd::filesystem::walk_options(), []( const std::string&, boost::filesystem::file_type ) {}, ec );
+    BOOST_CHECK( ec );
+
+    remove_all( test_base );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_RELATIVE_WALKER_TESTS_HPP_INCLUDED
@@ -0,0 +1,155 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_ROOT_REGISTRY_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_ROOT_REGISTRY_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operations.hpp"
+#include "filesystem/root_registry.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+void test_root_registry_find()
+{
+    boost::filesystem::root_registry Registry;
+
+    BOOST_CHECK( !Registry.find( "/workspace/a/src/main.cpp" ) );
+
+    BOOST_CHECK( Registry.add( "/workspace" ) );
+    BOOST_CHECK( Registry.add( "/workspace/a" ) );
+    BOOST_CHECK( Registry.add( "/workspace/a/build/" ) );
+    BOOST_CHECK( Registry.add( "//root_x/share" ) );
+    BOOST_CHECK( !Registry.add( "/workspace/./a" ) );
+
+    BOOST_CHECK( Registry.size() == 4 );
+
+    std::vector<std::pair<path_t, path_t>> Cases = {
+        { "/workspace/a/src/main.cpp",      "/workspace/a" },
+        { "/workspace/a/build/obj/x.o",     "/workspace/a/build" },
+        { "/workspace/b/../a/build/y.o",    "/workspace/a/build" },
+        { "/workspace/ab",                  "/workspace" },
+        { "/workspace",                     "/workspace" },
+        { "//root_x/share/doc",             "//root_x/share" },
+        { "//root_y/share/doc",             "" },
+        { "/other",                         "" }
+    };
+
+    for( const auto& Case: Cases )
+    {
+        auto Match = Registry.find( Case.first );
+
+        BOOST_TEST_MESSAGE( "Path = [" << Case.first << "], Root = [" << Match.root << "], Relative = [" << Match.relative << "]" );
+        BOOST_CHECK( Match.root == normalize( Case.second ) );
+
+        if( Match )
+        {
+            BOOST_CHECK( Match.relative == lexically_relative( normalize( Case.first ), Match.root ) );
+            BOOST_CHECK( normalize( Match.root / Match.relative ) == normalize( Case.first ) );
+        }
+        else
+        {
+            BOOST_CHECK( Match.relative.empty() );
+        }
+    }
+
+    BOOST_CHECK( Registry.contains( "/workspace/a" ) );
+    BOOST_CHECK( !Registry.contains( "/workspace/a/src" ) );
+}
+
+
+void test_root_registry_remove()
+{
+    boost::filesystem::root_registry Registry;
+
+    Registry.add( "/workspace" );
+    Registry.add( "/workspace/a" );
+    Registry.add( "/workspace/a/b/c" );
+
+    BOOST_CHECK( Registry.remove( "/workspace/a" ) );
+    BOOST_CHECK( !Registry.remove( "/workspace/a" ) );
+    BOOST_CHECK( !Registry.remove( "/workspace/a/b" ) );
+    BOOST_CHECK( !Registry.remove( "/not/registered" ) );
+
+    BOOST_CHECK( Registry.size() == 2 );
+    BOOST_CHECK( Registry.find( "/workspace/a/x" ).root == path_t( "/workspace" ) );
+    BOOST_CHECK( Registry.find( "/workspace/a/b/c/d" ).root == path_t( "/workspace/a/b/c" ) );
+
+    BOOST_CHECK( Registry.remove( "/workspace/a/b/c" ) );
+    BOOST_CHECK( Registry.remove( "/workspace" ) );
+
+    BOOST_CHECK( Registry.size() == 0 );
+    BOOST_CHECK( !Registry.find( "/workspace/a/b/c/d" ) );
+}
+
+
+void test_root_registry_concurrent_readers()
+{
+    boost::filesystem::root_registry Registry;
+
+    Registry.add( "/mnt" );
+
+    std::atomic<bool> Done( false );
+    std::atomic<int>  Unexpected( 0 );
+
+    std::vector<std::thread> Readers;
+    for( int Reader = 0; Reader != 4; ++Reader )
+    {
+        Readers.emplace_back( [&]()
+        {
+            while( !Done.load() )
+            {
+                for( int i = 0; i != 50; ++i )
+                {
+                    path_t Path = path_t( "/mnt/volume_" + std::to_string( i ) ) / "data/file";
+                    auto Match = Registry.find( Path );
+                    bool Valid = ( Match.root == path_t( "/mnt" ) && Match.relative == lexically_relative( Path, "/mnt" ) )
+                              || ( Match.root == path_t( "/mnt/volume_" + std::to_string( i ) ) && Match.relative == path_t( "./data/file" ) );
+                    if( !Valid )
+                    {
+                        ++Unexpected;
+                    }
+                }
+            }
+        } );
+    }
+
+    for( int Round = 0; Round != 20; ++Round )
+    {
+        for( int i = 0; i != 50; ++i )
+        {
+            Registry.add( "/mnt/volume_" + std::to_string( i ) );
+        }
+        for( int i = 0; i != 50; ++i )
+        {
+            Registry.remove( "/mnt/volume_" + std::to_string( i ) );
+        }
+    }
+    Done = true;
+
+    for( auto& Reader: Readers )
+    {
+        Reader.join();
+    }
+
+    BOOST_CHECK( Unexpected.load() == 0 );
+    BOOST_CHECK( Registry.size() == 1 );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_ROOT_REGISTRY_TESTS_HPP_INCLUDED
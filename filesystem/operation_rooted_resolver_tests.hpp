@@ -0,0 +1,173 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_ROOTED_RESOLVER_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_ROOTED_RESOLVER_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operations.hpp"
+#include "filesystem/rooted_resolver.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <string>
+#include <utility>
+#include <vector>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Create a root holding symlinks that try to leave it, returning its path
+path_t make_rooted_tree( const path_t& test_base )
+{
+    auto root = test_base / "root";
+
+    auto a_level_1 = root / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+
+    create_directories( a_level_2 );
+    boost::filesystem::ofstream( a_level_1 / "file" ) << "file";
+
+    auto b_level_1 = root / "b_level_1";
+
+    create_directories( b_level_1 );
+
+    auto outside = test_base / "outside";
+
+    create_directories( outside );
+
+    create_directory_symlink( "/a_level_1", b_level_1 / "abs_link" );
+    create_directory_symlink( "../../../..", b_level_1 / "escape" );
+    create_directory_symlink( "/../../a_level_1", b_level_1 / "abs_escape" );
+    create_directory_symlink( "../a_level_1/a_level_2", b_level_1 / "rel_link" );
+    create_directory_symlink( canonical( outside ), b_level_1 / "host_link" );
+
+    return root;
+}
+
+
+void check_rooted_resolution( const xstd::filesystem::rooted_resolver& Resolver )
+{
+    // Path inside the root and its real path, empty if it does not exist
+    std::vector<std::pair<path_t, std::string>> Paths =
+    {
+        { "/",                                      "/" },
+        { "/..",                                    "/" },
+        { "/a_level_1/a_level_2/../../..",          "/" },
+        { "/a_level_1/a_level_2/",                  "/a_level_1/a_level_2" },
+        { "/b_level_1/abs_link",                    "/a_level_1" },
+        { "/b_level_1/abs_link/a_level_2",          "/a_level_1/a_level_2" },
+        { "/b_level_1/escape",                      "/" },
+        { "/b_level_1/escape/a_level_1",            "/a_level_1" },
+        { "/b_level_1/abs_escape/file",             "/a_level_1/file" },
+        { "/b_level_1/rel_link/..",                 "/a_level_1" },
+        { "/b_level_1/host_link",                   "" },
+        { "/b_level_1/escape/outside",              "" },
+        { "/missing",                               "" },
+        { "/a_level_1/file/x",                      "" },
+    };
+
+    for( const auto& Path: Paths )
+    {
+        boost::system::error_code ec;
+        auto Result = Resolver.resolve( Path.first, ec );
+
+        BOOST_TEST_MESSAGE( "Path            = " << Path.first );
+        BOOST_TEST_MESSAGE( "Resolved        = " << Result.real_path );
+
+        BOOST_CHECK_MESSAGE( !ec, Path.first << ": " << ec.message() );
+        BOOST_CHECK_MESSAGE( Result.found == !Path.second.empty(), Path.first );
+        if( Result.found )
+        {
+            BOOST_CHECK_MESSAGE( Result.real_path == Path.second, Path.first << ": " << Result.real_path );
+        }
+    }
+
+    boost::filesystem::rooted_operations Ops( Resolver );
+    boost::system::error_code ec;
+
+    BOOST_CHECK( relative( path_t( "/b_level_1/abs_link/a_level_2" ), "/b_level_1/escape", ec, Ops ) == "./a_level_1/a_level_2" );
+    BOOST_CHECK( relative( path_t( "/a_level_1/file" ), "/b_level_1/rel_link", ec, Ops ) == "../file" );
+    BOOST_CHECK( relative( path_t( "/b_level_1/escape/imaginary/x" ), "/b_level_1/abs_link", ec, Ops ) == "../imaginary/x" );
+    BOOST_CHECK( relative( path_t( "/b_level_1/host_link/x" ), "/", ec, Ops ) == "./b_level_1/host_link/x" );
+    BOOST_CHECK( !ec );
+
+    // Relative arguments are taken from the root, not the host's directory
+    BOOST_CHECK( relative( path_t( "b_level_1/abs_link/a_level_2" ), "a_level_1", ec, Ops ) == "./a_level_2" );
+    BOOST_CHECK( relative( path_t( "a_level_1/file" ), "/b_level_1/rel_link", ec, Ops ) == "../file" );
+    BOOST_CHECK( relative( path_t( "/a_level_1" ), "b_level_1/escape/..", ec, Ops ) == "./a_level_1" );
+    BOOST_CHECK( !ec );
+
+    BOOST_CHECK( relative( path_t( "/a_level_1" ), "/a_level_1/file", ec, Ops ).empty() );
+    BOOST_CHECK( ec == boost::system::errc::not_a_directory );
+}
+
+
+void test_rooted_resolver_openat2()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    auto root = make_rooted_tree( test_base );
+
+    xstd::filesystem::rooted_resolver Resolver( root );
+
+    BOOST_TEST_MESSAGE( "openat2         = " << Resolver.uses_openat2() );
+    BOOST_CHECK( Resolver.uses_openat2() == xstd::filesystem::rooted_resolver::openat2_supported() );
+
+    check_rooted_resolution( Resolver );
+
+    remove_all( test_base );
+}
+
+
+void test_rooted_resolver_moved_root()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    auto root = make_rooted_tree( test_base );
+
+    xstd::filesystem::rooted_resolver Resolver( root );
+
+    rename( root, test_base / "moved" );
+
+    boost::system::error_code ec;
+    auto Result = Resolver.resolve( "/a_level_1", ec );
+
+    // Only the kernel's resolution can tell that the root has moved, and
+    // it must not fall back to the walker having done so
+    if( Resolver.uses_openat2() )
+    {
+        BOOST_CHECK( !Result.found );
+        BOOST_CHECK( ec == boost::system::errc::cross_device_link );
+        BOOST_CHECK( Resolver.uses_openat2() );
+
+        Result = Resolver.resolve( "/a_level_1", ec, false );
+        BOOST_CHECK( Result.found && !ec );
+    }
+
+    remove_all( test_base );
+}
+
+
+void test_rooted_resolver_walk()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+    auto root = make_rooted_tree( test_base );
+
+    xstd::filesystem::rooted_resolver Resolver( root, false );
+
+    BOOST_CHECK( !Resolver.uses_openat2() );
+
+    check_rooted_resolution( Resolver );
+
+    remove_all( test_base );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_ROOTED_RESOLVER_TESTS_HPP_INCLUDED
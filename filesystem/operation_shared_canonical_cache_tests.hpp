@@ -0,0 +1,351 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_SHARED_CANONICAL_CACHE_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_SHARED_CANONICAL_CACHE_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+#include "filesystem/shared_canonical_cache.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Answers filesystem queries with `system_operations`, counting `canonical` calls
+struct counting_canonical_operations : boost::filesystem::system_operations
+{
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        ++*Calls;
+        return boost::filesystem::canonical( p, ec );
+    }
+
+    std::shared_ptr<int> Calls = std::make_shared<int>( 0 );
+};
+
+
+//! Answers filesystem queries as counting_canonical_operations, then
+//! invalidates a cache as another process restructuring the tree would
+struct invalidating_canonical_operations : counting_canonical_operations
+{
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Result = counting_canonical_operations::canonical( p, ec );
+        Cache->invalidate_all();
+        return Result;
+    }
+
+    xstd::filesystem::shared_canonical_cache* Cache = nullptr;
+};
+
+
+path_t shared_cache_file()
+{
+    return boost::filesystem::current_path() / "test_level_0.cache";
+}
+
+
+void test_shared_canonical_cache_across_processes()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a_level_2 = test_base / "a_level_1" / "a_level_2";
+    auto link = test_base / "link";
+
+    remove_all( test_base );
+    create_directories( a_level_2 );
+    create_directory_symlink( a_level_2, link );
+    remove( shared_cache_file() );
+
+    // A worker process fills the cache and exits
+    pid_t Child = ::fork();
+    BOOST_REQUIRE( Child >= 0 );
+    if( Child == 0 )
+    {
+        xstd::filesystem::shared_canonical_cache Cache( shared_cache_file(), 64 );
+        boost::filesystem::shared_canonical_operations<> Ops( Cache );
+        boost::system::error_code ec;
+        auto Relative = boost::filesystem::relative( link, test_base / "a_level_1", ec, Ops );
+        ::_exit( !ec && normalize( test_base / "a_level_1" / Relative ) == a_level_2 ? 0 : 1 );
+    }
+    int Status = 0;
+    ::waitpid( Child, &Status, 0 );
+    BOOST_REQUIRE( WIFEXITED( Status ) && WEXITSTATUS( Status ) == 0 );
+
+    // A later one finds its results
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file() );
+    BOOST_CHECK( Cache.capacity() == 64 );
+
+    counting_canonical_operations Counting;
+    boost::filesystem::shared_canonical_operations<counting_canonical_operations> Ops( Cache, Counting );
+    boost::system::error_code ec;
+    auto Relative = boost::filesystem::relative( link, test_base / "a_level_1", ec, Ops );
+    BOOST_CHECK( normalize( test_base / "a_level_1" / Relative ) == a_level_2 );
+    BOOST_CHECK( *Counting.Calls == 0 );
+
+    // As does another mapping in the same process
+    xstd::filesystem::shared_canonical_cache Other( shared_cache_file() );
+    path_t Result;
+    xstd::filesystem::file_identity Identity;
+    BOOST_REQUIRE( xstd::filesystem::file_identity::of( link, Identity ) );
+    BOOST_CHECK( Other.find( link, Identity, Result ) && Result == a_level_2 );
+
+    remove_all( test_base );
+    remove( shared_cache_file() );
+}
+
+
+void test_shared_canonical_cache_validation()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a = test_base / "a";
+    auto b = test_base / "b";
+    auto link = test_base / "link";
+
+    remove_all( test_base );
+    create_directories( a );
+    create_directories( b );
+    create_directory_symlink( a, link );
+    remove( shared_cache_file() );
+
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file(), 64 );
+    counting_canonical_operations Counting;
+    boost::filesystem::shared_canonical_operations<counting_canonical_operations> Ops( Cache, Counting );
+    boost::system::error_code ec;
+
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( a ) && *Counting.Calls == 1 );
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( a ) && *Counting.Calls == 1 );
+
+    // Retargeting the symlink
+    remove( link );
+    create_directory_symlink( b, link );
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( b ) && *Counting.Calls == 2 );
+
+    // Replacing the directory it resolves to
+    remove( b );
+    create_directories( b );
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( b ) && *Counting.Calls == 3 );
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( b ) && *Counting.Calls == 3 );
+
+    // Renaming it
+    rename( b, test_base / "c" );
+    create_directory_symlink( test_base / "c", b );
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( test_base / "c" ) && *Counting.Calls == 4 );
+
+    Cache.invalidate_all();
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( test_base / "c" ) && *Counting.Calls == 5 );
+
+    // Missing and relative paths are not cached
+    BOOST_CHECK( Ops.canonical( test_base / "missing", ec ).empty() && ec && *Counting.Calls == 6 );
+    Ops.canonical( ".", ec );
+    Ops.canonical( ".", ec );
+    BOOST_CHECK( *Counting.Calls == 8 );
+
+    // Nor are paths too long for a slot
+    auto Long = test_base / std::string( 200, 'l' ) / std::string( 200, 'l' ) / std::string( 200, 'l' );
+    create_directories( Long );
+    Ops.canonical( Long, ec );
+    Ops.canonical( Long, ec );
+    BOOST_CHECK( *Counting.Calls == 10 );
+
+    remove_all( test_base );
+    remove( shared_cache_file() );
+
+    // A file that is not a cache is refused
+    std::ofstream( shared_cache_file().c_str() ) << std::string( 100, 'x' );
+    BOOST_CHECK_THROW( xstd::filesystem::shared_canonical_cache Refused( shared_cache_file() ), boost::filesystem::filesystem_error );
+    remove( shared_cache_file() );
+}
+
+
+void test_shared_canonical_cache_invalidated_while_canonicalising()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto a = test_base / "a";
+    auto link = test_base / "link";
+
+    remove_all( test_base );
+    create_directories( a );
+    create_directory_symlink( a, link );
+    remove( shared_cache_file() );
+
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file(), 64 );
+    invalidating_canonical_operations Invalidating;
+    Invalidating.Cache = &Cache;
+    boost::filesystem::shared_canonical_operations<invalidating_canonical_operations> Ops( Cache, Invalidating );
+    boost::system::error_code ec;
+
+    // The result is inserted with the generation read before it was found,
+    // which `invalidate_all` has since passed, so it is never used
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( a ) && !ec && *Invalidating.Calls == 1 );
+
+    path_t Result;
+    xstd::filesystem::file_identity Identity;
+    BOOST_REQUIRE( xstd::filesystem::file_identity::of( link, Identity ) );
+    BOOST_CHECK( !Cache.find( link, Identity, Result ) );
+
+    BOOST_CHECK( Ops.canonical( link, ec ) == canonical( a ) && !ec && *Invalidating.Calls == 2 );
+
+    // Inserted with the current generation it is found
+    Cache.insert( link, Identity, canonical( a ), Cache.generation() );
+    BOOST_CHECK( Cache.find( link, Identity, Result ) && Result == canonical( a ) );
+
+    remove_all( test_base );
+    remove( shared_cache_file() );
+}
+
+
+void test_shared_canonical_cache_bucket()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    remove_all( test_base );
+    remove( shared_cache_file() );
+
+    std::vector<path_t> Paths;
+    for( int i = 0; i != 5; ++i )
+    {
+        Paths.push_back( test_base / ( "a_level_" + std::to_string( i ) ) );
+        create_directories( Paths.back() );
+    }
+
+    // One bucket, so every entry competes for the same slots
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file(), xstd::filesystem::shared_canonical_cache::bucket_size );
+    BOOST_CHECK( Cache.capacity() == xstd::filesystem::shared_canonical_cache::bucket_size );
+
+    // Empty slots are filled before any entry is replaced, and once the
+    // bucket is full the oldest entry is the one replaced, so the latest
+    // `bucket_size` entries are always found
+    const std::size_t Kept = xstd::filesystem::shared_canonical_cache::bucket_size;
+    std::vector<xstd::filesystem::file_identity> Identities( Paths.size() );
+    path_t Result;
+    for( std::size_t i = 0; i != Paths.size(); ++i )
+    {
+        BOOST_REQUIRE( xstd::filesystem::file_identity::of( Paths[i], Identities[i] ) );
+        Cache.insert( Paths[i], Identities[i], canonical( Paths[i] ), Cache.generation() );
+        for( std::size_t j = i + 1 > Kept ? i + 1 - Kept : 0; j <= i; ++j )
+        {
+            BOOST_CHECK_MESSAGE( Cache.find( Paths[j], Identities[j], Result ) && Result == canonical( Paths[j] ), Paths[j] << " after " << Paths[i] );
+        }
+    }
+    BOOST_CHECK( !Cache.find( Paths[0], Identities[0], Result ) );
+
+    remove_all( test_base );
+    remove( shared_cache_file() );
+}
+
+
+void test_shared_canonical_cache_abandoned_slot()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    remove_all( test_base );
+    remove( shared_cache_file() );
+
+    const std::size_t Slots = xstd::filesystem::shared_canonical_cache::bucket_size;
+
+    std::vector<path_t> Paths;
+    std::vector<xstd::filesystem::file_identity> Identities;
+    for( std::size_t i = 0; i != 4 * Slots; ++i )
+    {
+        Paths.push_back( test_base / ( "a_level_" + std::to_string( i ) ) );
+        create_directories( Paths.back() );
+        Identities.emplace_back();
+        BOOST_REQUIRE( xstd::filesystem::file_identity::of( Paths.back(), Identities.back() ) );
+    }
+
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file(), Slots );
+    Cache.insert( Paths[0], Identities[0], canonical( Paths[0] ), Cache.generation() );
+
+    // Leave the first slot, which the first entry went into, locked as a
+    // writer killed part way through would. Slots follow the 64 byte
+    // header and begin with their sequence.
+    {
+        std::uint32_t Sequence = 3;
+        int Fd = ::open( shared_cache_file().c_str(), O_RDWR );
+        BOOST_REQUIRE( Fd >= 0 );
+        BOOST_REQUIRE( ::pwrite( Fd, &Sequence, sizeof( Sequence ), 64 ) == sizeof( Sequence ) );
+        ::close( Fd );
+    }
+
+    // The locked slot is never chosen, so the other slots keep taking the
+    // latest entries, until enough have been inserted for it to be taken
+    // as abandoned and the whole bucket is in use again
+    path_t Result;
+    for( std::size_t i = 1; i != Paths.size(); ++i )
+    {
+        Cache.insert( Paths[i], Identities[i], canonical( Paths[i] ), Cache.generation() );
+        std::size_t Kept = i > 2 * Slots ? Slots : Slots - 1;
+        for( std::size_t j = i + 1 > Kept ? i + 1 - Kept : 1; j <= i; ++j )
+        {
+            BOOST_CHECK_MESSAGE( Cache.find( Paths[j], Identities[j], Result ) && Result == canonical( Paths[j] ), Paths[j] << " after " << Paths[i] );
+        }
+    }
+
+    remove_all( test_base );
+    remove( shared_cache_file() );
+}
+
+
+//! Compares `relative` with and without the cache, asking twice so that the
+//! second answer comes from the cache
+void shared_cache_relative_check( const path_t& Path, const path_t& Start )
+{
+    test_relative( Path, Start );
+
+    xstd::filesystem::shared_canonical_cache Cache( shared_cache_file() );
+    boost::filesystem::shared_canonical_operations<> Ops( Cache );
+
+    boost::system::error_code ec;
+    auto Expected = boost::filesystem::relative( Path, Start, ec );
+    BOOST_CHECK( boost::filesystem::relative( Path, Start, ec, Ops ) == Expected );
+    BOOST_CHECK( boost::filesystem::relative( Path, Start, ec, Ops ) == Expected );
+}
+
+
+template<class Scenario>
+void run_with_shared_cache( Scenario Run )
+{
+    remove( shared_cache_file() );
+    Run( shared_cache_relative_check );
+    remove( shared_cache_file() );
+}
+
+
+void test_shared_cache_real_relative_paths()
+{
+    run_with_shared_cache( test_real_relative_paths );
+}
+
+
+void test_shared_cache_multiple_nested_symlinks()
+{
+    run_with_shared_cache( multiple_nested_symlinks );
+}
+
+
+void test_shared_cache_real_and_imaginary_relative_paths()
+{
+    run_with_shared_cache( test_real_and_imaginary_relative_paths );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_SHARED_CANONICAL_CACHE_TESTS_HPP_INCLUDED
@@ -0,0 +1,224 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_SYMLINK_FREE_TREES_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_SYMLINK_FREE_TREES_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+#include "filesystem/symlink_free_trees.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+template<class Scenario>
+void run_with_symlink_free_trees( Scenario Run )
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    // Checked on every lookup so the symlinks each scenario creates part
+    // way through are seen straight away
+    auto Trees = std::make_shared<xstd::filesystem::symlink_free_trees>( std::chrono::seconds( 0 ) );
+    auto Lexical = std::make_shared<int>( 0 );
+
+    Run( [=]( const path_t& Path, const path_t& Start )
+    {
+        test_relative( Path, Start );
+
+        // The whole tree until it holds a symlink, and each branch of it
+        // that does not
+        boost::system::error_code ec;
+        Trees->add( test_base, ec );
+        for( boost::filesystem::directory_iterator Branch( test_base, ec ), End; Branch != End; ++Branch )
+        {
+            Trees->add( Branch->path(), ec );
+        }
+
+        counting_operations Counting;
+        boost::filesystem::symlink_free_operations<counting_operations> Ops( *Trees, Counting );
+
+        auto Expected = boost::filesystem::relative( Path, Start, ec );
+
+        boost::system::error_code lexical_ec;
+        auto Relative = boost::filesystem::relative( Path, Start, lexical_ec, Ops );
+
+        BOOST_CHECK_MESSAGE( Relative == Expected, "From " << Start << " to " << Path << ": " << Relative << " != " << Expected );
+        BOOST_CHECK( lexical_ec == ec );
+
+        if( Trees->locate( Path ).covered && Trees->locate( Start ).covered )
+        {
+            BOOST_CHECK( *Counting.Probes == 0 );
+            ++*Lexical;
+        }
+    } );
+
+    BOOST_CHECK( *Lexical != 0 );
+}
+
+
+void test_symlink_free_real_and_imaginary_relative_paths()
+{
+    run_with_symlink_free_trees( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_symlink_free_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_with_symlink_free_trees( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+void test_symlink_free_locate()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+    auto file = a_level_1 / "file";
+
+    create_directories( a_level_2 );
+    boost::filesystem::ofstream( file ) << "file";
+
+    xstd::filesystem::symlink_free_trees Trees( std::chrono::hours( 1 ) );
+
+    boost::system::error_code ec;
+    BOOST_CHECK( Trees.add( test_base, ec ) );
+
+    auto Real = canonical( test_base );
+
+    auto Location = Trees.locate( a_level_2 / ".." / "." );
+    BOOST_CHECK( Location.covered && Location.exists && Location.is_directory );
+    BOOST_CHECK( Location.real_path == Real / "a_level_1" );
+
+    Location = Trees.locate( file );
+    BOOST_CHECK( Location.covered && Location.exists && !Location.is_directory );
+
+    // Resolving through a file fails, so these do not exist
+    BOOST_CHECK( !Trees.locate( file / "." ).exists );
+    BOOST_CHECK( !Trees.locate( file / "x" / ".." ).exists );
+    BOOST_CHECK( Trees.locate( file / "x" / ".." ).real_path == Real / "a_level_1" / "file" );
+
+    Location = Trees.locate( a_level_2 / "imaginary" / ".." / "x" );
+    BOOST_CHECK( Location.covered && !Location.exists );
+    BOOST_CHECK( Location.real_path == Real / "a_level_1" / "a_level_2" / "x" );
+
+    // Leaving the tree is not covered, even to come back into it
+    BOOST_CHECK( !Trees.locate( test_base / ".." / "test_level_0" ).covered );
+    BOOST_CHECK( !Trees.locate( a_level_1 / ".." / ".." ).covered );
+    BOOST_CHECK( !Trees.locate( "test_level_0" ).covered );
+
+    // A file as `start` is an error, as it is for `relative`
+    boost::filesystem::symlink_free_operations<> Ops( Trees );
+    BOOST_CHECK( boost::filesystem::relative( a_level_2, file, ec, Ops ).empty() );
+    BOOST_CHECK( ec == boost::system::errc::not_a_directory );
+
+    // Changes are not seen until the tree is next checked
+    create_directories( a_level_2 / "new" );
+    BOOST_CHECK( !Trees.locate( a_level_2 / "new" ).exists );
+
+    BOOST_CHECK( Trees.remove( test_base ) );
+    BOOST_CHECK( !Trees.remove( test_base ) );
+    BOOST_CHECK( !Trees.locate( a_level_1 ).covered );
+
+    remove_all( test_base );
+}
+
+
+void test_symlink_free_staleness()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    auto a_level_2 = a_level_1 / "a_level_2";
+
+    create_directories( a_level_1 );
+
+    xstd::filesystem::symlink_free_trees Trees( std::chrono::seconds( 0 ) );
+
+    boost::system::error_code ec;
+    BOOST_CHECK( Trees.add( test_base, ec ) );
+    BOOST_CHECK( !Trees.locate( a_level_2 ).exists );
+
+    // A modified directory is rescanned on the next lookup
+    create_directories( a_level_2 );
+    BOOST_CHECK( Trees.locate( a_level_2 ).exists );
+
+    // and the tree dropped once it holds a symlink
+    create_directory_symlink( a_level_1, a_level_2 / "link" );
+    BOOST_CHECK( !Trees.locate( a_level_2 ).covered );
+    BOOST_CHECK( Trees.size() == 0 );
+
+    BOOST_CHECK( !Trees.add( test_base, ec ) );
+    BOOST_CHECK( !ec );
+
+    BOOST_CHECK( !Trees.add( test_base / "missing", ec ) );
+    BOOST_CHECK( ec );
+
+    remove_all( test_base );
+}
+
+
+void test_symlink_free_rescan_after_remove()
+{
+    path_t test_base = boost::filesystem::current_path() / "test_level_0";
+
+    auto a_level_1 = test_base / "a_level_1";
+    for( int i = 0; i != 64; ++i )
+    {
+        create_directories( test_base / ( "b_level_1_" + std::to_string( i ) ) );
+    }
+    create_directories( a_level_1 );
+
+    xstd::filesystem::symlink_free_trees Trees( std::chrono::seconds( 0 ) );
+
+    // A lookup that found the tree before it was removed, and rescans it
+    // because it was modified, must not register it again
+    for( int Round = 0; Round != 50; ++Round )
+    {
+        boost::system::error_code ec;
+        BOOST_REQUIRE( Trees.add( test_base, ec ) );
+
+        std::atomic<bool> Stop{ false };
+        std::thread Lookup( [&]()
+        {
+            while( !Stop.load() )
+            {
+                Trees.locate( a_level_1 / "a_level_2" );
+            }
+        } );
+
+        for( int i = 0; i != 4; ++i )
+        {
+            create_directory( a_level_1 / "a_level_2" );
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+            remove( a_level_1 / "a_level_2" );
+        }
+        Trees.remove( test_base );
+
+        Stop.store( true );
+        Lookup.join();
+        BOOST_CHECK( Trees.size() == 0 );
+    }
+
+    remove_all( test_base );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_SYMLINK_FREE_TREES_TESTS_HPP_INCLUDED
@@ -0,0 +1,273 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_SYMLINK_REWRITER_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_SYMLINK_REWRITER_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operations.hpp"
+#include "filesystem/symlink_rewriter.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// POSIX Includes
+#include <unistd.h>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Build an install tree below `test_level_0/stage` whose links name their
+//! targets absolutely, returning what each link resolves to
+std::map<path_t, path_t> make_staged_tree( const path_t& test_base )
+{
+    auto stage = test_base / "stage";
+    auto lib = stage / "usr" / "lib";
+    auto include = stage / "usr" / "include" / "x";
+    auto bin = stage / "usr" / "bin";
+
+    remove_all( test_base );
+    create_directories( lib );
+    create_directories( include );
+    create_directories( bin );
+    create_directories( stage / "opt" / "x" / "share" );
+    std::ofstream( ( lib / "libx.so.1.2" ).c_str() ) << "x";
+    std::ofstream( ( bin / "x" ).c_str() ) << "x";
+
+    // A chain of links to a library, a link to a directory, one through a
+    // linked directory, one that is already relative and one to `/`
+    create_symlink( lib / "libx.so.1.2", lib / "libx.so.1" );
+    create_symlink( lib / "libx.so.1", lib / "libx.so" );
+    create_directory_symlink( include, stage / "opt" / "x" / "include" );
+    create_symlink( stage / "opt" / "x" / "include" / ".." / ".." / ".." / "usr" / "bin" / "x", stage / "opt" / "x" / "share" / "x" );
+    create_symlink( "../bin/x", lib / "x" );
+    create_directory_symlink( "/", stage / "opt" / "root" );
+
+    std::map<path_t, path_t> Resolved;
+    for( boost::filesystem::recursive_directory_iterator Entry( stage ), End; Entry != End; ++Entry )
+    {
+        if( is_symlink( Entry->symlink_status() ) )
+        {
+            Entry.no_push();
+            Resolved[ Entry->path() ] = canonical( Entry->path() );
+        }
+    }
+    return Resolved;
+}
+
+
+void test_relativise_symlinks()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto Resolved = make_staged_tree( test_base );
+    auto stage = test_base / "stage";
+    auto lib = stage / "usr" / "lib";
+
+    // A dry run changes nothing
+    xstd::filesystem::relativise_options Options;
+    Options.dry_run = true;
+    Options.threads = 4;
+    auto DryRun = xstd::filesystem::relativise_symlinks( stage, Options );
+    BOOST_REQUIRE( DryRun.size() == 5 );
+    for( const auto& Rewrite : DryRun )
+    {
+        BOOST_CHECK( !Rewrite.ec );
+        BOOST_CHECK( read_symlink( Rewrite.link ) == Rewrite.old_target );
+        BOOST_CHECK( Rewrite.old_target.is_absolute() );
+        BOOST_CHECK( Rewrite.new_target.is_relative() );
+    }
+
+    Options.dry_run = false;
+    auto Rewrites = xstd::filesystem::relativise_symlinks( stage, Options );
+    BOOST_REQUIRE( Rewrites.size() == DryRun.size() );
+    for( std::size_t Rewrite = 0; Rewrite != Rewrites.size(); ++Rewrite )
+    {
+        BOOST_CHECK( Rewrites[Rewrite].link == DryRun[Rewrite].link );
+        BOOST_CHECK( Rewrites[Rewrite].new_target == DryRun[Rewrite].new_target );
+        BOOST_CHECK( !Rewrites[Rewrite].ec );
+    }
+
+    // Every link resolves where it did, and says how relatively
+    for( const auto& Link : Resolved )
+    {
+        BOOST_CHECK( canonical( Link.first ) == Link.second );
+        BOOST_CHECK( read_symlink( Link.first ).is_relative() );
+    }
+    BOOST_CHECK( read_symlink( lib / "libx.so" ) == "libx.so.1" );
+    BOOST_CHECK( read_symlink( lib / "libx.so.1" ) == "libx.so.1.2" );
+    BOOST_CHECK( read_symlink( stage / "opt" / "x" / "include" ) == "../../usr/include/x" );
+    BOOST_CHECK( read_symlink( stage / "opt" / "x" / "share" / "x" ) == "../../../usr/bin/x" );
+    BOOST_CHECK( read_symlink( lib / "x" ) == "../bin/x" );
+
+    // No temporary links are left behind
+    for( boost::filesystem::recursive_directory_iterator Entry( stage ), End; Entry != End; ++Entry )
+    {
+        BOOST_CHECK( Entry->path().filename().native().find( ".relativise." ) == std::string::npos );
+    }
+
+    // Nothing is left to do
+    BOOST_CHECK( xstd::filesystem::relativise_symlinks( stage, Options ).empty() );
+
+    boost::system::error_code ec;
+    BOOST_CHECK( xstd::filesystem::relativise_symlinks( test_base / "missing", Options, ec ).empty() && ec );
+    BOOST_CHECK_THROW( xstd::filesystem::relativise_symlinks( test_base / "missing", Options ), boost::filesystem::filesystem_error );
+
+    remove_all( test_base );
+}
+
+
+void test_replace_symlink_keeps_existing_files()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto link = test_base / "link";
+    auto Taken = "." + link.filename().native() + ".relativise." + std::to_string( ::getpid() );
+
+    remove_all( test_base );
+    create_directories( test_base / "a" );
+    create_directory_symlink( test_base / "a", link );
+
+    // Names a temporary link would take that already belong to someone
+    std::ofstream( ( test_base / Taken ).c_str() ) << "user";
+    create_symlink( "elsewhere", test_base / ( Taken + ".1" ) );
+
+    boost::system::error_code ec;
+    xstd::filesystem::replace_symlink( link, "a", ec );
+    BOOST_CHECK( !ec );
+    BOOST_CHECK( read_symlink( link ) == "a" );
+
+    // Both are left as they were and nothing else remains
+    std::string Content;
+    std::ifstream( ( test_base / Taken ).c_str() ) >> Content;
+    BOOST_CHECK( Content == "user" );
+    BOOST_CHECK( read_symlink( test_base / ( Taken + ".1" ) ) == "elsewhere" );
+    BOOST_CHECK( !exists( symlink_status( test_base / ( Taken + ".2" ) ) ) );
+
+    remove_all( test_base );
+}
+
+
+void test_relativise_staged_symlinks()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto stage = test_base / "stage";
+    auto lib = stage / "usr" / "lib";
+
+    remove_all( test_base );
+    create_directories( lib / "x" );
+    std::ofstream( ( lib / "libx.so.1" ).c_str() ) << "x";
+
+    // Links name where their targets will be installed, and some of those
+    // do not exist yet
+    create_symlink( "/usr/lib/libx.so.1", lib / "libx.so" );
+    create_symlink( "/usr/share/x/data", lib / "x" / "data" );
+
+    xstd::filesystem::relativise_options Options;
+    Options.root = stage;
+    Options.threads = 2;
+    auto Rewrites = xstd::filesystem::relativise_symlinks( stage, Options );
+    BOOST_REQUIRE( Rewrites.size() == 2 );
+    BOOST_CHECK( !Rewrites[0].ec && !Rewrites[1].ec );
+
+    BOOST_CHECK( read_symlink( lib / "libx.so" ) == "libx.so.1" );
+    BOOST_CHECK( read_symlink( lib / "x" / "data" ) == "../../share/x/data" );
+    BOOST_CHECK( equivalent( lib / "libx.so", lib / "libx.so.1" ) );
+
+    remove_all( test_base );
+}
+
+
+void test_relativise_nested_staged_symlinks()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto stage = test_base / "stage";
+    auto usr = stage / "usr";
+
+    remove_all( test_base );
+    create_directories( usr / "lib" );
+    create_directories( usr / "bin" );
+    std::ofstream( ( usr / "lib" / "libfoo.so" ).c_str() ) << "foo";
+
+    // A link through another staged link, both naming installed locations,
+    // which must be resolved in the stage rather than on this host
+    create_directory_symlink( "/usr/lib", usr / "lib64" );
+    create_symlink( "/usr/lib64/libfoo.so", usr / "bin" / "foo" );
+
+    xstd::filesystem::relativise_options Options;
+    Options.root = stage;
+    Options.threads = 2;
+    Options.dry_run = true;
+    auto DryRun = xstd::filesystem::relativise_symlinks( usr, Options );
+    BOOST_REQUIRE( DryRun.size() == 2 );
+    BOOST_CHECK( DryRun[0].link == usr / "bin" / "foo" && DryRun[0].new_target == "../lib/libfoo.so" && !DryRun[0].ec );
+    BOOST_CHECK( DryRun[1].link == usr / "lib64" && DryRun[1].new_target == "lib" && !DryRun[1].ec );
+
+    Options.dry_run = false;
+    auto Rewrites = xstd::filesystem::relativise_symlinks( usr, Options );
+    BOOST_REQUIRE( Rewrites.size() == DryRun.size() );
+    for( std::size_t Rewrite = 0; Rewrite != Rewrites.size(); ++Rewrite )
+    {
+        BOOST_CHECK( Rewrites[Rewrite].link == DryRun[Rewrite].link );
+        BOOST_CHECK( Rewrites[Rewrite].new_target == DryRun[Rewrite].new_target );
+        BOOST_CHECK( read_symlink( Rewrites[Rewrite].link ) == DryRun[Rewrite].new_target );
+        BOOST_CHECK( !Rewrites[Rewrite].ec );
+    }
+    BOOST_CHECK( equivalent( usr / "bin" / "foo", usr / "lib" / "libfoo.so" ) );
+
+    // A tree outside the root cannot be relativised from inside it
+    boost::system::error_code ec;
+    Options.root = usr / "lib";
+    BOOST_CHECK( xstd::filesystem::relativise_symlinks( usr, Options, ec ).empty() && ec == boost::system::errc::invalid_argument );
+    Options.root = test_base / "missing";
+    BOOST_CHECK( xstd::filesystem::relativise_symlinks( usr, Options, ec ).empty() && ec );
+
+    remove_all( test_base );
+}
+
+
+void test_relativise_many_symlinks()
+{
+    auto test_base = boost::filesystem::current_path() / "test_level_0";
+    auto target = test_base / "target";
+
+    remove_all( test_base );
+    create_directories( target );
+
+    const int Directories = 20;
+    const int Links = 50;
+    for( int Directory = 0; Directory != Directories; ++Directory )
+    {
+        auto Dir = test_base / "tree" / std::to_string( Directory % 4 ) / std::to_string( Directory );
+        create_directories( Dir );
+        for( int Link = 0; Link != Links; ++Link )
+        {
+            create_symlink( target / std::to_string( Link ), Dir / std::to_string( Link ) );
+        }
+    }
+
+    xstd::filesystem::relativise_options Options;
+    Options.threads = 8;
+    auto Rewrites = xstd::filesystem::relativise_symlinks( test_base / "tree", Options );
+    BOOST_REQUIRE( Rewrites.size() == Directories * Links );
+    for( std::size_t Rewrite = 0; Rewrite != Rewrites.size(); ++Rewrite )
+    {
+        BOOST_CHECK( !Rewrites[Rewrite].ec );
+        BOOST_CHECK( Rewrite == 0 || Rewrites[Rewrite - 1].link.native() < Rewrites[Rewrite].link.native() );
+        BOOST_CHECK( normalize( Rewrites[Rewrite].link.parent_path() / read_symlink( Rewrites[Rewrite].link ) ) == Rewrites[Rewrite].old_target );
+    }
+
+    remove_all( test_base );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_SYMLINK_REWRITER_TESTS_HPP_INCLUDED
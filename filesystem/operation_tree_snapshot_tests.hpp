@@ -0,0 +1,185 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef FILESYSTEM_OPERATION_TREE_SNAPSHOT_TESTS_HPP_INCLUDED
+#define FILESYSTEM_OPERATION_TREE_SNAPSHOT_TESTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+// Filesystem Includes
+#include "filesystem/operation_relative_tests.hpp"
+#include "filesystem/operations.hpp"
+#include "filesystem/tree_snapshot.hpp"
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <fstream>
+
+// I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I I
+
+
+using path_t = boost::filesystem::path_t;
+
+
+//! Builds the scenario trees below the canonical current path, as snapshots
+//! know nothing of symlinks above their root
+class canonical_scenario_filesystem : public scenario_filesystem
+{
+public:
+
+    path_t current_path() const override
+    {
+        return boost::filesystem::canonical( boost::filesystem::current_path() );
+    }
+};
+
+
+void test_tree_snapshot_resolution()
+{
+    auto Base = boost::filesystem::canonical( boost::filesystem::current_path() );
+    auto test_base = Base / "test_level_0";
+    auto Snapshot = Base / "test_level_0.snapshot";
+
+    create_directories( test_base / "a/b/c" );
+    std::ofstream( ( test_base / "a/b/c/file" ).c_str() );
+    create_directory_symlink( "../../b", test_base / "a/b/c/up" );
+    create_directory_symlink( test_base / "a/b/c", test_base / "link" );
+    create_symlink( "loop_2", test_base / "loop_1" );
+    create_symlink( "loop_1", test_base / "loop_2" );
+    create_symlink( "/", test_base / "top" );
+
+    BOOST_CHECK( xstd::filesystem::write_tree_snapshot( test_base, Snapshot ) == 10 );
+
+    xstd::filesystem::tree_snapshot Tree( Snapshot );
+    remove_all( test_base );
+
+    BOOST_CHECK( Tree.root() == test_base );
+    BOOST_CHECK( Tree.size() == 10 );
+
+    boost::system::error_code ec;
+    BOOST_CHECK( Tree.canonical( test_base / "link/up/c/file", ec ) == test_base / "a/b/c/file" && !ec );
+    BOOST_CHECK( Tree.canonical( test_base / "link/up/../b/./c", ec ) == test_base / "a/b/c" && !ec );
+    BOOST_CHECK( Tree.canonical( "link/up", ec ) == test_base / "a/b" && !ec );
+    BOOST_CHECK( Tree.is_directory( test_base / "link/up", ec ) );
+    BOOST_CHECK( Tree.exists( test_base / "link/file", ec ) && !Tree.is_directory( test_base / "link/file", ec ) );
+    BOOST_CHECK( Tree.is_symlink( test_base / "link", ec ) && !Tree.is_symlink( test_base / "a", ec ) );
+
+    BOOST_CHECK( !Tree.exists( test_base / "a/x", ec ) && !ec );
+    BOOST_CHECK( !Tree.exists( test_base / "link/file/x", ec ) && !ec );
+    BOOST_CHECK( Tree.canonical( test_base / "a/b/c/file/.", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Tree.canonical( test_base / "a/b/c/file/..", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Tree.canonical( ( test_base / "a/b/c/file" ).native() + "/", ec ).empty() && ec == boost::system::errc::not_a_directory );
+    BOOST_CHECK( Tree.canonical( ( test_base / "link" ).native() + "/", ec ) == test_base / "a/b/c" && !ec );
+    BOOST_CHECK( Tree.canonical( test_base / "a/x", ec ).empty() && ec == boost::system::errc::no_such_file_or_directory );
+    BOOST_CHECK( !Tree.exists( test_base / "loop_1", ec ) && ec == boost::system::errc::too_many_symbolic_link_levels );
+
+    // Outside the root only its ancestors exist
+    BOOST_CHECK( Tree.is_directory( "/", ec ) );
+    BOOST_CHECK( Tree.is_directory( Base, ec ) );
+    BOOST_CHECK( !Tree.exists( Base / "other", ec ) && !ec );
+    BOOST_CHECK( Tree.canonical( test_base / "top" / test_base.relative_path() / "a", ec ) == test_base / "a" );
+    BOOST_CHECK( Tree.canonical( test_base / "../test_level_0/a/..", ec ) == test_base );
+
+    boost::filesystem::snapshot_operations Ops( Tree );
+    auto Relative = boost::filesystem::relative( test_base / "link/file", test_base / "link/up", ec, Ops );
+    BOOST_CHECK( normalize( test_base / "a/b" / Relative ) == test_base / "a/b/c/file" );
+
+    // Relative arguments are taken from the root, not the current directory
+    BOOST_CHECK( boost::filesystem::relative( "link/file", "a", ec, Ops ) == "./b/c/file" && !ec );
+    BOOST_CHECK( boost::filesystem::relative( "a/b/c", "link/up/..", ec, Ops ) == "./b/c" && !ec );
+    BOOST_CHECK( boost::filesystem::weakly_canonical( "link/x", ec, Ops ) == test_base / "a/b/c/x" && !ec );
+
+    remove( Snapshot );
+}
+
+
+void test_tree_snapshot_rejects_other_files()
+{
+    auto Base = boost::filesystem::canonical( boost::filesystem::current_path() );
+    auto Snapshot = Base / "test_level_0.snapshot";
+
+    BOOST_CHECK_THROW( xstd::filesystem::tree_snapshot Tree( Snapshot ), boost::filesystem::filesystem_error );
+
+    std::ofstream( Snapshot.c_str() ) << "not a snapshot, but longer than the header of one";
+    BOOST_CHECK_THROW( xstd::filesystem::tree_snapshot Tree( Snapshot ), boost::filesystem::filesystem_error );
+
+    // A snapshot cut short
+    create_directories( Base / "test_level_0/a" );
+    xstd::filesystem::write_tree_snapshot( Base / "test_level_0", Snapshot );
+    remove_all( Base / "test_level_0" );
+    boost::filesystem::resize_file( Snapshot, sizeof( xstd::filesystem::snapshot_header ) + 4 );
+    BOOST_CHECK_THROW( xstd::filesystem::tree_snapshot Tree( Snapshot ), boost::filesystem::filesystem_error );
+
+    remove( Snapshot );
+
+    boost::system::error_code ec;
+    xstd::filesystem::write_tree_snapshot( Base / "test_level_0", Snapshot, ec );
+    BOOST_CHECK( ec == boost::system::errc::no_such_file_or_directory );
+}
+
+
+//! Compares `relative` answered from a snapshot of the scenario tree, taken
+//! afresh for each pair, with `relative` on disk
+void snapshot_relative_check( const path_t& Path, const path_t& Start )
+{
+    auto Base = boost::filesystem::canonical( boost::filesystem::current_path() );
+    auto Snapshot = Base / "test_level_0.snapshot";
+
+    xstd::filesystem::write_tree_snapshot( Base / "test_level_0", Snapshot );
+    xstd::filesystem::tree_snapshot Tree( Snapshot );
+
+    boost::system::error_code OnDiskEc;
+    boost::system::error_code FromSnapshotEc;
+    auto OnDisk = boost::filesystem::relative( Path, Start, OnDiskEc );
+    auto FromSnapshot = boost::filesystem::relative( Path, Start, FromSnapshotEc, boost::filesystem::snapshot_operations( Tree ) );
+
+    BOOST_CHECK_MESSAGE( OnDisk == FromSnapshot, "From " << Start << " to " << Path << ": " << OnDisk << " != " << FromSnapshot );
+    BOOST_CHECK_MESSAGE( !OnDiskEc == !FromSnapshotEc, "From " << Start << " to " << Path << ": " << OnDiskEc.message() << " != " << FromSnapshotEc.message() );
+
+    remove( Snapshot );
+}
+
+
+template<class Scenario>
+void run_from_snapshot( Scenario Run )
+{
+    canonical_scenario_filesystem Canonical;
+    scenario_filesystem_guard Guard( Canonical );
+
+    Run( snapshot_relative_check );
+}
+
+
+void test_snapshot_real_relative_paths()
+{
+    run_from_snapshot( test_real_relative_paths );
+}
+
+
+void test_snapshot_multiple_nested_symlinks()
+{
+    run_from_snapshot( multiple_nested_symlinks );
+}
+
+
+void test_snapshot_real_and_imaginary_relative_paths()
+{
+    run_from_snapshot( test_real_and_imaginary_relative_paths );
+}
+
+
+void test_snapshot_real_and_imaginary_relative_paths_with_parent_and_current_directories()
+{
+    run_from_snapshot( test_real_and_imaginary_relative_paths_with_parent_and_current_directories );
+}
+
+
+void test_snapshot_relative_paths_through_files()
+{
+    run_from_snapshot( test_relative_paths_through_files );
+}
+
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif//FILESYSTEM_OPERATION_TREE_SNAPSHOT_TESTS_HPP_INCLUDED
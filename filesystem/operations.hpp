@@ -10,8 +10,10 @@
 #include <boost/filesystem.hpp>
 
 // C++ Standard Library Includes
+#include <array>
 #include <initializer_list>
 #include <functional>
+#include <vector>
 
 
 // n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
@@ -309,103 +311,291 @@ lexically_relative( const path_t& p, const path_t& start )
 }
 
 
-//! \brief Return a relative path to `p` from the current
-//!        directory or from an optional `start` path.
-//!
-//! \param  `p` - the path we want a relative path to
-//!
-//! \param  `start` - the path that we want the relative path from
-//!
-//! \return A relative path, if the paths share a common 'root-name',
-//!         otherwise `path()`. The relative path returned will satisfy
-//!         the conditions shown in the following list. The common
-//!         path is the common path that is shared between `p` and `start`.
-//!         `rel_p` and `rel_start` are the divergent relative paths that
-//!         remain after the common path is removed.
-//!
-//!         * if `exists(start)`
-//!           * if `exists(p)` then `equivalent(start/relative(p,start),p) == true`
-//!           * else `normalize(canonical(start)/relative(p,start)) == canonical(common)/normalize(rel_p)`
-//!         * else
-//!           * if `exists(p)` then `normalize(canonical(common)/rel_start)/relative(p,start)) == canonical(p)`
-//!           * else `normalize(start/relative(p,start)) == normalize(p)`
+//! \brief  The filesystem queries made by `relative`, answered by calling
+//!         the corresponding Boost.Filesystem operations.
 //!
-//! \throw As specified in Error reporting.
-//!
-//! \note `exists(start) && !is_directory(start)` is an error.
-inline
-path_t
-relative( const path_t& p, const path_t& start, boost::system::error_code& ec )
+//!         Other types providing the same four const member functions can
+//!         be passed to the `relative` and `proximate` overloads taking an
+//!         `ops` argument, for example to cache or redirect the queries.
+//!         Such types must be safe to call concurrently if `relative` is
+//!         called concurrently with the same object.
+struct system_operations
 {
-    auto real_p = p;
-    auto real_start = start;
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return boost::filesystem::exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return boost::filesystem::is_directory( p, ec );
+    }
 
-    if( real_p.is_relative() )
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
     {
-        real_p = absolute( real_p );
+        return boost::filesystem::canonical( p, ec );
     }
-    if( real_start.is_relative() )
+
+    //! The directory relative arguments are made absolute from
+    path_t current_path( boost::system::error_code& ec ) const
     {
-        real_start = absolute( real_start );
+        return boost::filesystem::current_path( ec );
     }
+};
 
-    auto rel_p = normalize( real_p );
-    auto rel_start = normalize( real_start );
-    auto common_path = remove_common_prefix( rel_p, rel_start );
 
-    bool path_exists = exists( common_path );
-    if( ec )
+// Helper function to make implementation easier - not part of the proposal
+
+//! Return `p` made absolute from `ops.current_path()` if it is relative
+template<class Operations>
+path_t
+absolute_helper( const path_t& p, boost::system::error_code& ec, const Operations& ops )
+{
+    if( !p.is_relative() )
     {
-        ec.clear();
+        return p;
     }
-    if( path_exists )
+    auto base = ops.current_path( ec );
+    if( ec )
     {
-        common_path = canonical( common_path, ec );
-        if( ec )
-        {
-            return path_t();
-        }
+        return path_t();
     }
+    return absolute( p, base );
+}
 
-    path_exists = exists( start, ec );
-    if( ec )
+
+//! Return `normalize( canonical( a ) / r )` where `a` is the deepest existing
+//! ancestor of `p` and `r` the remainder of `p` below it, given that `p`
+//! itself does not exist. Resolving a prefix walks through every shorter
+//! prefix, so existence is monotonic in depth and a binary search finds `a`.
+template<class Operations>
+path_t
+weakly_canonical_helper( const path_t& p, boost::system::error_code& ec, const Operations& ops )
+{
+    std::vector<path_t> Elements;
+    std::vector<std::size_t> Sizes;
+    path_t Prefix;
+    for( const auto& Element: p )
     {
-        ec.clear();
+        Prefix /= Element;
+        Elements.push_back( Element );
+        Sizes.push_back( Prefix.native().size() );
     }
-    if( path_exists )
+
+    // Invariant: the prefix of depth `Found` exists, that of depth `Missing`
+    // does not. The empty prefix is taken to exist.
+    std::size_t Found   = 0;
+    std::size_t Missing = Elements.size();
+    while( Missing - Found > 1 )
     {
-        if( !is_directory( start ) )
+        std::size_t Depth = Found + ( Missing - Found ) / 2;
+        bool path_exists = ops.exists( path_t( Prefix.native().substr( 0, Sizes[Depth - 1] ) ), ec );
+        if( ec )
         {
-            ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
-            return path_t();
+            ec.clear();
+        }
+        if( path_exists )
+        {
+            Found = Depth;
         }
-        real_start = canonical( real_start, ec );
+        else
+        {
+            Missing = Depth;
+        }
+    }
+
+    path_t real_p;
+    if( Found )
+    {
+        real_p = ops.canonical( path_t( Prefix.native().substr( 0, Sizes[Found - 1] ) ), ec );
         if( ec )
         {
             return path_t();
         }
     }
-    else
+    for( std::size_t Depth = Found; Depth != Elements.size(); ++Depth )
     {
-        real_start = common_path / rel_start;
+        real_p /= Elements[Depth];
     }
+    return normalize( real_p );
+}
+
 
-    path_exists = exists( p, ec );
+//! Return the path `relative` compares against for the absolute path `p`:
+//! `canonical( p )` if it exists, otherwise `weakly_canonical_helper( p )`
+template<class Operations>
+path_t
+real_path_helper( const path_t& p, boost::system::error_code& ec, const Operations& ops )
+{
+    bool path_exists = ops.exists( p, ec );
     if( ec )
     {
         ec.clear();
     }
     if( path_exists )
     {
-        real_p = canonical( p, ec );
-        if( ec )
-        {
-            return path_t();
-        }
+        return ops.canonical( p, ec );
+    }
+    return weakly_canonical_helper( p, ec, ops );
+}
+
+
+//! As `real_path_helper` for the absolute start path of `relative`, which
+//! if it exists must be a directory
+template<class Operations>
+path_t
+real_start_helper( const path_t& start, boost::system::error_code& ec, const Operations& ops )
+{
+    bool path_exists = ops.exists( start, ec );
+    if( ec )
+    {
+        ec.clear();
+    }
+    if( !path_exists )
+    {
+        return weakly_canonical_helper( start, ec, ops );
+    }
+    bool start_is_directory = ops.is_directory( start, ec );
+    if( ec )
+    {
+        return path_t();
+    }
+    if( !start_is_directory )
+    {
+        ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+        return path_t();
+    }
+    return ops.canonical( start, ec );
+}
+
+
+//! \brief  Return `p` with its deepest existing ancestor made canonical and
+//!         the remainder, which cannot contain symlinks, normalized
+//!
+//! \param  `p` - the path we want a canonical path of
+//!
+//! \param  `ops` - the object used to query the filesystem, see `system_operations`
+//!
+//! \return `canonical( p )` if `exists( p )`, otherwise
+//!         `normalize( canonical( a ) / r )` where `a` is the deepest
+//!         existing ancestor of `p` and `r` is the remainder of `p`.
+//!         A relative `p` is first made absolute from `ops.current_path()`.
+//!
+//! \throw As specified in Error reporting.
+//!
+//! \note  The deepest existing ancestor is found with a binary search over
+//!        the depth of `p`, making O(log depth) calls to `exists`.
+template<class Operations>
+path_t
+weakly_canonical( const path_t& p, boost::system::error_code& ec, const Operations& ops )
+{
+    auto real_p = absolute_helper( p, ec, ops );
+    if( ec )
+    {
+        return path_t();
+    }
+    return real_path_helper( real_p, ec, ops );
+}
+
+
+//! \brief  Return `p` with its deepest existing ancestor made canonical and
+//!         the remainder, which cannot contain symlinks, normalized
+//!
+//! \param  `p` - the path we want a canonical path of
+//!
+//! \return `canonical( p )` if `exists( p )`, otherwise
+//!         `normalize( canonical( a ) / r )` where `a` is the deepest
+//!         existing ancestor of `p` and `r` is the remainder of `p`.
+//!         A relative `p` is first made absolute.
+//!
+//! \throw As specified in Error reporting.
+inline
+path_t
+weakly_canonical( const path_t& p, boost::system::error_code& ec )
+{
+    return weakly_canonical( p, ec, system_operations() );
+}
+
+
+//! \brief  Return `p` with its deepest existing ancestor made canonical and
+//!         the remainder, which cannot contain symlinks, normalized
+//!
+//! \param  `p` - the path we want a canonical path of
+//!
+//! \return `canonical( p )` if `exists( p )`, otherwise
+//!         `normalize( canonical( a ) / r )` where `a` is the deepest
+//!         existing ancestor of `p` and `r` is the remainder of `p`.
+//!         A relative `p` is first made absolute.
+//!
+//! \throw As specified in Error reporting.
+inline
+path_t
+weakly_canonical( const path_t& p )
+{
+    boost::system::error_code local_ec;
+    auto result = weakly_canonical( p, local_ec );
+    if( local_ec )
+    {
+        BOOST_FILESYSTEM_THROW
+        (   boost::filesystem::filesystem_error
+            (   "boost::filesystem::weakly_canonical",
+                p,
+                local_ec   )   );
+    }
+    return result;
+}
+
+
+//! \brief Return a relative path to `p` from the current
+//!        directory or from an optional `start` path.
+//!
+//! \param  `p` - the path we want a relative path to
+//!
+//! \param  `start` - the path that we want the relative path from
+//!
+//! \param  `ops` - the object used to query the filesystem, see `system_operations`
+//!
+//! \return A relative path, if the paths share a common 'root-name',
+//!         otherwise `path()`. The relative path returned will satisfy
+//!         the conditions shown in the following list.
+//!
+//!         * if `exists(start)`
+//!           * if `exists(p)` then `equivalent(start/relative(p,start),p) == true`
+//!           * else `normalize(canonical(start)/relative(p,start)) == weakly_canonical(p)`
+//!         * else
+//!           * if `exists(p)` then `normalize(weakly_canonical(start)/relative(p,start)) == canonical(p)`
+//!           * else `normalize(weakly_canonical(start)/relative(p,start)) == weakly_canonical(p)`
+//!
+//! \throw As specified in Error reporting.
+//!
+//! \note `exists(start) && !is_directory(start)` is an error.
+//!
+//! \note All filesystem queries are made through `ops`, including the
+//!       current directory relative arguments are made absolute from.
+template<class Operations>
+path_t
+relative( const path_t& p, const path_t& start, boost::system::error_code& ec, const Operations& ops )
+{
+    auto real_p = absolute_helper( p, ec, ops );
+    if( ec )
+    {
+        return path_t();
     }
-    else
+    auto real_start = absolute_helper( start, ec, ops );
+    if( ec )
     {
-        real_p = common_path / rel_p;
+        return path_t();
+    }
+
+    real_start = real_start_helper( real_start, ec, ops );
+    if( ec )
+    {
+        return path_t();
+    }
+    real_p = real_path_helper( real_p, ec, ops );
+    if( ec )
+    {
+        return path_t();
     }
     return lexically_relative( real_p, real_start );
 }
@@ -416,19 +606,45 @@ relative( const path_t& p, const path_t& start, boost::system::error_code& ec )
 //!
 //! \param  `p` - the path we want a relative path to
 //!
+//! \param  `start` - the path that we want the relative path from
+//!
 //! \return A relative path, if the paths share a common 'root-name',
 //!         otherwise `path()`. The relative path returned will satisfy
-//!         the conditions shown in the following list. The common
-//!         path is the common path that is shared between `p` and `start`.
-//!         `rel_p` and `rel_start` are the divergent relative paths that
-//!         remain after the common path is removed.
+//!         the conditions shown in the following list.
 //!
 //!         * if `exists(start)`
 //!           * if `exists(p)` then `equivalent(start/relative(p,start),p) == true`
-//!           * else `normalize(canonical(start)/relative(p,start)) == canonical(common)/normalize(rel_p)`
+//!           * else `normalize(canonical(start)/relative(p,start)) == weakly_canonical(p)`
 //!         * else
-//!           * if `exists(p)` then `normalize(canonical(common)/rel_start)/relative(p,start)) == canonical(p)`
-//!           * else `normalize(start/relative(p,start)) == normalize(p)`
+//!           * if `exists(p)` then `normalize(weakly_canonical(start)/relative(p,start)) == canonical(p)`
+//!           * else `normalize(weakly_canonical(start)/relative(p,start)) == weakly_canonical(p)`
+//!
+//! \throw As specified in Error reporting.
+//!
+//! \note `exists(start) && !is_directory(start)` is an error.
+inline
+path_t
+relative( const path_t& p, const path_t& start, boost::system::error_code& ec )
+{
+    return relative( p, start, ec, system_operations() );
+}
+
+
+//! \brief Return a relative path to `p` from the current
+//!        directory or from an optional `start` path.
+//!
+//! \param  `p` - the path we want a relative path to
+//!
+//! \return A relative path, if the paths share a common 'root-name',
+//!         otherwise `path()`. The relative path returned will satisfy
+//!         the conditions shown in the following list.
+//!
+//!         * if `exists(start)`
+//!           * if `exists(p)` then `equivalent(start/relative(p,start),p) == true`
+//!           * else `normalize(canonical(start)/relative(p,start)) == weakly_canonical(p)`
+//!         * else
+//!           * if `exists(p)` then `normalize(weakly_canonical(start)/relative(p,start)) == canonical(p)`
+//!           * else `normalize(weakly_canonical(start)/relative(p,start)) == weakly_canonical(p)`
 //!
 //! \throw As specified in Error reporting.
 inline
@@ -453,17 +669,14 @@ relative( const path_t& p, boost::system::error_code& ec )
 //!
 //! \return A relative path, if the paths share a common 'root-name',
 //!         otherwise `path()`. The relative path returned will satisfy
-//!         the conditions shown in the following list. The common
-//!         path is the common path that is shared between `p` and `start`.
-//!         `rel_p` and `rel_start` are the divergent relative paths that
-//!         remain after the common path is removed.
+//!         the conditions shown in the following list.
 //!
 //!         * if `exists(start)`
 //!           * if `exists(p)` then `equivalent(start/relative(p,start),p) == true`
-//!           * else `normalize(canonical(start)/relative(p,start)) == canonical(common)/normalize(rel_p)`
+//!           * else `normalize(canonical(start)/relative(p,start)) == weakly_canonical(p)`
 //!         * else
-//!           * if `exists(p)` then `normalize(canonical(common)/rel_start)/relative(p,start)) == canonical(p)`
-//!           * else `normalize(start/relative(p,start)) == normalize(p)`
+//!           * if `exists(p)` then `normalize(weakly_canonical(start)/relative(p,start)) == canonical(p)`
+//!           * else `normalize(weakly_canonical(start)/relative(p,start)) == weakly_canonical(p)`
 //!
 //! \throw As specified in Error reporting.
 //!
@@ -504,6 +717,29 @@ lexically_proximate( const path_t& p, const path_t& start )
 }
 
 
+//! \brief Return a proximate path to `p` from the current
+//!        directory or from an optional `start` path.
+//!
+//! \param  `p` - the path we want a proximate path to
+//!
+//! \param  `start` - the path that we want the proximate path from
+//!
+//! \param  `ops` - the object used to query the filesystem, see `system_operations`
+//!
+//! \return Returns as if by `relative( p, start, ec, ops ).empty() ? p : relative( p, start, ec, ops )`.
+//!
+//! \throw As specified in Error reporting.
+//!
+//! \note `exists(start) && !is_directory(start)` is an error.
+template<class Operations>
+path_t
+proximate( const path_t& p, const path_t& start, boost::system::error_code& ec, const Operations& ops )
+{
+    auto rel_path = relative( p, start, ec, ops );
+    return rel_path.empty() ? p : rel_path;
+}
+
+
 //! \brief Return a proximate path to `p` from the current
 //!        directory or from an optional `start` path.
 //!
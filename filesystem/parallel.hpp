@@ -0,0 +1,346 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_PARALLEL_HPP_INCLUDED
+#define XSTD_FILESYSTEM_PARALLEL_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// Boost Library Includes
+// None
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Threading helpers for the batch operations - not part of the proposal
+
+
+//! \brief  Return the number of threads to use when the caller asks for 0
+inline
+std::size_t
+default_thread_count()
+{
+    return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+
+//! \brief  Call `f( first, last )` over contiguous sub-ranges of [0,count)
+//!         using up to `threads` threads, one sub-range per thread.
+//!
+//!         The first exception thrown by any call is rethrown once all
+//!         threads have finished.
+template<class Function>
+void
+parallel_for( std::size_t Count, std::size_t Threads, Function f )
+{
+    if( Threads == 0 )
+    {
+        Threads = default_thread_count();
+    }
+    Threads = std::min( Threads, Count );
+
+    if( Threads <= 1 )
+    {
+        if( Count )
+        {
+            f( std::size_t( 0 ), Count );
+        }
+        return;
+    }
+
+    std::size_t ChunkSize = ( Count + Threads - 1 ) / Threads;
+
+    std::mutex          ErrorMutex;
+    std::exception_ptr  Error;
+
+    std::vector<std::thread> Workers;
+    Workers.reserve( Threads );
+
+    for( std::size_t First = 0; First < Count; First += ChunkSize )
+    {
+        std::size_t Last = std::min( Count, First + ChunkSize );
+        Workers.emplace_back( [&f, &ErrorMutex, &Error, First, Last]()
+        {
+            try
+            {
+                f( First, Last );
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> Lock( ErrorMutex );
+                if( !Error )
+                {
+                    Error = std::current_exception();
+                }
+            }
+        } );
+    }
+    for( auto& Worker: Workers )
+    {
+        Worker.join();
+    }
+    if( Error )
+    {
+        std::rethrow_exception( Error );
+    }
+}
+
+
+//! \brief  What one thread of `work_stealing_for` did
+struct worker_statistics
+{
+    //! The number of indices the thread processed
+    std::size_t                 items = 0;
+
+    //! The number of times the thread took work from another
+    std::size_t                 steals = 0;
+
+    //! The time the thread spent inside calls to the function
+    std::chrono::nanoseconds    busy{ 0 };
+
+    //! `busy` as a fraction of the time the whole call took
+    double                      utilisation = 0;
+};
+
+
+//! \brief  Call `f( first, last )` over sub-ranges of [0,count) using up to
+//!         `threads` threads, balancing uneven work by stealing.
+//!
+//!         Each thread starts with an equal contiguous share and takes
+//!         `grain` indices at a time from the front of it. A thread that
+//!         runs out steals the back half of the largest remaining share, so
+//!         threads stay busy when some indices cost far more than others.
+//!         A share is a pair of indices packed into one atomic word so both
+//!         taking and stealing are a single compare-and-swap.
+//!
+//!         The first exception thrown by any call is rethrown once all
+//!         threads have finished; remaining work is abandoned.
+//!
+//! \param  grain - the most indices passed to one call, or 0 to choose
+//!
+//! \return the statistics of each thread that took part
+template<class Function>
+std::vector<worker_statistics>
+work_stealing_for( std::size_t Count, std::size_t Threads, Function f, std::size_t Grain = 0 )
+{
+    using clock = std::chrono::steady_clock;
+
+    if( Threads == 0 )
+    {
+        Threads = default_thread_count();
+    }
+    Threads = std::max<std::size_t>( 1, std::min( Threads, Count ) );
+    if( Grain == 0 )
+    {
+        Grain = std::max<std::size_t>( 1, std::min<std::size_t>( 256, Count / ( Threads * 32 ) ) );
+    }
+
+    std::vector<worker_statistics> Statistics( Threads );
+    auto Started = clock::now();
+
+    if( Threads == 1 )
+    {
+        if( Count )
+        {
+            f( std::size_t( 0 ), Count );
+        }
+        Statistics[0].items = Count;
+        Statistics[0].busy = std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - Started );
+    }
+
+    // More indices than a share can hold are processed in slices that fit
+    std::size_t Slice = std::numeric_limits<std::uint32_t>::max();
+    for( std::size_t Base = 0; Threads > 1 && Base < Count; Base += Slice )
+    {
+        std::size_t SliceCount = std::min( Slice, Count - Base );
+
+        // Padded rather than aligned so that `new` needs no C++17 support
+        struct share
+        {
+            std::atomic<std::uint64_t> range;
+            char padding[64 - sizeof( std::atomic<std::uint64_t> )];
+        };
+
+        auto pack = []( std::uint64_t First, std::uint64_t Last ) { return ( First << 32 ) | Last; };
+
+        std::unique_ptr<share[]> Shares( new share[Threads] );
+        std::size_t ShareSize = ( SliceCount + Threads - 1 ) / Threads;
+        for( std::size_t Worker = 0; Worker != Threads; ++Worker )
+        {
+            auto First = std::min( SliceCount, Worker * ShareSize );
+            auto Last  = std::min( SliceCount, First + ShareSize );
+            Shares[Worker].range.store( pack( First, Last ), std::memory_order_relaxed );
+        }
+
+        std::atomic<std::size_t>    Remaining( SliceCount );
+        std::atomic<bool>           Abandoned( false );
+        std::mutex                  ErrorMutex;
+        std::exception_ptr          Error;
+
+        auto work = [&]( std::size_t Worker )
+        {
+            auto& Own = Shares[Worker].range;
+            auto& Mine = Statistics[Worker];
+
+            while( Remaining.load( std::memory_order_acquire ) && !Abandoned.load( std::memory_order_relaxed ) )
+            {
+                auto Range = Own.load( std::memory_order_acquire );
+                std::uint64_t First = Range >> 32;
+                std::uint64_t Last  = Range & 0xffffffffu;
+                if( First < Last )
+                {
+                    auto Next = std::min<std::uint64_t>( Last, First + Grain );
+                    if( !Own.compare_exchange_weak( Range, pack( Next, Last ), std::memory_order_acq_rel ) )
+                    {
+                        continue;
+                    }
+                    auto Begin = clock::now();
+                    try
+                    {
+                        f( Base + static_cast<std::size_t>( First ), Base + static_cast<std::size_t>( Next ) );
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard<std::mutex> Lock( ErrorMutex );
+                        if( !Error )
+                        {
+                            Error = std::current_exception();
+                        }
+                        Abandoned.store( true, std::memory_order_relaxed );
+                    }
+                    Mine.busy += std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - Begin );
+                    Mine.items += Next - First;
+                    Remaining.fetch_sub( Next - First, std::memory_order_acq_rel );
+                    continue;
+                }
+
+                // Own share is empty, so steal the back half of the largest
+                std::size_t Victim = Threads;
+                std::uint64_t Largest = 0;
+                for( std::size_t Other = 0; Other != Threads; ++Other )
+                {
+                    auto Theirs = Shares[Other].range.load( std::memory_order_relaxed );
+                    std::uint64_t Size = ( Theirs & 0xffffffffu ) - std::min( Theirs >> 32, Theirs & 0xffffffffu );
+                    if( Other != Worker && Size > Largest )
+                    {
+                        Victim = Other;
+                        Largest = Size;
+                    }
+                }
+                if( Victim == Threads )
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                auto Theirs = Shares[Victim].range.load( std::memory_order_acquire );
+                std::uint64_t TheirFirst = Theirs >> 32;
+                std::uint64_t TheirLast  = Theirs & 0xffffffffu;
+                if( TheirFirst >= TheirLast )
+                {
+                    continue;
+                }
+                auto Middle = TheirFirst + ( TheirLast - TheirFirst ) / 2;
+                if( Shares[Victim].range.compare_exchange_strong( Theirs, pack( TheirFirst, Middle ), std::memory_order_acq_rel ) )
+                {
+                    Own.store( pack( Middle, TheirLast ), std::memory_order_release );
+                    ++Mine.steals;
+                }
+            }
+        };
+
+        std::vector<std::thread> Workers;
+        Workers.reserve( Threads - 1 );
+        for( std::size_t Worker = 1; Worker != Threads; ++Worker )
+        {
+            Workers.emplace_back( work, Worker );
+        }
+        work( 0 );
+        for( auto& Worker: Workers )
+        {
+            Worker.join();
+        }
+        if( Error )
+        {
+            std::rethrow_exception( Error );
+        }
+    }
+
+    auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - Started );
+    for( auto& Worker: Statistics )
+    {
+        Worker.utilisation = Elapsed.count() ? static_cast<double>( Worker.busy.count() ) / Elapsed.count() : 0;
+    }
+    return Statistics;
+}
+
+
+//! \brief  Stable sort [first,last) using up to `threads` threads by sorting
+//!         contiguous chunks in parallel and then merging them pairwise
+template<class RandomAccessIterator, class Compare>
+void
+parallel_stable_sort( RandomAccessIterator First, RandomAccessIterator Last, Compare Less, std::size_t Threads )
+{
+    std::size_t Count = Last - First;
+
+    if( Threads == 0 )
+    {
+        Threads = default_thread_count();
+    }
+    Threads = std::min( Threads, Count );
+
+    if( Threads <= 1 )
+    {
+        std::stable_sort( First, Last, Less );
+        return;
+    }
+
+    std::size_t ChunkSize = ( Count + Threads - 1 ) / Threads;
+
+    parallel_for( Threads, Threads, [&]( std::size_t FirstChunk, std::size_t LastChunk )
+    {
+        for( std::size_t Chunk = FirstChunk; Chunk != LastChunk; ++Chunk )
+        {
+            auto Begin = First + std::min( Count, Chunk * ChunkSize );
+            auto End   = First + std::min( Count, ( Chunk + 1 ) * ChunkSize );
+            std::stable_sort( Begin, End, Less );
+        }
+    } );
+
+    for( std::size_t Width = ChunkSize; Width < Count; Width *= 2 )
+    {
+        std::size_t Merges = ( Count + 2 * Width - 1 ) / ( 2 * Width );
+        parallel_for( Merges, Threads, [&]( std::size_t FirstMerge, std::size_t LastMerge )
+        {
+            for( std::size_t Merge = FirstMerge; Merge != LastMerge; ++Merge )
+            {
+                std::size_t Begin = Merge * 2 * Width;
+                std::size_t Mid   = std::min( Count, Begin + Width );
+                std::size_t End   = std::min( Count, Begin + 2 * Width );
+                std::inplace_merge( First + Begin, First + Mid, First + End, Less );
+            }
+        } );
+    }
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
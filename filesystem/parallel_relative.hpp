@@ -0,0 +1,121 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_PARALLEL_RELATIVE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_PARALLEL_RELATIVE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Batch operations - not part of the proposal
+
+
+//! \brief  The result of one pair of a parallel batch
+struct path_result
+{
+    path_t                      path;
+    boost::system::error_code   ec;
+};
+
+
+//! \brief  Compute `relative( p, start, ec, ops )` for every pair in `pairs`
+//!         using up to `threads` threads, returning the results in the
+//!         order of `pairs`
+//!
+//! \param  pairs - the (p, start) pairs to compute relative paths for
+//!
+//! \param  threads - the number of threads to use, or 0 to use one per core
+//!
+//! \param  ops - the object used to query the filesystem, see `system_operations`
+//!
+//! \param  statistics - if not null, receives what each thread did
+//!
+//! \note   Pairs are shared out with `work_stealing_for`, so a few pairs that
+//!         resolve deep symlink chains do not leave other threads idle while
+//!         one thread works through them.
+template<class Operations>
+std::vector<path_result>
+parallel_relative( const std::vector<std::pair<path_t, path_t>>& Pairs, std::size_t Threads, const Operations& ops, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    std::vector<path_result> Results( Pairs.size() );
+    auto Workers = xstd::filesystem::work_stealing_for( Pairs.size(), Threads, [&]( std::size_t First, std::size_t Last )
+    {
+        for( ; First != Last; ++First )
+        {
+            auto& Result = Results[First];
+            Result.path = relative( Pairs[First].first, Pairs[First].second, Result.ec, ops );
+        }
+    } );
+    if( Statistics )
+    {
+        *Statistics = std::move( Workers );
+    }
+    return Results;
+}
+
+
+//! \brief  Compute `relative( p, start, ec )` for every pair in `pairs`
+//!         using up to `threads` threads, returning the results in the
+//!         order of `pairs`
+inline
+std::vector<path_result>
+parallel_relative( const std::vector<std::pair<path_t, path_t>>& Pairs, std::size_t Threads = 0, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    return parallel_relative( Pairs, Threads, system_operations(), Statistics );
+}
+
+
+//! \brief  Compute `proximate( p, start, ec, ops )` for every pair in `pairs`
+//!         using up to `threads` threads, returning the results in the
+//!         order of `pairs`
+//!
+//! \note   As `parallel_relative`.
+template<class Operations>
+std::vector<path_result>
+parallel_proximate( const std::vector<std::pair<path_t, path_t>>& Pairs, std::size_t Threads, const Operations& ops, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    auto Results = parallel_relative( Pairs, Threads, ops, Statistics );
+    for( std::size_t Pair = 0; Pair != Results.size(); ++Pair )
+    {
+        if( Results[Pair].path.empty() )
+        {
+            Results[Pair].path = Pairs[Pair].first;
+        }
+    }
+    return Results;
+}
+
+
+//! \brief  Compute `proximate( p, start, ec )` for every pair in `pairs`
+//!         using up to `threads` threads, returning the results in the
+//!         order of `pairs`
+inline
+std::vector<path_result>
+parallel_proximate( const std::vector<std::pair<path_t, path_t>>& Pairs, std::size_t Threads = 0, std::vector<xstd::filesystem::worker_statistics>* Statistics = nullptr )
+{
+    return parallel_proximate( Pairs, Threads, system_operations(), Statistics );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,26 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_parallel_relative
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_parallel_relative_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_work_stealing_for_uneven_work )
+{
+    test_work_stealing_for_uneven_work();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_parallel_real_relative_paths )
+{
+    test_parallel_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_parallel_imaginary_relative_paths )
+{
+    test_parallel_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_parallel_real_and_imaginary_relative_paths )
+{
+    test_parallel_real_and_imaginary_relative_paths();
+}
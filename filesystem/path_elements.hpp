@@ -0,0 +1,213 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_PATH_ELEMENTS_HPP_INCLUDED
+#define XSTD_FILESYSTEM_PATH_ELEMENTS_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// Boost Library Includes
+// None
+
+// C++ Standard Library Includes
+#include <cstddef>
+#include <string>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Element scanning over raw character ranges - not part of the proposal.
+//
+// These helpers visit the same elements, in the same order, as iterating a
+// POSIX `path_t` does, but without constructing any path objects. They are
+// `constexpr` so that they can be used at compile time as well as over views
+// into larger buffers at run time.
+
+enum class element_kind
+{
+    end,
+    root_name,
+    root_directory,
+    filename
+};
+
+
+struct path_element
+{
+    //! The text of the element. For a root-directory this is "/" and for
+    //! the implicit element following a trailing separator this is "."
+    const char*     data;
+    std::size_t     size;
+
+    //! The extent [first,last) of the element within the source range
+    std::size_t     first;
+    std::size_t     last;
+
+    element_kind    kind;
+};
+
+
+constexpr
+bool
+is_end( const path_element& Element )
+{
+    return Element.kind == element_kind::end;
+}
+
+
+constexpr
+path_element
+end_element( std::size_t Size )
+{
+    return path_element{ "", 0, Size, Size, element_kind::end };
+}
+
+
+//! \brief  Return the first element of the path held in [s,s+size)
+//!
+//! \note   Exactly two leading separators, including a lone "//", begin a
+//!         root-name as they do for `path_t`; three or more are a single
+//!         root-directory.
+constexpr
+path_element
+first_element( const char* s, std::size_t size )
+{
+    if( size == 0 )
+    {
+        return end_element( size );
+    }
+    if( size > 1 && s[0] == '/' && s[1] == '/' && ( size == 2 || s[2] != '/' ) )
+    {
+        std::size_t Last = 2;
+        while( Last != size && s[Last] != '/' )
+        {
+            ++Last;
+        }
+        return path_element{ s, Last, 0, Last, element_kind::root_name };
+    }
+    if( s[0] == '/' )
+    {
+        return path_element{ s, 1, 0, 1, element_kind::root_directory };
+    }
+    std::size_t Last = 0;
+    while( Last != size && s[Last] != '/' )
+    {
+        ++Last;
+    }
+    return path_element{ s, Last, 0, Last, element_kind::filename };
+}
+
+
+//! \brief  Return the element that follows `prev` in the path held in [s,s+size)
+constexpr
+path_element
+next_element( const char* s, std::size_t size, const path_element& Prev )
+{
+    std::size_t Pos = Prev.last;
+
+    if( Prev.kind == element_kind::end || Pos >= size )
+    {
+        return end_element( size );
+    }
+    if( Prev.kind == element_kind::root_name )
+    {
+        return path_element{ s + Pos, 1, Pos, Pos + 1, element_kind::root_directory };
+    }
+
+    std::size_t First = Pos;
+    while( First != size && s[First] == '/' )
+    {
+        ++First;
+    }
+    if( First == size )
+    {
+        if( Prev.kind == element_kind::filename )
+        {
+            return path_element{ ".", 1, Pos, size, element_kind::filename };
+        }
+        return end_element( size );
+    }
+
+    std::size_t Last = First;
+    while( Last != size && s[Last] != '/' )
+    {
+        ++Last;
+    }
+    return path_element{ s + First, Last - First, First, Last, element_kind::filename };
+}
+
+
+//! \brief  Return true if the text of the two elements is the same
+constexpr
+bool
+element_equal( const path_element& Lhs, const path_element& Rhs )
+{
+    if( Lhs.size != Rhs.size )
+    {
+        return false;
+    }
+    for( std::size_t i = 0; i != Lhs.size; ++i )
+    {
+        if( Lhs.data[i] != Rhs.data[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//! \brief  Return true if the element text is exactly `text`
+template<std::size_t N>
+constexpr
+bool
+element_is( const path_element& Element, const char (&Text)[N] )
+{
+    return element_equal( Element, path_element{ Text, N - 1, 0, N - 1, element_kind::filename } );
+}
+
+
+//! \brief  Return the number of elements in the path held in [s,s+size)
+constexpr
+std::size_t
+element_count( const char* s, std::size_t size )
+{
+    std::size_t Count = 0;
+    for( auto Element = first_element( s, size ); !is_end( Element ); Element = next_element( s, size, Element ) )
+    {
+        ++Count;
+    }
+    return Count;
+}
+
+
+//! \brief  Append the text of `element` to `s` as `path_t::operator/=`
+//!         would, adding a separator only where one is needed
+inline
+void
+append_element( std::string& s, const char* Data, std::size_t Size )
+{
+    if( Size != 0 && Data[0] != '/' && !s.empty() && s.back() != '/' )
+    {
+        s.push_back( '/' );
+    }
+    s.append( Data, Size );
+}
+
+
+inline
+void
+append_element( std::string& s, const path_element& Element )
+{
+    append_element( s, Element.data, Element.size );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -31,6 +31,11 @@ BOOST_AUTO_TEST_CASE( test_case_real_and_imaginary_relative_paths_with_parent_an
     test_real_and_imaginary_relative_paths_with_parent_and_current_directories();
 }
 
+BOOST_AUTO_TEST_CASE( test_case_weakly_canonical_paths )
+{
+    test_weakly_canonical_paths();
+}
+
 BOOST_AUTO_TEST_CASE( test_case_non_relative_paths )
 {
     test_non_relative_paths();
@@ -0,0 +1,551 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_RELATIVE_WALKER_HPP_INCLUDED
+#define XSTD_FILESYSTEM_RELATIVE_WALKER_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  How a relative_walker or `walk_relative` reads directories
+struct walk_options
+{
+    static const std::size_t default_buffer_size = 64 * 1024;
+
+    //! Read entries with the `getdents64` system call into a buffer of
+    //! `buffer_size` bytes rather than with `readdir`, so that a large
+    //! directory is listed in a few calls. Only used where `getdents64`
+    //! is available.
+    bool            use_getdents = false;
+    std::size_t     buffer_size  = default_buffer_size;
+
+    //! The number of threads `walk_relative` shares directories across,
+    //! or 0 to use one per core
+    std::size_t     threads      = 1;
+};
+
+
+//! \brief  Lists the entries of one open directory, with their types as
+//!         the directory reports them
+class directory_reader
+{
+public:
+
+    //! \brief  Take ownership of `fd`, an open directory
+    directory_reader( int Fd, const walk_options& Options )
+    : Fd_( Fd )
+    {
+#ifdef SYS_getdents64
+        if( Options.use_getdents )
+        {
+            Buffer_.reset( new char[ Options.buffer_size ] );
+            BufferSize_ = Options.buffer_size;
+            return;
+        }
+#endif
+        Dir_ = ::fdopendir( Fd_ );
+        if( !Dir_ )
+        {
+            Error_ = errno;
+        }
+    }
+
+    directory_reader( const directory_reader& ) = delete;
+    directory_reader& operator=( const directory_reader& ) = delete;
+
+    ~directory_reader()
+    {
+        if( Dir_ )
+        {
+            ::closedir( Dir_ );
+        }
+        else
+        {
+            ::close( Fd_ );
+        }
+    }
+
+    int fd() const noexcept
+    {
+        return Fd_;
+    }
+
+    //! \brief  Set `name` and `type` to the next entry other than `.` and
+    //!         `..`, returning false at the end of the directory or on an
+    //!         error, which is then returned by `error`
+    bool next( const char*& Name, unsigned char& Type ) noexcept
+    {
+        while( true )
+        {
+            if( Dir_ )
+            {
+                errno = 0;
+                auto Entry = ::readdir( Dir_ );
+                if( !Entry )
+                {
+                    Error_ = errno;
+                    return false;
+                }
+                Name = Entry->d_name;
+                Type = Entry->d_type;
+            }
+            else if( !Error_ && Buffer_ )
+            {
+                if( Position_ == Filled_ && !fill() )
+                {
+                    return false;
+                }
+                auto Entry = reinterpret_cast<const linux_dirent64*>( Buffer_.get() + Position_ );
+                Position_ += Entry->d_reclen;
+                Name = Entry->d_name;
+                Type = Entry->d_type;
+            }
+            else
+            {
+                return false;
+            }
+            if( Name[0] != '.' || ( Name[1] && ( Name[1] != '.' || Name[2] ) ) )
+            {
+                return true;
+            }
+        }
+    }
+
+    int error() const noexcept
+    {
+        return Error_;
+    }
+
+private:
+
+    struct linux_dirent64
+    {
+        std::uint64_t   d_ino;
+        std::int64_t    d_off;
+        unsigned short  d_reclen;
+        unsigned char   d_type;
+        char            d_name[1];
+    };
+
+    bool fill() noexcept
+    {
+#ifdef SYS_getdents64
+        auto Read = ::syscall( SYS_getdents64, Fd_, Buffer_.get(), BufferSize_ );
+        if( Read < 0 )
+        {
+            Error_ = errno;
+            return false;
+        }
+        Position_ = 0;
+        Filled_ = static_cast<std::size_t>( Read );
+        return Read > 0;
+#else
+        return false;
+#endif
+    }
+
+    int                     Fd_;
+    DIR*                    Dir_ = nullptr;
+    int                     Error_ = 0;
+    std::unique_ptr<char[]> Buffer_;
+    std::size_t             BufferSize_ = 0;
+    std::size_t             Position_ = 0;
+    std::size_t             Filled_ = 0;
+};
+
+
+//! \brief  Return the type of the entry `name` in the directory open as
+//!         `fd`, asking `fstatat` only if the directory did not say
+inline
+boost::filesystem::file_type
+entry_type( int Fd, const char* Name, unsigned char Type ) noexcept
+{
+    switch( Type )
+    {
+        case DT_REG:  return boost::filesystem::regular_file;
+        case DT_DIR:  return boost::filesystem::directory_file;
+        case DT_LNK:  return boost::filesystem::symlink_file;
+        case DT_BLK:  return boost::filesystem::block_file;
+        case DT_CHR:  return boost::filesystem::character_file;
+        case DT_FIFO: return boost::filesystem::fifo_file;
+        case DT_SOCK: return boost::filesystem::socket_file;
+        default:      break;
+    }
+    struct ::stat Status;
+    if( ::fstatat( Fd, Name, &Status, AT_SYMLINK_NOFOLLOW ) != 0 )
+    {
+        return boost::filesystem::status_error;
+    }
+    switch( Status.st_mode & S_IFMT )
+    {
+        case S_IFREG:  return boost::filesystem::regular_file;
+        case S_IFDIR:  return boost::filesystem::directory_file;
+        case S_IFLNK:  return boost::filesystem::symlink_file;
+        case S_IFBLK:  return boost::filesystem::block_file;
+        case S_IFCHR:  return boost::filesystem::character_file;
+        case S_IFIFO:  return boost::filesystem::fifo_file;
+        case S_IFSOCK: return boost::filesystem::socket_file;
+        default:       return boost::filesystem::type_unknown;
+    }
+}
+
+
+//! \brief  Open the directory `root` of a walk, which may be a symlink,
+//!         returning -1 and setting `errno` on failure
+inline
+int
+open_root( const boost::filesystem::path_t& Root ) noexcept
+{
+    return ::open( Root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+}
+
+
+//! \brief  Open the directory `name` relative to the directory open as `fd`
+//!         without following a symlink, returning -1 and setting `errno`
+//!         on failure
+inline
+int
+open_directory_at( int Fd, const char* Name ) noexcept
+{
+    return ::openat( Fd, Name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC );
+}
+
+
+//! \brief  Walks the tree below a directory depth first, without following
+//!         symlinks, presenting each entry by its path relative to the root.
+//!
+//!         The relative path is kept in one string that is extended by the
+//!         name of each entry and cut back when its directory is finished,
+//!         so producing it costs an append rather than a call to `relative`
+//!         or `lexically_relative`. Each directory on the way down is held
+//!         open and its entries are opened relative to it, so the kernel
+//!         never looks up the full path of anything either.
+//!
+//!         A directory is presented before its entries, which are visited
+//!         in the order the filesystem lists them.
+class relative_walker
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    //! \brief  Start a walk of the tree below `root`, setting `ec` if it
+    //!         cannot be opened
+    relative_walker( const path_t& Root, const walk_options& Options, boost::system::error_code& ec )
+    : Options_( Options )
+    {
+        open( Root, ec );
+    }
+
+    //! \brief  Start a walk of the tree below `root`
+    //!
+    //! \throws boost::filesystem::filesystem_error if it cannot be opened
+    explicit relative_walker( const path_t& Root, const walk_options& Options = walk_options() )
+    : Options_( Options )
+    {
+        boost::system::error_code ec;
+        open( Root, ec );
+        if( ec )
+        {
+            BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::relative_walker", Root, ec ) );
+        }
+    }
+
+    relative_walker( const relative_walker& ) = delete;
+    relative_walker& operator=( const relative_walker& ) = delete;
+
+    //! \brief  Move to the next entry, returning false at the end of the
+    //!         walk or if a directory could not be read, when `ec` is set.
+    //!         After an error the walk carries on from the next entry of
+    //!         the directory above, so a caller that wants to skip what it
+    //!         cannot read can loop while `next( ec ) || ec`.
+    bool next( boost::system::error_code& ec )
+    {
+        ec.clear();
+        if( Descend_ )
+        {
+            Descend_ = false;
+            auto& Parent = *Frames_.back().reader;
+            int Fd = open_directory_at( Parent.fd(), Path_.c_str() + Frames_.back().prefix );
+            if( Fd < 0 )
+            {
+                ec.assign( errno, boost::system::system_category() );
+                return false;
+            }
+            if( !push( Fd, ec ) )
+            {
+                return false;
+            }
+        }
+        while( !Frames_.empty() )
+        {
+            auto& Frame = Frames_.back();
+            const char* Name = nullptr;
+            unsigned char Type = DT_UNKNOWN;
+            if( Frame.reader->next( Name, Type ) )
+            {
+                Path_.resize( Frame.prefix );
+                Path_.append( Name );
+                Type_ = entry_type( Frame.reader->fd(), Name, Type );
+                Descend_ = Type_ == boost::filesystem::directory_file;
+                return true;
+            }
+            int Error = Frame.reader->error();
+            Frames_.pop_back();
+            if( Error )
+            {
+                ec.assign( Error, boost::system::system_category() );
+                return false;
+            }
+        }
+        Path_.clear();
+        return false;
+    }
+
+    //! \brief  Move to the next entry, returning false at the end of the walk
+    //!
+    //! \throws boost::filesystem::filesystem_error if a directory could not
+    //!         be read
+    bool next()
+    {
+        boost::system::error_code ec;
+        if( next( ec ) )
+        {
+            return true;
+        }
+        if( ec )
+        {
+            BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::relative_walker::next", path_t( Path_ ), ec ) );
+        }
+        return false;
+    }
+
+    //! \brief  The path of the current entry relative to the root, valid
+    //!         until the next call to `next`
+    const std::string& path() const noexcept
+    {
+        return Path_;
+    }
+
+    //! \brief  The type of the current entry, which for a symlink is
+    //!         `symlink_file`
+    boost::filesystem::file_type type() const noexcept
+    {
+        return Type_;
+    }
+
+    //! \brief  The number of directories between the root and the current
+    //!         entry, 0 for the entries of the root itself
+    std::size_t depth() const noexcept
+    {
+        return Frames_.empty() ? 0 : Frames_.size() - 1;
+    }
+
+    //! \brief  Do not visit the entries of the current directory
+    void skip_directory() noexcept
+    {
+        Descend_ = false;
+    }
+
+private:
+
+    struct frame
+    {
+        std::unique_ptr<directory_reader>   reader;
+        std::size_t                         prefix;
+    };
+
+    void open( const path_t& Root, boost::system::error_code& ec )
+    {
+        int Fd = open_root( Root );
+        if( Fd < 0 )
+        {
+            ec.assign( errno, boost::system::system_category() );
+            return;
+        }
+        push( Fd, ec );
+    }
+
+    bool push( int Fd, boost::system::error_code& ec )
+    {
+        std::unique_ptr<directory_reader> Reader( new directory_reader( Fd, Options_ ) );
+        if( Reader->error() )
+        {
+            ec.assign( Reader->error(), boost::system::system_category() );
+            return false;
+        }
+        std::size_t Prefix = 0;
+        if( !Path_.empty() )
+        {
+            Path_.push_back( '/' );
+            Prefix = Path_.size();
+        }
+        Frames_.push_back( frame{ std::move( Reader ), Prefix } );
+        return true;
+    }
+
+    walk_options                    Options_;
+    std::vector<frame>              Frames_;
+    std::string                     Path_;
+    boost::filesystem::file_type    Type_ = boost::filesystem::status_unknown;
+    bool                            Descend_ = false;
+};
+
+
+//! \brief  A directory below the root that `walk_relative` could not read
+struct walk_failure
+{
+    std::string                 path;
+    boost::system::error_code   ec;
+};
+
+
+//! \brief  Call `f( relative, type )` for every entry in the tree below
+//!         `root`, without following symlinks, where `relative` is the path
+//!         of the entry relative to `root`
+//!
+//! \param  options - see walk_options; with more than one thread the
+//!         directories of each level of the tree are shared across them
+//!         with `work_stealing_for` and `f` is called from all of them at
+//!         once
+//!
+//! \param  failures - if not null, receives the directories that could not
+//!         be read, which are otherwise skipped silently
+//!
+//! \param  ec - set if `root` cannot be opened
+//!
+//! \note   As with relative_walker, each relative path is built by appending
+//!         to the path of its directory, and each directory is opened
+//!         relative to the root, which is held open for the whole walk.
+//!         Entries are presented level by level rather than depth first.
+template<class Function>
+void
+walk_relative( const boost::filesystem::path_t& Root, const walk_options& Options, Function f, boost::system::error_code& ec, std::vector<walk_failure>* Failures = nullptr )
+{
+    int RootFd = open_root( Root );
+    if( RootFd < 0 )
+    {
+        ec.assign( errno, boost::system::system_category() );
+        return;
+    }
+    ec.clear();
+
+    struct listing
+    {
+        std::vector<std::string>    directories;
+        int                         error = 0;
+    };
+
+    std::vector<std::string> Level = { std::string() };
+    while( !Level.empty() )
+    {
+        std::vector<listing> Listings( Level.size() );
+        work_stealing_for( Level.size(), Options.threads, [&]( std::size_t First, std::size_t Last )
+        {
+            std::string Path;
+            for( ; First != Last; ++First )
+            {
+                auto& Listing = Listings[First];
+                const auto& Directory = Level[First];
+
+                int Fd = Directory.empty() ? ::dup( RootFd ) : open_directory_at( RootFd, Directory.c_str() );
+                if( Fd < 0 )
+                {
+                    Listing.error = errno;
+                    continue;
+                }
+                directory_reader Reader( Fd, Options );
+
+                Path = Directory;
+                if( !Path.empty() )
+                {
+                    Path.push_back( '/' );
+                }
+                auto Prefix = Path.size();
+
+                const char* Name = nullptr;
+                unsigned char Type = DT_UNKNOWN;
+                while( Reader.next( Name, Type ) )
+                {
+                    Path.resize( Prefix );
+                    Path.append( Name );
+                    auto EntryType = entry_type( Reader.fd(), Name, Type );
+                    f( static_cast<const std::string&>( Path ), EntryType );
+                    if( EntryType == boost::filesystem::directory_file )
+                    {
+                        Listing.directories.push_back( Path );
+                    }
+                }
+                Listing.error = Reader.error();
+            }
+        } );
+
+        std::vector<std::string> Next;
+        for( std::size_t Directory = 0; Directory != Level.size(); ++Directory )
+        {
+            auto& Listing = Listings[Directory];
+            if( Listing.error && Failures )
+            {
+                Failures->push_back( walk_failure{ Level[Directory], boost::system::error_code( Listing.error, boost::system::system_category() ) } );
+            }
+            for( auto& Subdirectory : Listing.directories )
+            {
+                Next.push_back( std::move( Subdirectory ) );
+            }
+        }
+        Level = std::move( Next );
+    }
+    ::close( RootFd );
+}
+
+
+//! \brief  Call `f( relative, type )` for every entry in the tree below
+//!         `root`, without following symlinks
+//!
+//! \throws boost::filesystem::filesystem_error if `root` cannot be opened
+template<class Function>
+void
+walk_relative( const boost::filesystem::path_t& Root, const walk_options& Options, Function f )
+{
+    boost::system::error_code ec;
+    walk_relative( Root, Options, f, ec );
+    if( ec )
+    {
+        BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::walk_relative", Root, ec ) );
+    }
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
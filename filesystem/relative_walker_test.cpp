@@ -0,0 +1,16 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_relative_walker
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_relative_walker_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_relative_walker )
+{
+    test_relative_walker();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_walk_relative )
+{
+    test_walk_relative();
+}
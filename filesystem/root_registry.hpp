@@ -0,0 +1,232 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_ROOT_REGISTRY_HPP_INCLUDED
+#define XSTD_FILESYSTEM_ROOT_REGISTRY_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  The result of a root_registry lookup
+struct root_match
+{
+    //! The deepest registered root containing the path, path() if none
+    path_t root;
+
+    //! `lexically_relative( p, root )` if a root was found, path() otherwise
+    path_t relative;
+
+    explicit operator bool() const noexcept
+    {
+        return !root.empty();
+    }
+};
+
+
+//! \brief  A set of root paths that can answer which registered root is the
+//!         deepest one containing a given path.
+//!
+//!         Roots are held in a trie keyed on path elements so a lookup
+//!         takes time proportional to the depth of the path, regardless of
+//!         how many roots are registered. All paths are compared after
+//!         `normalize`; no filesystem access takes place.
+//!
+//!         Lookups may run concurrently with each other and with `add` and
+//!         `remove`. Writers build a new version of the affected branch and
+//!         publish it atomically, so readers always see a consistent set of
+//!         roots and never wait for a writer to finish changing the trie.
+//!         The trie is published with `std::atomic_load` and
+//!         `std::atomic_store` on a `shared_ptr`, which libstdc++ implements
+//!         with a small pool of mutexes. Readers and writers may therefore
+//!         briefly wait on each other while the pointer is copied, but not
+//!         while a lookup walks the trie.
+class root_registry
+{
+public:
+
+    root_registry()
+    : Trie_( std::make_shared<const node>() )
+    {
+    }
+
+    root_registry( const root_registry& ) = delete;
+    root_registry& operator=( const root_registry& ) = delete;
+
+    //! \brief  Register `root`, returning false if it was already registered
+    bool add( const path_t& Root )
+    {
+        return update( normalize( Root ), true );
+    }
+
+    //! \brief  Unregister `root`, returning false if it was not registered
+    bool remove( const path_t& Root )
+    {
+        return update( normalize( Root ), false );
+    }
+
+    //! \brief  Return the deepest registered root containing `p` together
+    //!         with the path to `p` relative to that root
+    root_match find( const path_t& p ) const
+    {
+        auto Trie = std::atomic_load( &Trie_ );
+        auto norm_p = normalize( p );
+
+        const node* Node  = Trie.get();
+        const node* Match = Node->is_root ? Node : nullptr;
+
+        for( const auto& Element: norm_p )
+        {
+            auto Child = Node->children.find( Element.native() );
+            if( Child == Node->children.end() )
+            {
+                break;
+            }
+            Node = Child->second.get();
+            if( Node->is_root )
+            {
+                Match = Node;
+            }
+        }
+
+        root_match Result;
+        if( Match )
+        {
+            Result.root = Match->root;
+            Result.relative = lexically_relative( norm_p, Match->root );
+        }
+        return Result;
+    }
+
+    //! \brief  Return true if `root` itself is registered
+    bool contains( const path_t& Root ) const
+    {
+        auto Match = find( Root );
+        return Match && Match.root == normalize( Root );
+    }
+
+    //! \brief  Return the number of registered roots
+    std::size_t size() const noexcept
+    {
+        return Size_.load( std::memory_order_relaxed );
+    }
+
+private:
+
+    struct node
+    {
+        std::unordered_map<std::string, std::shared_ptr<const node>> children;
+        bool    is_root = false;
+        path_t  root;
+    };
+
+    using node_ptr = std::shared_ptr<const node>;
+
+    bool update( const path_t& Root, bool Insert )
+    {
+        if( Root.empty() )
+        {
+            return false;
+        }
+
+        std::vector<std::string> Elements;
+        for( const auto& Element: Root )
+        {
+            Elements.push_back( Element.native() );
+        }
+
+        std::lock_guard<std::mutex> Lock( WriteMutex_ );
+
+        bool Changed = false;
+        auto Trie = update( std::atomic_load( &Trie_ ), Root, Elements, 0, Insert, Changed );
+        if( Changed )
+        {
+            std::atomic_store( &Trie_, Trie );
+            if( Insert )
+            {
+                Size_.fetch_add( 1, std::memory_order_relaxed );
+            }
+            else
+            {
+                Size_.fetch_sub( 1, std::memory_order_relaxed );
+            }
+        }
+        return Changed;
+    }
+
+    //! Return a copy of `current` with the change applied below it, sharing
+    //! every untouched branch with the current version. Returns null for a
+    //! node that has become empty.
+    static node_ptr update( const node_ptr& Current, const path_t& Root, const std::vector<std::string>& Elements, std::size_t Depth, bool Insert, bool& Changed )
+    {
+        auto Node = Current ? std::make_shared<node>( *Current ) : std::make_shared<node>();
+
+        if( Depth == Elements.size() )
+        {
+            Changed = ( Node->is_root != Insert );
+            if( !Changed )
+            {
+                return Current;
+            }
+            Node->is_root = Insert;
+            Node->root = Insert ? Root : path_t();
+        }
+        else
+        {
+            auto Child = Node->children.find( Elements[Depth] );
+            if( Child == Node->children.end() && !Insert )
+            {
+                return Current;
+            }
+            auto NewChild = update( Child != Node->children.end() ? Child->second : node_ptr(), Root, Elements, Depth + 1, Insert, Changed );
+            if( !Changed )
+            {
+                return Current;
+            }
+            if( NewChild )
+            {
+                Node->children[Elements[Depth]] = NewChild;
+            }
+            else
+            {
+                Node->children.erase( Elements[Depth] );
+            }
+        }
+
+        if( !Node->is_root && Node->children.empty() && Depth != 0 )
+        {
+            return node_ptr();
+        }
+        return Node;
+    }
+
+    node_ptr                    Trie_;
+    std::mutex                  WriteMutex_;
+    std::atomic<std::size_t>    Size_{ 0 };
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
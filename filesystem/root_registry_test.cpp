@@ -0,0 +1,21 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_root_registry
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_root_registry_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_root_registry_find )
+{
+    test_root_registry_find();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_root_registry_remove )
+{
+    test_root_registry_remove();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_root_registry_concurrent_readers )
+{
+    test_root_registry_concurrent_readers();
+}
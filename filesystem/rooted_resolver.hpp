@@ -0,0 +1,325 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_ROOTED_RESOLVER_HPP_INCLUDED
+#define XSTD_FILESYSTEM_ROOTED_RESOLVER_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/dirfd_resolver.hpp>
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+#include <sys/syscall.h>
+#if defined( SYS_openat2 ) && defined( __has_include )
+#if __has_include( <linux/openat2.h> )
+#include <linux/openat2.h>
+#define XSTD_FILESYSTEM_HAS_OPENAT2 1
+#endif
+#endif
+#endif
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Resolves paths inside a root directory as if the process were
+//!         chrooted there, so that neither ".." nor a symlink can reach
+//!         anything outside it.
+//!
+//!         On Linux 5.6 and later each path is resolved by the kernel in one
+//!         `openat2` call with `RESOLVE_IN_ROOT | RESOLVE_NO_MAGICLINKS`, and
+//!         the real path is read back from `/proc/self/fd`. Where `openat2`
+//!         is not available, or is refused, the first failure switches the
+//!         resolver to walking each element in user space with a
+//!         dirfd_resolver given the same root.
+//!
+//!         The walker cannot stop a directory being renamed out of the root
+//!         part way through, so nothing else falls back to it. A resolution
+//!         that still races with renames after `max_retries` attempts fails
+//!         with EAGAIN, and one whose real path is outside the root, as the
+//!         root or the object has been moved, fails with EXDEV.
+//!
+//!         Paths passed in and real paths returned are as seen from inside
+//!         the root, so "/" is the root itself.
+class rooted_resolver
+{
+public:
+
+    //! The most times `openat2` is retried when a rename races with it
+    static const int max_retries = 8;
+
+    explicit rooted_resolver( const boost::filesystem::path_t& Root, bool UseOpenat2 = true )
+    : Walker_( Root )
+    , RootFd_( ::open( Root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC ) )
+    , RootReal_( boost::filesystem::canonical( Root ).native() )
+    , Openat2_( UseOpenat2 && openat2_supported() )
+    {
+        if( RootFd_ < 0 )
+        {
+            BOOST_FILESYSTEM_THROW
+            (   boost::filesystem::filesystem_error
+                (   "xstd::filesystem::rooted_resolver",
+                    Root,
+                    boost::system::error_code( errno, boost::system::system_category() )   )   );
+        }
+    }
+
+    rooted_resolver( const rooted_resolver& ) = delete;
+    rooted_resolver& operator=( const rooted_resolver& ) = delete;
+
+    ~rooted_resolver()
+    {
+        ::close( RootFd_ );
+    }
+
+    //! \brief  Resolve the absolute path `p` inside the root. `real_path` is
+    //!         only set if `need_real_path` is true. A path that does not
+    //!         exist is not an error.
+    dirfd_resolution resolve( const boost::filesystem::path_t& p, boost::system::error_code& ec, bool NeedRealPath = true ) const
+    {
+#if defined( XSTD_FILESYSTEM_HAS_OPENAT2 )
+        if( Openat2_.load( std::memory_order_relaxed ) && p.has_root_directory() && !p.has_root_name() )
+        {
+            dirfd_resolution Result;
+            if( resolve_in_kernel( p, Result, ec, NeedRealPath ) )
+            {
+                return Result;
+            }
+        }
+#endif
+        return Walker_.resolve( p, ec );
+    }
+
+    //! \brief  Return true while paths are being resolved with `openat2`
+    bool uses_openat2() const noexcept
+    {
+        return Openat2_.load( std::memory_order_relaxed );
+    }
+
+    //! \brief  Return true if the running kernel provides `openat2`
+    static bool openat2_supported()
+    {
+#if defined( XSTD_FILESYSTEM_HAS_OPENAT2 )
+        static const bool Supported = []()
+        {
+            open_how How{};
+            How.flags = O_PATH | O_CLOEXEC;
+            How.resolve = RESOLVE_IN_ROOT | RESOLVE_NO_MAGICLINKS;
+            long Fd = ::syscall( SYS_openat2, AT_FDCWD, "/", &How, sizeof( How ) );
+            if( Fd < 0 )
+            {
+                return false;
+            }
+            ::close( static_cast<int>( Fd ) );
+            return true;
+        }();
+        return Supported;
+#else
+        return false;
+#endif
+    }
+
+private:
+
+#if defined( XSTD_FILESYSTEM_HAS_OPENAT2 )
+
+    //! Return false if `openat2` has been refused and the path should be
+    //! resolved by the walker instead
+    bool resolve_in_kernel( const boost::filesystem::path_t& p, dirfd_resolution& Result, boost::system::error_code& ec, bool NeedRealPath ) const
+    {
+        ec.clear();
+
+        open_how How{};
+        How.flags = O_PATH | O_CLOEXEC;
+        How.resolve = RESOLVE_IN_ROOT | RESOLVE_NO_MAGICLINKS;
+
+        long Fd = -1;
+        int Error = EAGAIN;
+        for( int Attempt = 0; Fd < 0 && Error == EAGAIN && Attempt != max_retries; ++Attempt )
+        {
+            Fd = ::syscall( SYS_openat2, RootFd_, p.c_str(), &How, sizeof( How ) );
+            Error = Fd < 0 ? errno : 0;
+        }
+        if( Fd < 0 )
+        {
+            switch( Error )
+            {
+                case ENOENT:
+                case ENOTDIR:
+                    return true;
+                case ENOSYS:
+                case EPERM:
+                case E2BIG:
+                    // Refused, for example by a seccomp filter, so stop asking
+                    Openat2_.store( false, std::memory_order_relaxed );
+                    return false;
+                default:
+                    ec.assign( Error, boost::system::system_category() );
+                    return true;
+            }
+        }
+
+        struct stat Status;
+        Error = ::fstat( static_cast<int>( Fd ), &Status ) == 0 ? 0 : errno;
+        if( !Error && NeedRealPath )
+        {
+            Error = real_path( static_cast<int>( Fd ), Result.real_path );
+        }
+        ::close( static_cast<int>( Fd ) );
+
+        if( Error )
+        {
+            Result.real_path.clear();
+            ec.assign( Error, boost::system::system_category() );
+            return true;
+        }
+        Result.found = true;
+        Result.mode = Status.st_mode;
+        return true;
+    }
+
+    //! Read the path of `fd` from /proc and make it relative to the root,
+    //! returning EXDEV if it is not below the root or else the error
+    int real_path( int Fd, std::string& RealPath ) const
+    {
+        char Link[64];
+        std::snprintf( Link, sizeof( Link ), "/proc/self/fd/%d", Fd );
+
+        std::string HostPath( 256, '\0' );
+        while( true )
+        {
+            auto Size = ::readlink( Link, &HostPath[0], HostPath.size() );
+            if( Size < 0 )
+            {
+                return errno;
+            }
+            if( static_cast<std::size_t>( Size ) < HostPath.size() )
+            {
+                HostPath.resize( static_cast<std::size_t>( Size ) );
+                break;
+            }
+            HostPath.resize( HostPath.size() * 2 );
+        }
+
+        if( RootReal_ == "/" )
+        {
+            RealPath = std::move( HostPath );
+            return 0;
+        }
+        // Outside the root if the root, or the object since it was opened,
+        // has been moved
+        if( HostPath.compare( 0, RootReal_.size(), RootReal_ ) != 0 )
+        {
+            return EXDEV;
+        }
+        if( HostPath.size() == RootReal_.size() )
+        {
+            RealPath = "/";
+            return 0;
+        }
+        if( HostPath[ RootReal_.size() ] != '/' )
+        {
+            return EXDEV;
+        }
+        RealPath = HostPath.substr( RootReal_.size() );
+        return 0;
+    }
+
+#endif
+
+    dirfd_resolver              Walker_;
+    int                         RootFd_;
+    std::string                 RootReal_;
+    mutable std::atomic<bool>   Openat2_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations for `relative` and `proximate` that resolve
+//!         paths inside the root of a rooted_resolver.
+//!
+//!         Paths are as seen from inside the root, and relative arguments
+//!         are made absolute against the root itself rather than the
+//!         process's current directory, which is a path outside it.
+class rooted_operations
+{
+public:
+
+    explicit rooted_operations( const xstd::filesystem::rooted_resolver& Resolver )
+    : Resolver_( Resolver )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Resolver_.resolve( p, ec, false ).found;
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Result = Resolver_.resolve( p, ec, false );
+        return Result.found && S_ISDIR( Result.mode );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Result = Resolver_.resolve( p, ec );
+        if( ec )
+        {
+            return path_t();
+        }
+        if( !Result.found )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::system_category() );
+            return path_t();
+        }
+        return path_t( std::move( Result.real_path ) );
+    }
+
+    //! Relative paths are resolved from the root
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        ec.clear();
+        return path_t( "/" );
+    }
+
+private:
+
+    const xstd::filesystem::rooted_resolver& Resolver_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
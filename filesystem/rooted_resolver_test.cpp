@@ -0,0 +1,21 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_rooted_resolver
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_rooted_resolver_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_rooted_resolver_openat2 )
+{
+    test_rooted_resolver_openat2();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_rooted_resolver_moved_root )
+{
+    test_rooted_resolver_moved_root();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_rooted_resolver_walk )
+{
+    test_rooted_resolver_walk();
+}
@@ -0,0 +1,481 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_SHARED_CANONICAL_CACHE_HPP_INCLUDED
+#define XSTD_FILESYSTEM_SHARED_CANONICAL_CACHE_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  What identifies the file or directory a path resolves to, and
+//!         when it was last renamed or had its attributes changed
+struct file_identity
+{
+    std::uint64_t   device = 0;
+    std::uint64_t   inode = 0;
+    std::int64_t    ctime_sec = 0;
+    std::int64_t    ctime_nsec = 0;
+
+    //! \brief  Return the identity of what `p` resolves to, or false if it
+    //!         cannot be stat'ed
+    static bool of( const boost::filesystem::path_t& p, file_identity& Identity ) noexcept
+    {
+        struct stat Status;
+        if( ::stat( p.c_str(), &Status ) != 0 )
+        {
+            return false;
+        }
+        Identity.device     = static_cast<std::uint64_t>( Status.st_dev );
+        Identity.inode      = static_cast<std::uint64_t>( Status.st_ino );
+        Identity.ctime_sec  = static_cast<std::int64_t>( Status.st_ctim.tv_sec );
+        Identity.ctime_nsec = static_cast<std::int64_t>( Status.st_ctim.tv_nsec );
+        return true;
+    }
+
+    bool operator==( const file_identity& Other ) const noexcept
+    {
+        return device == Other.device
+            && inode == Other.inode
+            && ctime_sec == Other.ctime_sec
+            && ctime_nsec == Other.ctime_nsec;
+    }
+};
+
+
+//! \brief  A cache of `canonical` results kept in a memory-mapped file so
+//!         that every process mapping the same file shares it, and a
+//!         process started after another has canonicalised a path finds
+//!         the result already there. A file under /dev/shm keeps the cache
+//!         in POSIX shared memory.
+//!
+//!         Each entry records the device, inode and ctime of what its path
+//!         resolved to and is used only while a stat of the path still
+//!         reports them, so retargeting a symlink along the path, or
+//!         renaming or replacing what it resolves to, invalidates it.
+//!         Renaming an ancestor of the result does not change its ctime and
+//!         is not detected; call `invalidate_all` after restructuring the
+//!         trees being cached.
+//!
+//!         The file holds a fixed number of fixed-size slots. A key hashes
+//!         to a bucket of `bucket_size` slots and a new entry replaces the
+//!         oldest in its bucket. Each slot is guarded by a sequence lock:
+//!         readers never block or write to shared memory and retry nothing,
+//!         treating a slot being written as a miss, and a writer never
+//!         chooses a slot being written. Paths whose key and result do not
+//!         fit in a slot are not cached.
+//!
+//!         A process killed while writing a slot leaves it locked. Once as
+//!         many entries as the cache holds have been inserted since, which
+//!         a live writer never takes, the slot is taken as abandoned and
+//!         written again.
+class shared_canonical_cache
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    static const std::size_t    default_slots = 16 * 1024;
+    static const std::size_t    slot_size     = 1024;
+    static const std::size_t    bucket_size   = 4;
+
+    //! \brief  Map the cache in `file`, creating it with room for `slots`
+    //!         entries if it does not exist. An existing cache is used with
+    //!         the number of slots it was created with.
+    explicit shared_canonical_cache( const path_t& File, std::size_t Slots = default_slots )
+    : Path_( File )
+    {
+        int Fd = ::open( File.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+        if( Fd < 0 )
+        {
+            throw_error( errno );
+        }
+        // Only one process initialises a new file
+        while( ::flock( Fd, LOCK_EX ) != 0 && errno == EINTR )
+        {
+        }
+
+        int Error = 0;
+        struct stat Status;
+        if( ::fstat( Fd, &Status ) != 0 )
+        {
+            Error = errno;
+        }
+        else if( Status.st_size == 0 )
+        {
+            Slots = std::max( std::size_t( bucket_size ), Slots - Slots % bucket_size );
+            Size_ = sizeof( header ) + Slots * slot_size;
+            if( ::ftruncate( Fd, static_cast<off_t>( Size_ ) ) != 0 )
+            {
+                Error = errno;
+            }
+            else if( !map( Fd ) )
+            {
+                Error = errno;
+            }
+            else
+            {
+                // The file was zero filled by ftruncate so every slot is empty
+                Header_->magic     = magic;
+                Header_->version   = version;
+                Header_->slot_size = slot_size;
+                Header_->slots     = Slots;
+            }
+        }
+        else
+        {
+            Size_ = static_cast<std::size_t>( Status.st_size );
+            if( Size_ < sizeof( header ) || !map( Fd ) )
+            {
+                Error = Size_ < sizeof( header ) ? EINVAL : errno;
+            }
+            else if
+            (   Header_->magic != magic
+            ||  Header_->version != version
+            ||  Header_->slot_size != slot_size
+            ||  Header_->slots == 0
+            ||  Header_->slots % bucket_size
+            ||  Header_->slots > ( Size_ - sizeof( header ) ) / slot_size   )
+            {
+                Error = EINVAL;
+            }
+        }
+
+        ::flock( Fd, LOCK_UN );
+        ::close( Fd );
+        if( Error )
+        {
+            if( Header_ )
+            {
+                ::munmap( Header_, Size_ );
+                Header_ = nullptr;
+            }
+            throw_error( Error );
+        }
+        Slots_ = reinterpret_cast<slot*>( reinterpret_cast<char*>( Header_ ) + sizeof( header ) );
+    }
+
+    shared_canonical_cache( const shared_canonical_cache& ) = delete;
+    shared_canonical_cache& operator=( const shared_canonical_cache& ) = delete;
+
+    ~shared_canonical_cache()
+    {
+        ::munmap( Header_, Size_ );
+    }
+
+    //! \brief  Return the number of entries the cache can hold
+    std::size_t capacity() const noexcept
+    {
+        return static_cast<std::size_t>( Header_->slots );
+    }
+
+    //! \brief  Look up `p`, which must be absolute, setting `result` and
+    //!         returning true if it is cached and `identity` matches what
+    //!         was recorded for it
+    bool find( const path_t& p, const file_identity& Identity, path_t& Result ) const
+    {
+        const std::string& Key = p.native();
+        auto Hash = hash( Key );
+        auto Generation = Header_->generation.load( std::memory_order_acquire );
+
+        alignas( slot ) char Copy[slot_size];
+        for( auto* Slot = bucket( Hash ); Slot != bucket( Hash ) + bucket_size; ++Slot )
+        {
+            auto Before = Slot->sequence.load( std::memory_order_acquire );
+            if( ( Before & 1 ) || Slot->hash != Hash )
+            {
+                continue;
+            }
+            std::memcpy( Copy, static_cast<const void*>( Slot ), slot_size );
+            std::atomic_thread_fence( std::memory_order_acquire );
+            if( Slot->sequence.load( std::memory_order_relaxed ) != Before )
+            {
+                continue;
+            }
+
+            const auto* Entry = reinterpret_cast<const slot*>( Copy );
+            if
+            (   Entry->generation == Generation
+            &&  Entry->identity == Identity
+            &&  Entry->key_size == Key.size()
+            &&  Entry->key_size + Entry->value_size <= slot_data_size
+            &&  !std::memcmp( Entry->data, Key.data(), Key.size() )   )
+            {
+                Result = path_t( std::string( Entry->data + Entry->key_size, Entry->value_size ) );
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! \brief  Return the current generation, to be read before the stat
+    //!         and canonicalisation whose results are passed to `insert`
+    std::uint64_t generation() const noexcept
+    {
+        return Header_->generation.load( std::memory_order_acquire );
+    }
+
+    //! \brief  Record `result` as the canonical form of the absolute path
+    //!         `p`, which resolved to `identity` before `result` was found,
+    //!         both after `generation` was read. An `invalidate_all` made in
+    //!         between leaves the entry a miss.
+    void insert( const path_t& p, const file_identity& Identity, const path_t& Result, std::uint64_t Generation )
+    {
+        const std::string& Key = p.native();
+        const std::string& Value = Result.native();
+        if( Key.size() + Value.size() > slot_data_size )
+        {
+            return;
+        }
+        auto Hash = hash( Key );
+
+        // Reuse the slot holding this key, otherwise replace the oldest that
+        // is not being written
+        slot* Victim = nullptr;
+        for( auto* Slot = bucket( Hash ); Slot != bucket( Hash ) + bucket_size; ++Slot )
+        {
+            if( Slot->hash == Hash && Slot->key_size == Key.size() && !std::memcmp( Slot->data, Key.data(), Key.size() ) )
+            {
+                Victim = Slot;
+                break;
+            }
+            if( locked( *Slot, Slot->sequence.load( std::memory_order_relaxed ) ) )
+            {
+                continue;
+            }
+            if( !Victim || Slot->stamp < Victim->stamp )
+            {
+                Victim = Slot;
+            }
+        }
+        if( !Victim )
+        {
+            return;
+        }
+
+        // An abandoned slot is taken by moving it to the next odd sequence
+        auto Sequence = Victim->sequence.load( std::memory_order_relaxed );
+        auto Locked = Sequence + ( Sequence & 1 ? 2 : 1 );
+        if( locked( *Victim, Sequence ) || !Victim->sequence.compare_exchange_strong( Sequence, Locked, std::memory_order_acquire ) )
+        {
+            return;
+        }
+        std::atomic_thread_fence( std::memory_order_release );
+
+        // Stamped first, so a slot whose writer is alive never looks
+        // abandoned, and from 1, as an empty slot's 0 must stay the oldest
+        Victim->stamp      = Header_->clock.fetch_add( 1, std::memory_order_relaxed ) + 1;
+        Victim->hash       = Hash;
+        Victim->generation = Generation;
+        Victim->identity   = Identity;
+        Victim->key_size   = static_cast<std::uint32_t>( Key.size() );
+        Victim->value_size = static_cast<std::uint32_t>( Value.size() );
+        std::memcpy( Victim->data, Key.data(), Key.size() );
+        std::memcpy( Victim->data + Key.size(), Value.data(), Value.size() );
+
+        Victim->sequence.store( Locked + 1, std::memory_order_release );
+    }
+
+    //! \brief  Make every entry, in every process, a miss
+    void invalidate_all() noexcept
+    {
+        Header_->generation.fetch_add( 1, std::memory_order_acq_rel );
+    }
+
+private:
+
+    //! "XFSCANON" when read in the byte order that wrote it
+    static const std::uint64_t  magic   = 0x4e4f4e4143534658ull;
+    static const std::uint32_t  version = 1;
+
+    struct header
+    {
+        std::uint64_t               magic;
+        std::uint32_t               version;
+        std::uint32_t               slot_size;
+        std::uint64_t               slots;
+        std::atomic<std::uint64_t>  generation;
+        std::atomic<std::uint64_t>  clock;
+        char                        padding[24];
+    };
+
+    struct slot_fields
+    {
+        std::atomic<std::uint32_t>  sequence;
+        std::uint32_t               key_size;
+        std::uint32_t               value_size;
+        std::uint32_t               reserved;
+        std::uint64_t               hash;
+        std::uint64_t               generation;
+        std::uint64_t               stamp;
+        file_identity               identity;
+    };
+
+    static const std::size_t slot_data_size = slot_size - sizeof( slot_fields );
+
+    struct slot : slot_fields
+    {
+        char data[slot_data_size];
+    };
+
+    static_assert( sizeof( slot ) == slot_size, "a slot must fill its space exactly" );
+    static_assert( sizeof( header ) == 64, "slots must start on a cache line" );
+
+    //! FNV-1a, so that every process agrees whatever it was built with
+    static std::uint64_t hash( const std::string& Key ) noexcept
+    {
+        std::uint64_t Hash = 14695981039346656037ull;
+        for( unsigned char Char: Key )
+        {
+            Hash = ( Hash ^ Char ) * 1099511628211ull;
+        }
+        return Hash;
+    }
+
+    //! Return true if `slot`, whose sequence was `sequence`, is being
+    //! written rather than free or abandoned by a writer that was killed
+    bool locked( const slot& Slot, std::uint32_t Sequence ) const noexcept
+    {
+        auto Clock = Header_->clock.load( std::memory_order_relaxed );
+        return ( Sequence & 1 ) && ( Clock < Slot.stamp || Clock - Slot.stamp <= Header_->slots );
+    }
+
+    slot* bucket( std::uint64_t Hash ) const noexcept
+    {
+        auto Buckets = Header_->slots / bucket_size;
+        return Slots_ + ( Hash % Buckets ) * bucket_size;
+    }
+
+    bool map( int Fd )
+    {
+        void* Data = ::mmap( nullptr, Size_, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0 );
+        if( Data == MAP_FAILED )
+        {
+            return false;
+        }
+        Header_ = static_cast<header*>( Data );
+        return true;
+    }
+
+    void throw_error( int Error ) const
+    {
+        BOOST_FILESYSTEM_THROW
+        (   boost::filesystem::filesystem_error
+            (   "xstd::filesystem::shared_canonical_cache",
+                Path_,
+                boost::system::error_code( Error, boost::system::system_category() )   )   );
+    }
+
+    path_t          Path_;
+    std::size_t     Size_ = 0;
+    header*         Header_ = nullptr;
+    slot*           Slots_ = nullptr;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations for `relative` and `proximate` that answer
+//!         `canonical` for absolute paths from a shared_canonical_cache,
+//!         validated with one stat, and forward everything else to
+//!         `Operations`.
+template<class Operations = system_operations>
+class shared_canonical_operations
+{
+public:
+
+    explicit shared_canonical_operations( xstd::filesystem::shared_canonical_cache& Cache, const Operations& Ops = Operations() )
+    : Cache_( Cache )
+    , Ops_( Ops )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Ops_.is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        // Read first so that an `invalidate_all` made while `p` is checked
+        // leaves what is inserted stale
+        auto Generation = Cache_.generation();
+
+        // A relative path depends on the current directory of each process
+        xstd::filesystem::file_identity Identity;
+        if( p.is_relative() || !xstd::filesystem::file_identity::of( p, Identity ) )
+        {
+            return Ops_.canonical( p, ec );
+        }
+        path_t Result;
+        if( Cache_.find( p, Identity, Result ) )
+        {
+            ec.clear();
+            return Result;
+        }
+        Result = Ops_.canonical( p, ec );
+        if( !ec )
+        {
+            Cache_.insert( p, Identity, Result, Generation );
+        }
+        return Result;
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return Ops_.current_path( ec );
+    }
+
+private:
+
+    xstd::filesystem::shared_canonical_cache&   Cache_;
+    Operations                                  Ops_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,46 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_shared_canonical_cache
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_shared_canonical_cache_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_shared_canonical_cache_across_processes )
+{
+    test_shared_canonical_cache_across_processes();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_canonical_cache_validation )
+{
+    test_shared_canonical_cache_validation();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_canonical_cache_invalidated_while_canonicalising )
+{
+    test_shared_canonical_cache_invalidated_while_canonicalising();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_canonical_cache_bucket )
+{
+    test_shared_canonical_cache_bucket();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_canonical_cache_abandoned_slot )
+{
+    test_shared_canonical_cache_abandoned_slot();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_cache_real_relative_paths )
+{
+    test_shared_cache_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_cache_multiple_nested_symlinks )
+{
+    test_shared_cache_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_shared_cache_real_and_imaginary_relative_paths )
+{
+    test_shared_cache_real_and_imaginary_relative_paths();
+}
@@ -0,0 +1,556 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_SYMLINK_FREE_TREES_HPP_INCLUDED
+#define XSTD_FILESYSTEM_SYMLINK_FREE_TREES_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/root_registry.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <sys/stat.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Where a path lies within a symlink_free_trees registration
+struct symlink_free_location
+{
+    //! True if the path is inside a registered tree and the answers below
+    //! can be used in place of querying the filesystem
+    bool                        covered = false;
+
+    //! `canonical( p )` if `p` exists, otherwise `weakly_canonical( p )`
+    boost::filesystem::path_t   real_path;
+
+    bool                        exists = false;
+    bool                        is_directory = false;
+};
+
+
+//! \brief  A set of directory trees known to contain no symlinks, inside
+//!         which paths can be made canonical lexically.
+//!
+//!         `add` scans a tree once, refusing it if it contains a symlink,
+//!         and records every entry below it together with the modification
+//!         time of each directory. A path inside a registered tree is then
+//!         located without touching the filesystem: its real path is the
+//!         canonical root followed by the normalized remainder, and whether
+//!         it exists is answered from the recorded entries.
+//!
+//!         Once the check interval has passed since a tree was last checked,
+//!         the next lookup in it stats each of its directories. If any has
+//!         been modified the tree is scanned again, and dropped if it has
+//!         gained a symlink. Changes are therefore seen within one interval;
+//!         a zero interval checks on every lookup. Changes above a root,
+//!         such as replacing one of its ancestors with a symlink, are not
+//!         detected.
+//!
+//!         Lookups may run concurrently with each other and with `add` and
+//!         `remove`.
+class symlink_free_trees
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    explicit symlink_free_trees( std::chrono::steady_clock::duration CheckInterval = std::chrono::seconds( 1 ) )
+    : CheckInterval_( std::chrono::duration_cast<std::chrono::nanoseconds>( CheckInterval ).count() )
+    , Trees_( std::make_shared<const tree_map>() )
+    {
+    }
+
+    symlink_free_trees( const symlink_free_trees& ) = delete;
+    symlink_free_trees& operator=( const symlink_free_trees& ) = delete;
+
+    //! \brief  Scan the directory tree at `root` and register it, returning
+    //!         false if it contains a symlink or cannot be scanned, in which
+    //!         case `ec` holds the error.
+    bool add( const path_t& Root, boost::system::error_code& ec )
+    {
+        auto Tree = scan( normalize( boost::filesystem::absolute( Root ) ), ec );
+        if( !Tree )
+        {
+            return false;
+        }
+        publish( Tree->root.native(), Tree );
+        return true;
+    }
+
+    //! \brief  Unregister `root`, returning false if it was not registered
+    bool remove( const path_t& Root )
+    {
+        return publish( normalize( boost::filesystem::absolute( Root ) ).native(), nullptr );
+    }
+
+    //! \brief  Locate the absolute path `p`. Paths outside every registered
+    //!         tree, or that leave their tree through "..", are not covered.
+    symlink_free_location locate( const path_t& p ) const
+    {
+        symlink_free_location Location;
+        if( !p.is_absolute() )
+        {
+            return Location;
+        }
+
+        auto Match = Roots_.find( p );
+        if( !Match )
+        {
+            return Location;
+        }
+        auto Trees = std::atomic_load( &Trees_ );
+        auto Found = Trees->find( Match.root.native() );
+        if( Found == Trees->end() )
+        {
+            return Location;
+        }
+        auto Tree = fresh( Found->second );
+        if( !Tree )
+        {
+            return Location;
+        }
+
+        // Walk `p` as the kernel would, skipping the root. Leaving the tree
+        // through ".." may reach a directory reached through a symlink above
+        // it, so is not covered even if `p` comes back inside.
+        auto Element = p.begin();
+        for( const auto& RootElement: Tree->root )
+        {
+            while( Element != p.end() && *Element == dot() )
+            {
+                ++Element;
+            }
+            if( Element == p.end() || *Element != RootElement )
+            {
+                return Location;
+            }
+            ++Element;
+        }
+
+        std::string Current;
+        bool Exists = true;
+        bool IsDirectory = true;
+        path_t Remainder;
+        for( ; Element != p.end(); ++Element )
+        {
+            Remainder /= *Element;
+            if( *Element == dot() )
+            {
+                Exists = Exists && IsDirectory;
+            }
+            else if( *Element == dotdot() )
+            {
+                if( Current.empty() )
+                {
+                    return Location;
+                }
+                Exists = Exists && IsDirectory;
+                auto Slash = Current.rfind( '/' );
+                Current.erase( Slash == std::string::npos ? 0 : Slash );
+                IsDirectory = true;
+            }
+            else
+            {
+                if( !Current.empty() )
+                {
+                    Current += '/';
+                }
+                Current += Element->native();
+                if( Exists && IsDirectory )
+                {
+                    auto Entry = Tree->entries.find( Current );
+                    Exists = Entry != Tree->entries.end();
+                    IsDirectory = Exists && Entry->second;
+                }
+                else
+                {
+                    Exists = false;
+                }
+            }
+        }
+
+        Location.covered = true;
+        Location.real_path = Tree->real_root;
+        if( !Remainder.empty() )
+        {
+            Location.real_path /= normalize( Remainder );
+        }
+        Location.exists = Exists;
+        Location.is_directory = Exists && IsDirectory;
+        return Location;
+    }
+
+    //! \brief  Return the number of registered trees
+    std::size_t size() const
+    {
+        return std::atomic_load( &Trees_ )->size();
+    }
+
+private:
+
+    struct tree
+    {
+        path_t  root;
+        path_t  real_root;
+
+        //! Every entry below the root by its path relative to the root,
+        //! mapped to whether it is a directory
+        std::unordered_map<std::string, bool> entries;
+
+        //! Every directory, including the root, with its modification time
+        std::vector<std::pair<path_t, std::pair<std::int64_t, std::int64_t>>> directories;
+
+        mutable std::atomic<std::int64_t> checked{ 0 };
+    };
+
+    using tree_ptr = std::shared_ptr<const tree>;
+    using tree_map = std::unordered_map<std::string, tree_ptr>;
+
+    static const path_t& dot()
+    {
+        static const path_t Dot( "." );
+        return Dot;
+    }
+
+    static const path_t& dotdot()
+    {
+        static const path_t DotDot( ".." );
+        return DotDot;
+    }
+
+    static std::int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
+    static bool modified( const path_t& Directory, std::pair<std::int64_t, std::int64_t>& Time )
+    {
+        struct stat Status;
+        if( ::stat( Directory.c_str(), &Status ) != 0 )
+        {
+            return false;
+        }
+#if defined( __APPLE__ )
+        Time = { Status.st_mtimespec.tv_sec, Status.st_mtimespec.tv_nsec };
+#else
+        Time = { Status.st_mtim.tv_sec, Status.st_mtim.tv_nsec };
+#endif
+        return true;
+    }
+
+    //! Return a new record of the tree at `root`, or null if it contains a
+    //! symlink or cannot be read
+    static std::shared_ptr<tree> scan( const path_t& Root, boost::system::error_code& ec )
+    {
+        auto Tree = std::make_shared<tree>();
+        Tree->root = Root;
+        Tree->real_root = boost::filesystem::canonical( Root, ec );
+        if( ec )
+        {
+            return nullptr;
+        }
+
+        std::vector<std::string> Pending = { std::string() };
+        while( !Pending.empty() )
+        {
+            auto Relative = std::move( Pending.back() );
+            Pending.pop_back();
+
+            auto Directory = Relative.empty() ? Root : Root / Relative;
+
+            // The time is taken before listing so a change made while the
+            // directory is read is seen by the next check
+            std::pair<std::int64_t, std::int64_t> Time;
+            if( !modified( Directory, Time ) )
+            {
+                ec.assign( errno, boost::system::system_category() );
+                return nullptr;
+            }
+            Tree->directories.emplace_back( Directory, Time );
+
+            for( boost::filesystem::directory_iterator Entry( Directory, ec ), End; Entry != End && !ec; Entry.increment( ec ) )
+            {
+                auto Status = Entry->symlink_status( ec );
+                if( ec )
+                {
+                    return nullptr;
+                }
+                if( boost::filesystem::is_symlink( Status ) )
+                {
+                    return nullptr;
+                }
+                auto Name = Relative.empty() ? Entry->path().filename().native() : Relative + '/' + Entry->path().filename().native();
+                bool IsDirectory = boost::filesystem::is_directory( Status );
+                if( IsDirectory )
+                {
+                    Pending.push_back( Name );
+                }
+                Tree->entries.emplace( std::move( Name ), IsDirectory );
+            }
+            if( ec )
+            {
+                return nullptr;
+            }
+        }
+        Tree->checked.store( now(), std::memory_order_relaxed );
+        return Tree;
+    }
+
+    //! Return `tree` if it was checked within the interval or is unchanged,
+    //! its replacement if it was modified, and null if it no longer
+    //! qualifies or another thread is checking it
+    tree_ptr fresh( const tree_ptr& Tree ) const
+    {
+        auto Now = now();
+        if( Now - Tree->checked.load( std::memory_order_relaxed ) < CheckInterval_ )
+        {
+            return Tree;
+        }
+
+        std::unique_lock<std::mutex> Lock( CheckMutex_, std::try_to_lock );
+        if( !Lock )
+        {
+            return nullptr;
+        }
+
+        bool Unchanged = true;
+        for( const auto& Directory: Tree->directories )
+        {
+            std::pair<std::int64_t, std::int64_t> Time;
+            if( !modified( Directory.first, Time ) || Time != Directory.second )
+            {
+                Unchanged = false;
+                break;
+            }
+        }
+        if( Unchanged )
+        {
+            Tree->checked.store( Now, std::memory_order_relaxed );
+            return Tree;
+        }
+
+        boost::system::error_code ec;
+        return replace( Tree, scan( Tree->root, ec ) );
+    }
+
+    //! Publish `rescanned` in place of `tree`, removing `tree` if it is
+    //! null, and return it. If `add` or `remove` has changed the
+    //! registration since `tree` was looked up, publish nothing and return
+    //! whatever is registered at its root now, which may be null.
+    tree_ptr replace( const tree_ptr& Tree, const tree_ptr& Rescanned ) const
+    {
+        std::lock_guard<std::mutex> Lock( WriteMutex_ );
+
+        auto Trees = std::atomic_load( &Trees_ );
+        auto Found = Trees->find( Tree->root.native() );
+        if( Found == Trees->end() )
+        {
+            return nullptr;
+        }
+        if( Found->second != Tree )
+        {
+            return Found->second;
+        }
+        publish_locked( Tree->root.native(), Rescanned );
+        return Rescanned;
+    }
+
+    //! Replace the tree registered at `root`, removing it if `tree` is null,
+    //! and return false if that changed nothing
+    bool publish( const std::string& Root, const tree_ptr& Tree )
+    {
+        std::lock_guard<std::mutex> Lock( WriteMutex_ );
+        return publish_locked( Root, Tree );
+    }
+
+    //! Do the work of `publish` with `WriteMutex_` held. It is const because
+    //! a lookup that finds a tree modified publishes its replacement.
+    bool publish_locked( const std::string& Root, const tree_ptr& Tree ) const
+    {
+        auto Trees = std::make_shared<tree_map>( *std::atomic_load( &Trees_ ) );
+        bool Changed;
+        if( Tree )
+        {
+            ( *Trees )[Root] = Tree;
+            Roots_.add( Root );
+            Changed = true;
+        }
+        else
+        {
+            Changed = Trees->erase( Root ) != 0;
+            Roots_.remove( Root );
+        }
+        std::atomic_store( &Trees_, std::shared_ptr<const tree_map>( std::move( Trees ) ) );
+        return Changed;
+    }
+
+    const std::int64_t                          CheckInterval_;
+
+    // Written by `locate` when it publishes a rescanned tree
+    mutable boost::filesystem::root_registry    Roots_;
+    mutable std::shared_ptr<const tree_map>     Trees_;
+    mutable std::mutex                          WriteMutex_;
+    mutable std::mutex                          CheckMutex_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations that answer queries about paths inside a
+//!         set of symlink_free_trees without touching the filesystem, and
+//!         pass all others on to `Operations`.
+//!
+//!         `relative` and `proximate` given these operations compute the
+//!         result with `normalize` and `lexically_relative` alone when both
+//!         paths are inside registered trees.
+template<class Operations = system_operations>
+class symlink_free_operations
+{
+public:
+
+    explicit symlink_free_operations( const xstd::filesystem::symlink_free_trees& Trees, Operations Ops = Operations() )
+    : Trees_( Trees )
+    , Ops_( std::move( Ops ) )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Location = Trees_.locate( p );
+        if( !Location.covered )
+        {
+            return Ops_.exists( p, ec );
+        }
+        if( !Location.exists )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::system_category() );
+            return false;
+        }
+        ec.clear();
+        return true;
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Location = Trees_.locate( p );
+        if( !Location.covered )
+        {
+            return Ops_.is_directory( p, ec );
+        }
+        ec.clear();
+        return Location.is_directory;
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        auto Location = Trees_.locate( p );
+        if( !Location.covered )
+        {
+            return Ops_.canonical( p, ec );
+        }
+        if( !Location.exists )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::system_category() );
+            return path_t();
+        }
+        ec.clear();
+        return std::move( Location.real_path );
+    }
+
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        return Ops_.current_path( ec );
+    }
+
+    const xstd::filesystem::symlink_free_trees& trees() const noexcept
+    {
+        return Trees_;
+    }
+
+    const Operations& operations() const noexcept
+    {
+        return Ops_;
+    }
+
+private:
+
+    const xstd::filesystem::symlink_free_trees& Trees_;
+    Operations Ops_;
+};
+
+
+//! \brief  Return a relative path to `p` from `start`, lexically if both
+//!         are inside registered symlink-free trees and otherwise as the
+//!         general `relative`, which still answers queries about whichever
+//!         path is inside a tree from it
+template<class Operations>
+path_t
+relative( const path_t& p, const path_t& start, boost::system::error_code& ec, const symlink_free_operations<Operations>& ops )
+{
+    auto real_p = absolute_helper( p, ec, ops );
+    if( ec )
+    {
+        return path_t();
+    }
+    auto real_start = absolute_helper( start, ec, ops );
+    if( ec )
+    {
+        return path_t();
+    }
+
+    auto Start = ops.trees().locate( real_start );
+    if( Start.covered )
+    {
+        auto Path = ops.trees().locate( real_p );
+        if( Path.covered )
+        {
+            ec.clear();
+            if( Start.exists && !Start.is_directory )
+            {
+                ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+                return path_t();
+            }
+            return lexically_relative( Path.real_path, Start.real_path );
+        }
+    }
+    // Naming the template argument leaves only the general overload viable
+    return relative<symlink_free_operations<Operations>>( real_p, real_start, ec, ops );
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
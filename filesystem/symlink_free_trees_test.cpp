@@ -0,0 +1,31 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_symlink_free_trees
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_symlink_free_trees_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_symlink_free_real_and_imaginary_relative_paths )
+{
+    test_symlink_free_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_symlink_free_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_symlink_free_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_symlink_free_locate )
+{
+    test_symlink_free_locate();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_symlink_free_staleness )
+{
+    test_symlink_free_staleness();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_symlink_free_rescan_after_remove )
+{
+    test_symlink_free_rescan_after_remove();
+}
@@ -0,0 +1,350 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_SYMLINK_REWRITER_HPP_INCLUDED
+#define XSTD_FILESYSTEM_SYMLINK_REWRITER_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/concurrent_path_map.hpp>
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+#include <filesystem/relative_walker.hpp>
+#include <filesystem/rooted_resolver.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <stdio.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  What happened to one absolute symlink found by
+//!         `relativise_symlinks`, or why a directory could not be read
+struct symlink_rewrite
+{
+    boost::filesystem::path_t   link;
+    boost::filesystem::path_t   old_target;
+    boost::filesystem::path_t   new_target;
+    boost::system::error_code   ec;
+};
+
+
+//! \brief  How `relativise_symlinks` treats a tree
+struct relativise_options
+{
+    //! Report what would change without changing anything
+    bool                        dry_run = false;
+
+    //! The number of threads to use, or 0 to use one per core
+    std::size_t                 threads = 0;
+
+    //! If not empty, absolute targets are taken to be spelled from here
+    //! rather than from `/`, and are resolved inside it, as for a tree
+    //! staged for installation under `root` whose links name their
+    //! installed locations. The tree must lie below `root`.
+    boost::filesystem::path_t   root;
+};
+
+
+//! \brief  Return every symlink in the tree below `tree`, reading each
+//!         level of directories across `threads` threads. Directories that
+//!         cannot be read are added to `failures`, and `ec` is set if
+//!         `tree` itself cannot be.
+inline
+std::vector<boost::filesystem::path_t>
+find_symlinks( const boost::filesystem::path_t& Tree, std::size_t Threads, std::vector<symlink_rewrite>& Failures, boost::system::error_code& ec )
+{
+    using path_t = boost::filesystem::path_t;
+
+    walk_options Options;
+    Options.use_getdents = true;
+    Options.threads = Threads;
+
+    std::mutex SymlinksMutex;
+    std::vector<path_t> Symlinks;
+    std::vector<walk_failure> Unread;
+    walk_relative( Tree, Options, [&]( const std::string& Relative, boost::filesystem::file_type Type )
+    {
+        if( Type == boost::filesystem::symlink_file )
+        {
+            auto Link = Tree / Relative;
+            std::lock_guard<std::mutex> Lock( SymlinksMutex );
+            Symlinks.push_back( std::move( Link ) );
+        }
+    }, ec, &Unread );
+
+    for( auto& Directory : Unread )
+    {
+        Failures.push_back( symlink_rewrite{ Tree / Directory.path, path_t(), path_t(), Directory.ec } );
+    }
+    return Symlinks;
+}
+
+
+//! \brief  Return `tree` as seen from inside `root`, setting `ec` if it
+//!         does not lie below it
+inline
+boost::filesystem::path_t
+path_in_root( const boost::filesystem::path_t& Tree, const boost::filesystem::path_t& Root, boost::system::error_code& ec )
+{
+    auto RealRoot = boost::filesystem::canonical( Root, ec );
+    if( ec )
+    {
+        return boost::filesystem::path_t();
+    }
+    auto RealTree = boost::filesystem::canonical( Tree, ec );
+    if( ec )
+    {
+        return boost::filesystem::path_t();
+    }
+    auto Relative = boost::filesystem::lexically_relative( RealTree, RealRoot );
+    if( Relative.empty() || *Relative.begin() == ".." )
+    {
+        ec.assign( boost::system::errc::invalid_argument, boost::system::generic_category() );
+        return boost::filesystem::path_t();
+    }
+    return boost::filesystem::normalize( "/" / Relative );
+}
+
+
+//! \brief  Replace the symlink `link` with one to `target` by creating the
+//!         new link beside it and renaming it over the old one, so that
+//!         `link` always resolves to one or the other
+//!
+//! \note   The new link is first given a name made from `link`'s, the
+//!         process id and a count that is raised until the name is free.
+//!         Nothing this call did not create is ever removed.
+inline
+void
+replace_symlink( const boost::filesystem::path_t& Link, const boost::filesystem::path_t& Target, boost::system::error_code& ec )
+{
+    auto Prefix = "." + Link.filename().native() + ".relativise." + std::to_string( ::getpid() );
+    boost::filesystem::path_t Temporary;
+    for( std::uint64_t Attempt = 0; ; ++Attempt )
+    {
+        Temporary = Link.parent_path() / ( Attempt ? Prefix + "." + std::to_string( Attempt ) : Prefix );
+        if( ::symlink( Target.c_str(), Temporary.c_str() ) == 0 )
+        {
+            break;
+        }
+        if( errno != EEXIST )
+        {
+            ec.assign( errno, boost::system::system_category() );
+            return;
+        }
+    }
+    if( ::rename( Temporary.c_str(), Link.c_str() ) != 0 )
+    {
+        ec.assign( errno, boost::system::system_category() );
+        ::unlink( Temporary.c_str() );
+        return;
+    }
+    ec.clear();
+}
+
+
+//! \brief  Find every symlink below `tree` whose target is absolute and
+//!         replace it with one whose target is relative to the directory
+//!         holding it, returning what was done sorted by the spelling of
+//!         each link
+//!
+//! \param  tree - the directory to walk; symlinks to directories are not
+//!         followed
+//!
+//! \param  options - see relativise_options
+//!
+//! \param  ops - the object used to query the filesystem, see
+//!         `system_operations`, or when `options.root` is set one given
+//!         paths as seen from inside the root, see `rooted_operations`
+//!
+//! \param  ec - set if `tree` itself cannot be read, or does not lie below
+//!         `options.root`; failures for single links and directories are
+//!         reported in their results
+//!
+//! \note   The new target is `relative( parent, dir ) / filename` where
+//!         `parent` and `filename` split the old target and `dir` is the
+//!         directory holding the link. Only the parent is resolved, so a
+//!         link to another symlink, such as `libx.so` to `libx.so.1`, still
+//!         names that symlink rather than the file at the end of the chain.
+//!         Every new target is computed before any link is replaced, so a
+//!         dry run reports what a real one does, and `ops` may cache
+//!         canonical paths across the whole run.
+template<class Operations>
+std::vector<symlink_rewrite>
+relativise_symlinks( const boost::filesystem::path_t& Tree, const relativise_options& Options, const Operations& ops, boost::system::error_code& ec )
+{
+    boost::filesystem::path_t TreeInRoot;
+    if( !Options.root.empty() )
+    {
+        TreeInRoot = path_in_root( Tree, Options.root, ec );
+        if( ec )
+        {
+            return {};
+        }
+    }
+
+    std::vector<symlink_rewrite> Failures;
+    auto Symlinks = find_symlinks( Tree, Options.threads, Failures, ec );
+    if( ec )
+    {
+        return {};
+    }
+
+    std::vector<symlink_rewrite> Rewrites( Symlinks.size() );
+    std::vector<char> Reported( Symlinks.size(), 0 );
+    work_stealing_for( Symlinks.size(), Options.threads, [&]( std::size_t First, std::size_t Last )
+    {
+        for( ; First != Last; ++First )
+        {
+            auto& Rewrite = Rewrites[First];
+            Rewrite.link = std::move( Symlinks[First] );
+            Rewrite.old_target = boost::filesystem::read_symlink( Rewrite.link, Rewrite.ec );
+            if( Rewrite.ec )
+            {
+                Reported[First] = 1;
+                continue;
+            }
+            if( !Rewrite.old_target.is_absolute() )
+            {
+                continue;
+            }
+            Reported[First] = 1;
+
+            const auto& Target = Rewrite.old_target;
+            auto Directory = Rewrite.link.parent_path();
+            if( !Options.root.empty() )
+            {
+                // Each link is spelled `tree / relative`, as find_symlinks
+                // made it, so where it is inside the root follows from that
+                const auto& Spelled = Directory.native();
+                auto Relative = Spelled.size() > Tree.native().size() ? boost::filesystem::path_t( Spelled.substr( Tree.native().size() ) ).relative_path() : boost::filesystem::path_t();
+                Directory = boost::filesystem::normalize( TreeInRoot / Relative );
+            }
+            auto Filename = Target.filename();
+            if( Filename == "." || Filename == ".." || !Target.has_relative_path() )
+            {
+                Rewrite.new_target = boost::filesystem::relative( Target, Directory, Rewrite.ec, ops );
+            }
+            else
+            {
+                Rewrite.new_target = boost::filesystem::relative( Target.parent_path(), Directory, Rewrite.ec, ops ) / Filename;
+            }
+            if( Rewrite.ec )
+            {
+                continue;
+            }
+            Rewrite.new_target = boost::filesystem::normalize( Rewrite.new_target );
+            if( Rewrite.new_target.empty() )
+            {
+                Rewrite.new_target = ".";
+            }
+        }
+    } );
+
+    if( !Options.dry_run )
+    {
+        work_stealing_for( Rewrites.size(), Options.threads, [&]( std::size_t First, std::size_t Last )
+        {
+            for( ; First != Last; ++First )
+            {
+                auto& Rewrite = Rewrites[First];
+                if( !Rewrite.new_target.empty() && !Rewrite.ec )
+                {
+                    replace_symlink( Rewrite.link, Rewrite.new_target, Rewrite.ec );
+                }
+            }
+        } );
+    }
+
+    std::vector<symlink_rewrite> Results;
+    Results.reserve( Failures.size() + Rewrites.size() );
+    for( std::size_t Rewrite = 0; Rewrite != Rewrites.size(); ++Rewrite )
+    {
+        if( Reported[Rewrite] )
+        {
+            Results.push_back( std::move( Rewrites[Rewrite] ) );
+        }
+    }
+    std::move( Failures.begin(), Failures.end(), std::back_inserter( Results ) );
+    // Sorted by spelling, which is much cheaper than comparing by element
+    std::sort( Results.begin(), Results.end(), []( const symlink_rewrite& Lhs, const symlink_rewrite& Rhs )
+    {
+        return Lhs.link.native() < Rhs.link.native();
+    } );
+    return Results;
+}
+
+
+//! \brief  Find every symlink below `tree` whose target is absolute and
+//!         replace it with one whose target is relative to the directory
+//!         holding it, canonicalising through a concurrent_path_map shared
+//!         by all threads, and inside a rooted_resolver when
+//!         `options.root` is set
+inline
+std::vector<symlink_rewrite>
+relativise_symlinks( const boost::filesystem::path_t& Tree, const relativise_options& Options, boost::system::error_code& ec )
+{
+    concurrent_path_map Canonical;
+    if( Options.root.empty() )
+    {
+        return relativise_symlinks( Tree, Options, boost::filesystem::cached_canonical_operations<>( Canonical ), ec );
+    }
+
+    // Checked first, as a rooted_resolver throws if it cannot open its root
+    if( !boost::filesystem::is_directory( Options.root, ec ) )
+    {
+        if( !ec )
+        {
+            ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+        }
+        return {};
+    }
+    rooted_resolver Resolver( Options.root );
+    boost::filesystem::rooted_operations Rooted( Resolver );
+    return relativise_symlinks( Tree, Options, boost::filesystem::cached_canonical_operations<boost::filesystem::rooted_operations>( Canonical, Rooted ), ec );
+}
+
+
+//! \brief  Find every symlink below `tree` whose target is absolute and
+//!         replace it with one whose target is relative to the directory
+//!         holding it
+//!
+//! \throws boost::filesystem::filesystem_error if `tree` cannot be read
+inline
+std::vector<symlink_rewrite>
+relativise_symlinks( const boost::filesystem::path_t& Tree, const relativise_options& Options = relativise_options() )
+{
+    boost::system::error_code ec;
+    auto Results = relativise_symlinks( Tree, Options, ec );
+    if( ec )
+    {
+        BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::relativise_symlinks", Tree, ec ) );
+    }
+    return Results;
+}
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,31 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_symlink_rewriter
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_symlink_rewriter_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_relativise_symlinks )
+{
+    test_relativise_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_replace_symlink_keeps_existing_files )
+{
+    test_replace_symlink_keeps_existing_files();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_relativise_staged_symlinks )
+{
+    test_relativise_staged_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_relativise_nested_staged_symlinks )
+{
+    test_relativise_nested_staged_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_relativise_many_symlinks )
+{
+    test_relativise_many_symlinks();
+}
@@ -0,0 +1,703 @@
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#ifndef XSTD_FILESYSTEM_TREE_SNAPSHOT_HPP_INCLUDED
+#define XSTD_FILESYSTEM_TREE_SNAPSHOT_HPP_INCLUDED
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace xstd {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// Snapshot file layout
+//
+// A snapshot is written in the byte order of the machine that wrote it and
+// holds a header, an array of nodes and a block of names and symlink
+// targets. Node 0 is the root of the tree. The children of a directory are
+// consecutive nodes sorted by name, so an entry is found by binary search
+// without any index having to be built when the snapshot is loaded.
+
+struct snapshot_header
+{
+    char            magic[8];
+    std::uint32_t   version;
+
+    //! `sizeof( snapshot_node )` when written, so a layout change is caught
+    std::uint32_t   node_size;
+
+    std::uint64_t   node_count;
+    std::uint64_t   nodes_offset;
+    std::uint64_t   strings_offset;
+    std::uint64_t   strings_size;
+};
+
+
+enum class snapshot_kind : std::uint32_t
+{
+    directory,
+    file,
+    symlink
+};
+
+
+struct snapshot_node
+{
+    //! The entry's name, or for node 0 the canonical path of the root
+    std::uint32_t   name_offset;
+    std::uint32_t   name_size;
+
+    //! For a directory the index of its first child and the number of
+    //! children, for a symlink the offset and size of its target
+    std::uint32_t   first;
+    std::uint32_t   count;
+
+    std::uint32_t   parent;
+    snapshot_kind   kind;
+};
+
+
+static const char          snapshot_magic[8] = { 'X', 'F', 'S', 'S', 'N', 'A', 'P', '\0' };
+static const std::uint32_t snapshot_version  = 1;
+
+
+//! \brief  Walk the tree below `root` once, without following symlinks,
+//!         and write its structure to the file `snapshot`.
+//!
+//!         The file is written beside `snapshot` and renamed over it, so a
+//!         process that has the previous snapshot mapped keeps a consistent
+//!         view. Returns the number of entries written, the root included.
+inline
+std::size_t
+write_tree_snapshot( const boost::filesystem::path_t& Root, const boost::filesystem::path_t& Snapshot, boost::system::error_code& ec )
+{
+    using path_t = boost::filesystem::path_t;
+
+    struct entry
+    {
+        std::string         name;
+        snapshot_kind       kind;
+        std::string         target;
+        std::vector<entry>  children;
+    };
+
+    auto Real = boost::filesystem::canonical( Root, ec );
+    if( ec )
+    {
+        return 0;
+    }
+    if( !boost::filesystem::is_directory( Real, ec ) )
+    {
+        if( !ec )
+        {
+            ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+        }
+        return 0;
+    }
+
+    // Read the whole tree, depth first
+    entry Top{ Real.native(), snapshot_kind::directory, std::string(), std::vector<entry>() };
+    std::vector<std::pair<entry*, path_t>> Pending{ { &Top, Real } };
+    std::size_t Count = 1;
+    while( !Pending.empty() )
+    {
+        auto Directory = Pending.back().first;
+        auto Path = std::move( Pending.back().second );
+        Pending.pop_back();
+
+        boost::filesystem::directory_iterator Entry( Path, ec ), End;
+        for( ; !ec && Entry != End; Entry.increment( ec ) )
+        {
+            auto Status = Entry->symlink_status( ec );
+            if( ec )
+            {
+                return 0;
+            }
+            entry Child{ Entry->path().filename().native(), snapshot_kind::file, std::string(), std::vector<entry>() };
+            if( boost::filesystem::is_symlink( Status ) )
+            {
+                Child.kind = snapshot_kind::symlink;
+                Child.target = boost::filesystem::read_symlink( Entry->path(), ec ).native();
+                if( ec )
+                {
+                    return 0;
+                }
+            }
+            else if( boost::filesystem::is_directory( Status ) )
+            {
+                Child.kind = snapshot_kind::directory;
+            }
+            Directory->children.push_back( std::move( Child ) );
+        }
+        if( ec )
+        {
+            return 0;
+        }
+        // Children are not added after this, so pointers to them stay valid
+        std::sort( Directory->children.begin(), Directory->children.end(), []( const entry& Lhs, const entry& Rhs )
+        {
+            return Lhs.name < Rhs.name;
+        } );
+        Count += Directory->children.size();
+        for( auto& Child: Directory->children )
+        {
+            if( Child.kind == snapshot_kind::directory )
+            {
+                Pending.emplace_back( &Child, Path / Child.name );
+            }
+        }
+    }
+
+    // Lay the nodes out breadth first so that siblings are consecutive
+    std::vector<snapshot_node> Nodes;
+    std::string Strings;
+    Nodes.reserve( Count );
+
+    auto add = [&]( const entry& Entry, std::size_t Parent )
+    {
+        snapshot_node Node{};
+        Node.name_offset = static_cast<std::uint32_t>( Strings.size() );
+        Node.name_size   = static_cast<std::uint32_t>( Entry.name.size() );
+        Node.parent      = static_cast<std::uint32_t>( Parent );
+        Node.kind        = Entry.kind;
+        Strings += Entry.name;
+        if( Entry.kind == snapshot_kind::symlink )
+        {
+            Node.first = static_cast<std::uint32_t>( Strings.size() );
+            Node.count = static_cast<std::uint32_t>( Entry.target.size() );
+            Strings += Entry.target;
+        }
+        Nodes.push_back( Node );
+    };
+
+    add( Top, 0 );
+    std::deque<const entry*> Queue{ &Top };
+    for( std::size_t Next = 0; !Queue.empty(); ++Next )
+    {
+        const auto* Directory = Queue.front();
+        Queue.pop_front();
+        while( Nodes[Next].kind != snapshot_kind::directory )
+        {
+            ++Next;
+        }
+        Nodes[Next].first = static_cast<std::uint32_t>( Nodes.size() );
+        Nodes[Next].count = static_cast<std::uint32_t>( Directory->children.size() );
+        for( const auto& Child: Directory->children )
+        {
+            add( Child, Next );
+            if( Child.kind == snapshot_kind::directory )
+            {
+                Queue.push_back( &Child );
+            }
+        }
+    }
+
+    if( Nodes.size() > std::numeric_limits<std::uint32_t>::max() / 2 || Strings.size() > std::numeric_limits<std::uint32_t>::max() )
+    {
+        ec.assign( boost::system::errc::value_too_large, boost::system::generic_category() );
+        return 0;
+    }
+
+    snapshot_header Header{};
+    std::memcpy( Header.magic, snapshot_magic, sizeof( Header.magic ) );
+    Header.version        = snapshot_version;
+    Header.node_size      = sizeof( snapshot_node );
+    Header.node_count     = Nodes.size();
+    Header.nodes_offset   = sizeof( snapshot_header );
+    Header.strings_offset = Header.nodes_offset + Nodes.size() * sizeof( snapshot_node );
+    Header.strings_size   = Strings.size();
+
+    path_t Temporary = Snapshot.native() + ".tmp";
+    {
+        std::ofstream Out( Temporary.c_str(), std::ios::binary | std::ios::trunc );
+        Out.write( reinterpret_cast<const char*>( &Header ), sizeof( Header ) );
+        Out.write( reinterpret_cast<const char*>( Nodes.data() ), Nodes.size() * sizeof( snapshot_node ) );
+        Out.write( Strings.data(), Strings.size() );
+        if( !Out.flush() )
+        {
+            ec.assign( errno ? errno : EIO, boost::system::system_category() );
+            return 0;
+        }
+    }
+    boost::filesystem::rename( Temporary, Snapshot, ec );
+    return ec ? 0 : Nodes.size();
+}
+
+
+inline
+std::size_t
+write_tree_snapshot( const boost::filesystem::path_t& Root, const boost::filesystem::path_t& Snapshot )
+{
+    boost::system::error_code ec;
+    auto Count = write_tree_snapshot( Root, Snapshot, ec );
+    if( ec )
+    {
+        BOOST_FILESYSTEM_THROW( boost::filesystem::filesystem_error( "xstd::filesystem::write_tree_snapshot", Root, Snapshot, ec ) );
+    }
+    return Count;
+}
+
+
+//! \brief  A snapshot written by `write_tree_snapshot`, mapped read-only,
+//!         that answers queries about the tree it describes without system
+//!         calls.
+//!
+//!         Loading maps the file and checks its header, so it takes the
+//!         same time whatever the size of the tree; pages are read as
+//!         lookups touch them and are shared by every process mapping the
+//!         same snapshot.
+//!
+//!         Paths are resolved as memory_filesystem resolves them. The tree
+//!         is taken to be all that exists: the ancestors of the root exist
+//!         as directories holding only the next ancestor, every other path
+//!         outside the root does not exist, and relative paths are resolved
+//!         from the root. Queries may run concurrently.
+class tree_snapshot
+{
+public:
+
+    using path_t = boost::filesystem::path_t;
+
+    //! The most symlinks followed while resolving one path, as Linux
+    static const std::size_t max_symlinks = 40;
+
+    explicit tree_snapshot( const path_t& Snapshot )
+    : Path_( Snapshot )
+    {
+        int Fd = ::open( Snapshot.c_str(), O_RDONLY | O_CLOEXEC );
+        if( Fd < 0 )
+        {
+            throw_error( errno );
+        }
+        struct stat Status;
+        if( ::fstat( Fd, &Status ) != 0 )
+        {
+            int Error = errno;
+            ::close( Fd );
+            throw_error( Error );
+        }
+        Size_ = static_cast<std::size_t>( Status.st_size );
+        if( Size_ < sizeof( snapshot_header ) )
+        {
+            ::close( Fd );
+            throw_error( EINVAL );
+        }
+        Data_ = ::mmap( nullptr, Size_, PROT_READ, MAP_SHARED, Fd, 0 );
+        int Error = errno;
+        ::close( Fd );
+        if( Data_ == MAP_FAILED )
+        {
+            Data_ = nullptr;
+            throw_error( Error );
+        }
+
+        const auto* Header = static_cast<const snapshot_header*>( Data_ );
+        bool Valid
+            =  !std::memcmp( Header->magic, snapshot_magic, sizeof( snapshot_magic ) )
+            && Header->version == snapshot_version
+            && Header->node_size == sizeof( snapshot_node )
+            && Header->node_count != 0
+            && Header->node_count <= std::numeric_limits<std::uint32_t>::max() / 2
+            && Header->nodes_offset % alignof( snapshot_node ) == 0
+            && Header->nodes_offset <= Size_
+            && Header->node_count <= ( Size_ - Header->nodes_offset ) / sizeof( snapshot_node )
+            && Header->strings_offset <= Size_
+            && Header->strings_size <= Size_ - Header->strings_offset;
+        if( !Valid )
+        {
+            ::munmap( Data_, Size_ );
+            Data_ = nullptr;
+            throw_error( EINVAL );
+        }
+
+        Nodes_     = reinterpret_cast<const snapshot_node*>( static_cast<const char*>( Data_ ) + Header->nodes_offset );
+        NodeCount_ = static_cast<std::size_t>( Header->node_count );
+        Strings_   = static_cast<const char*>( Data_ ) + Header->strings_offset;
+        StringsSize_ = static_cast<std::size_t>( Header->strings_size );
+
+        Root_ = path_t( text( Nodes_[0].name_offset, Nodes_[0].name_size ).to_string() );
+        if( !Root_.has_root_directory() )
+        {
+            ::munmap( Data_, Size_ );
+            Data_ = nullptr;
+            throw_error( EINVAL );
+        }
+        for( const auto& Element: Root_.relative_path() )
+        {
+            RootElements_.push_back( Element.native() );
+        }
+    }
+
+    tree_snapshot( const tree_snapshot& ) = delete;
+    tree_snapshot& operator=( const tree_snapshot& ) = delete;
+
+    ~tree_snapshot()
+    {
+        if( Data_ )
+        {
+            ::munmap( Data_, Size_ );
+        }
+    }
+
+    //! \brief  Return the canonical path of the tree's root when it was
+    //!         written
+    const path_t& root() const noexcept
+    {
+        return Root_;
+    }
+
+    //! \brief  Return the number of entries in the snapshot, the root
+    //!         included
+    std::size_t size() const noexcept
+    {
+        return NodeCount_;
+    }
+
+    //! \brief  Return true if `p` resolves to an entry, following a symlink
+    //!         in its last element. A path that does not resolve is not an
+    //!         error unless a symlink loop was met.
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        std::vector<std::uint32_t> Trail;
+        auto Found = resolve( p, true, Trail, ec );
+        clear_if_missing( ec );
+        return Found != npos;
+    }
+
+    //! \brief  Return true if `p` resolves to a directory, following a
+    //!         symlink in its last element
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        std::vector<std::uint32_t> Trail;
+        auto Found = resolve( p, true, Trail, ec );
+        clear_if_missing( ec );
+        return Found != npos && kind( Found ) == snapshot_kind::directory;
+    }
+
+    //! \brief  Return true if the last element of `p` is itself a symlink
+    bool is_symlink( const path_t& p, boost::system::error_code& ec ) const
+    {
+        std::vector<std::uint32_t> Trail;
+        auto Found = resolve( p, false, Trail, ec );
+        clear_if_missing( ec );
+        return Found != npos && kind( Found ) == snapshot_kind::symlink;
+    }
+
+    //! \brief  Return the absolute path of `p` with every symlink resolved
+    //!         and no "." or ".." elements. `p` must exist.
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        std::vector<std::uint32_t> Trail;
+        if( resolve( p, true, Trail, ec ) == npos )
+        {
+            return path_t();
+        }
+        std::string Path;
+        for( std::size_t Entry = 1; Entry < Trail.size(); ++Entry )
+        {
+            Path += '/';
+            auto Name = name( Trail[Entry] );
+            Path.append( Name.data(), Name.size() );
+        }
+        return Path.empty() ? path_t( "/" ) : path_t( Path );
+    }
+
+private:
+
+    static const std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    // Positions beyond the nodes are the ancestors of the root, the first of
+    // them being "/"
+    bool is_ancestor( std::uint32_t Position ) const noexcept
+    {
+        return Position >= NodeCount_;
+    }
+
+    snapshot_kind kind( std::uint32_t Position ) const noexcept
+    {
+        return is_ancestor( Position ) ? snapshot_kind::directory : Nodes_[Position].kind;
+    }
+
+    boost::string_ref text( std::uint32_t Offset, std::uint32_t Size ) const noexcept
+    {
+        if( Offset > StringsSize_ || Size > StringsSize_ - Offset )
+        {
+            return boost::string_ref();
+        }
+        return boost::string_ref( Strings_ + Offset, Size );
+    }
+
+    boost::string_ref name( std::uint32_t Position ) const noexcept
+    {
+        if( is_ancestor( Position ) )
+        {
+            auto Depth = Position - NodeCount_;
+            return Depth ? boost::string_ref( RootElements_[Depth - 1] ) : boost::string_ref();
+        }
+        if( Position == 0 )
+        {
+            return RootElements_.empty() ? boost::string_ref() : boost::string_ref( RootElements_.back() );
+        }
+        return text( Nodes_[Position].name_offset, Nodes_[Position].name_size );
+    }
+
+    //! Return the entry called `name` in the directory at `position`
+    std::uint32_t child( std::uint32_t Position, boost::string_ref Name ) const noexcept
+    {
+        if( is_ancestor( Position ) )
+        {
+            auto Depth = Position - NodeCount_;
+            if( Name != RootElements_[Depth] )
+            {
+                return npos;
+            }
+            return Depth + 1 == RootElements_.size() ? 0 : Position + 1;
+        }
+        const auto& Directory = Nodes_[Position];
+        if( Directory.first > NodeCount_ || Directory.count > NodeCount_ - Directory.first )
+        {
+            return npos;
+        }
+        auto First = Directory.first;
+        auto Last  = Directory.first + Directory.count;
+        while( First != Last )
+        {
+            auto Middle = First + ( Last - First ) / 2;
+            auto Compared = name( Middle ).compare( Name );
+            if( Compared == 0 )
+            {
+                return Middle;
+            }
+            if( Compared < 0 )
+            {
+                First = Middle + 1;
+            }
+            else
+            {
+                Last = Middle;
+            }
+        }
+        return npos;
+    }
+
+    //! Queue the elements of `text` to be resolved before those in `pending`,
+    //! which holds the next element to resolve at its back. A trailing
+    //! separator is queued as an empty element, which requires what
+    //! precedes it to be a directory.
+    static void push_front( std::vector<boost::string_ref>& Pending, boost::string_ref Text )
+    {
+        auto End = Text.size();
+        if( End && Text.back() == '/' && Text.find_first_not_of( '/' ) != boost::string_ref::npos )
+        {
+            Pending.push_back( boost::string_ref() );
+        }
+        while( End )
+        {
+            auto Slash = Text.substr( 0, End ).rfind( '/' );
+            auto Begin = Slash == boost::string_ref::npos ? 0 : Slash + 1;
+            if( Begin != End )
+            {
+                Pending.push_back( Text.substr( Begin, End - Begin ) );
+            }
+            if( Slash == boost::string_ref::npos )
+            {
+                break;
+            }
+            End = Slash;
+        }
+    }
+
+    //! Resolve `p`, leaving the positions walked through from "/" in `trail`
+    std::uint32_t resolve( const path_t& p, bool FollowLast, std::vector<std::uint32_t>& Trail, boost::system::error_code& ec ) const
+    {
+        ec.clear();
+        if( p.empty() )
+        {
+            ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::generic_category() );
+            return npos;
+        }
+
+        std::uint32_t Top = RootElements_.empty() ? 0 : static_cast<std::uint32_t>( NodeCount_ );
+        Trail.assign( 1, Top );
+
+        std::vector<boost::string_ref> Pending;
+        push_front( Pending, p.native() );
+        if( !p.has_root_directory() )
+        {
+            push_front( Pending, Root_.native() );
+        }
+
+        std::size_t Symlinks = 0;
+        while( !Pending.empty() )
+        {
+            auto Name = Pending.back();
+            Pending.pop_back();
+
+            // Every element, even "." and "..", is looked up in a directory
+            if( kind( Trail.back() ) != snapshot_kind::directory )
+            {
+                ec.assign( boost::system::errc::not_a_directory, boost::system::generic_category() );
+                return npos;
+            }
+            if( Name.empty() || Name == "." )
+            {
+                continue;
+            }
+            if( Name == ".." )
+            {
+                if( Trail.size() > 1 )
+                {
+                    Trail.pop_back();
+                }
+                continue;
+            }
+
+            auto Child = child( Trail.back(), Name );
+            if( Child == npos )
+            {
+                ec.assign( boost::system::errc::no_such_file_or_directory, boost::system::generic_category() );
+                return npos;
+            }
+            if( kind( Child ) == snapshot_kind::symlink && ( FollowLast || !Pending.empty() ) )
+            {
+                if( ++Symlinks > max_symlinks )
+                {
+                    ec.assign( boost::system::errc::too_many_symbolic_link_levels, boost::system::generic_category() );
+                    return npos;
+                }
+                auto Target = text( Nodes_[Child].first, Nodes_[Child].count );
+                if( !Target.empty() && Target[0] == '/' )
+                {
+                    Trail.assign( 1, Top );
+                }
+                push_front( Pending, Target );
+                continue;
+            }
+            Trail.push_back( Child );
+        }
+        return Trail.back();
+    }
+
+    static void clear_if_missing( boost::system::error_code& ec )
+    {
+        if( ec == boost::system::errc::no_such_file_or_directory || ec == boost::system::errc::not_a_directory )
+        {
+            ec.clear();
+        }
+    }
+
+    void throw_error( int Error ) const
+    {
+        BOOST_FILESYSTEM_THROW
+        (   boost::filesystem::filesystem_error
+            (   "xstd::filesystem::tree_snapshot",
+                Path_,
+                boost::system::error_code( Error, boost::system::system_category() )   )   );
+    }
+
+    path_t                      Path_;
+    void*                       Data_ = nullptr;
+    std::size_t                 Size_ = 0;
+
+    const snapshot_node*        Nodes_ = nullptr;
+    std::size_t                 NodeCount_ = 0;
+    const char*                 Strings_ = nullptr;
+    std::size_t                 StringsSize_ = 0;
+
+    path_t                      Root_;
+    std::vector<std::string>    RootElements_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+namespace boost {
+namespace filesystem {
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+
+//! \brief  Filesystem operations that query a tree_snapshot, so that
+//!         `relative`, `proximate` and `weakly_canonical` given them are
+//!         answered from the snapshot with no system calls. Relative
+//!         arguments are made absolute from the snapshot's root, as the
+//!         snapshot itself resolves them.
+class snapshot_operations
+{
+public:
+
+    explicit snapshot_operations( const xstd::filesystem::tree_snapshot& Snapshot )
+    : Snapshot_( &Snapshot )
+    {
+    }
+
+    bool exists( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Snapshot_->exists( p, ec );
+    }
+
+    bool is_directory( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Snapshot_->is_directory( p, ec );
+    }
+
+    path_t canonical( const path_t& p, boost::system::error_code& ec ) const
+    {
+        return Snapshot_->canonical( p, ec );
+    }
+
+    //! Relative paths are resolved from the snapshot's root
+    path_t current_path( boost::system::error_code& ec ) const
+    {
+        ec.clear();
+        return Snapshot_->root();
+    }
+
+    const xstd::filesystem::tree_snapshot& snapshot() const noexcept
+    {
+        return *Snapshot_;
+    }
+
+private:
+
+    const xstd::filesystem::tree_snapshot* Snapshot_;
+};
+
+
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+}
+}
+// n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n n
+
+// G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G G
+#endif
@@ -0,0 +1,41 @@
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+#define BOOST_TEST_MODULE filesystem_tree_snapshot
+#include <boost/test/included/unit_test.hpp>
+#include "filesystem/operation_tree_snapshot_tests.hpp"
+// T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T T
+
+
+BOOST_AUTO_TEST_CASE( test_case_tree_snapshot_resolution )
+{
+    test_tree_snapshot_resolution();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_tree_snapshot_rejects_other_files )
+{
+    test_tree_snapshot_rejects_other_files();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_snapshot_real_relative_paths )
+{
+    test_snapshot_real_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_snapshot_multiple_nested_symlinks )
+{
+    test_snapshot_multiple_nested_symlinks();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_snapshot_real_and_imaginary_relative_paths )
+{
+    test_snapshot_real_and_imaginary_relative_paths();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_snapshot_real_and_imaginary_relative_paths_with_parent_and_current_directories )
+{
+    test_snapshot_real_and_imaginary_relative_paths_with_parent_and_current_directories();
+}
+
+BOOST_AUTO_TEST_CASE( test_case_snapshot_relative_paths_through_files )
+{
+    test_snapshot_relative_paths_through_files();
+}
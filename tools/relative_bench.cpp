@@ -0,0 +1,440 @@
+// relative_bench - compare the latency and system call count of relative()
+// using each of the filesystem operation backends, and of batch_relative()
+//
+// A tree of two deep branches and a symlink into one of them is created in
+// DIR, and relative() is timed over pairs of real, imaginary and symlinked
+// paths in it. System calls are counted by tracing a child process with
+// ptrace, so only the calls made while resolving are included.
+
+// xstd Includes
+#include <filesystem/batch_resolver.hpp>
+#include <filesystem/dirfd_resolver.hpp>
+#include <filesystem/memory_filesystem.hpp>
+#include <filesystem/operations.hpp>
+#include <filesystem/rooted_resolver.hpp>
+#include <filesystem/tree_snapshot.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX Includes
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+#include <sys/ptrace.h>
+#endif
+
+
+using path_t = boost::filesystem::path_t;
+
+
+namespace {
+
+
+struct options_t
+{
+    std::size_t                 Iterations  = 100;
+    std::size_t                 Depth       = 16;
+    std::size_t                 Files       = 8;
+    bool                        Cold        = false;
+    std::vector<std::string>    Modes;
+    path_t                      Dir;
+};
+
+
+using pairs_t = std::vector<std::pair<path_t, path_t>>;
+
+
+//! Compute relative() over every pair, as done by one iteration
+using run_t = std::function<void()>;
+
+
+void usage( std::ostream& Out )
+{
+    Out << "usage: relative_bench [-n iterations] [-d depth] [-f files] [-c] [-m mode]... dir\n"
+           "\n"
+           "  -n N              time N iterations over the path pairs (default 100)\n"
+           "  -d N              depth of each branch of the tree (default 16)\n"
+           "  -f N              files in each directory of the first branch (default 8)\n"
+           "  -c, --cold        drop the dentry and inode caches before each iteration;\n"
+           "                    needs root\n"
+           "  -m, --mode MODE   canonical, dirfd, rooted, rooted-walk, batch,\n"
+           "                    batch-threads, memory or snapshot; may be repeated\n"
+           "                    (default all)\n";
+}
+
+
+bool parse_options( int argc, char* argv[], options_t& Options )
+{
+    std::vector<std::string> Positional;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string Arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            return ( i + 1 < argc ) ? argv[++i] : nullptr;
+        };
+
+        if( Arg == "-n" || Arg == "-d" || Arg == "-f" )
+        {
+            auto Value = value();
+            if( !Value || std::atol( Value ) < ( Arg == "-f" ? 0 : 1 ) )
+            {
+                return false;
+            }
+            ( Arg == "-n" ? Options.Iterations : Arg == "-d" ? Options.Depth : Options.Files ) = std::atol( Value );
+        }
+        else if( Arg == "-c" || Arg == "--cold" )
+        {
+            Options.Cold = true;
+        }
+        else if( Arg == "-m" || Arg == "--mode" )
+        {
+            auto Value = value();
+            if( !Value )
+            {
+                return false;
+            }
+            Options.Modes.push_back( Value );
+        }
+        else if( Arg == "-h" || Arg == "--help" )
+        {
+            usage( std::cout );
+            std::exit( EXIT_SUCCESS );
+        }
+        else if( !Arg.empty() && Arg[0] == '-' )
+        {
+            return false;
+        }
+        else
+        {
+            Positional.push_back( Arg );
+        }
+    }
+    if( Positional.size() != 1 )
+    {
+        return false;
+    }
+    Options.Dir = Positional[0];
+    if( Options.Modes.empty() )
+    {
+        Options.Modes = { "canonical", "dirfd", "rooted", "rooted-walk", "batch", "batch-threads", "memory", "snapshot" };
+    }
+    return true;
+}
+
+
+//! Create root/{a,b}/d_0/.../d_N, with `files` files in each directory of
+//! a, and root/link -> a/d_0, and return pairs of paths below root as seen
+//! from inside it
+pairs_t make_tree( const path_t& Root, std::size_t Depth, std::size_t Files )
+{
+    path_t a = "/a";
+    path_t b = "/b";
+    path_t link = "/link";
+    std::vector<path_t> Directories;
+    for( std::size_t Level = 0; Level != Depth; ++Level )
+    {
+        auto Dir = "d_" + std::to_string( Level );
+        a /= Dir;
+        b /= Dir;
+        if( Level )
+        {
+            link /= Dir;
+        }
+        Directories.push_back( a );
+    }
+
+    create_directories( Root / a );
+    create_directories( Root / b );
+    if( !boost::filesystem::is_symlink( Root / "link" ) )
+    {
+        create_directory_symlink( "a/d_0", Root / "link" );
+    }
+
+    pairs_t Pairs
+    {
+        { a, b },
+        { link / "imaginary/x", b },
+        { a, link / "new" },
+        { b / "../../x", link / ".." },
+    };
+    for( const auto& Directory: Directories )
+    {
+        for( std::size_t File = 0; File != Files; ++File )
+        {
+            auto Path = Directory / ( "f_" + std::to_string( File ) );
+            std::ofstream( ( Root / Path ).c_str() );
+            Pairs.emplace_back( Path, b );
+        }
+    }
+    return Pairs;
+}
+
+
+pairs_t prefixed( const pairs_t& Pairs, const path_t& Prefix )
+{
+    pairs_t Result;
+    for( const auto& Pair: Pairs )
+    {
+        Result.emplace_back( Prefix.native() + Pair.first.native(), Prefix.native() + Pair.second.native() );
+    }
+    return Result;
+}
+
+
+template<class Operations>
+run_t make_run( const pairs_t& Pairs, const path_t& Prefix, Operations Ops )
+{
+    auto Resolved = prefixed( Pairs, Prefix );
+    return [Resolved, Ops]()
+    {
+        for( const auto& Pair: Resolved )
+        {
+            boost::system::error_code ec;
+            auto Result = boost::filesystem::relative( Pair.first, Pair.second, ec, Ops );
+            if( ec || Result.empty() )
+            {
+                std::cerr << "relative_bench: " << Pair.first << " from " << Pair.second << ": " << ec.message() << "\n";
+                std::exit( EXIT_FAILURE );
+            }
+        }
+    };
+}
+
+
+run_t make_batch_run( const pairs_t& Pairs, const path_t& Prefix, xstd::filesystem::batch_resolver& Resolver )
+{
+    auto Resolved = prefixed( Pairs, Prefix );
+    return [Resolved, &Resolver]()
+    {
+        boost::filesystem::batch_relative( Resolved, [&]( std::size_t Pair, path_t&& Result, const boost::system::error_code& ec )
+        {
+            if( ec || Result.empty() )
+            {
+                std::cerr << "relative_bench: " << Resolved[Pair].first << " from " << Resolved[Pair].second << ": " << ec.message() << "\n";
+                std::exit( EXIT_FAILURE );
+            }
+        },
+        Resolver );
+    };
+}
+
+
+//! Return the average number of system calls made by one call to `run`,
+//! or a negative number if they cannot be counted
+double count_syscalls( const run_t& Run, std::size_t Iterations )
+{
+#if defined( __linux__ )
+    pid_t Child = ::fork();
+    if( Child < 0 )
+    {
+        return -1;
+    }
+    if( Child == 0 )
+    {
+        ::ptrace( PTRACE_TRACEME, 0, nullptr, nullptr );
+        ::raise( SIGSTOP );
+        for( std::size_t i = 0; i != Iterations; ++i )
+        {
+            Run();
+        }
+        ::_exit( 0 );
+    }
+
+    int Status = 0;
+    ::waitpid( Child, &Status, 0 );
+    if( !WIFSTOPPED( Status ) )
+    {
+        return -1;
+    }
+    // Threads the child starts are traced too, so that the system calls of
+    // the batch_resolver thread backend are included
+    ::ptrace( PTRACE_SETOPTIONS, Child, nullptr, reinterpret_cast<void*>( PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_EXITKILL ) );
+    if( ::ptrace( PTRACE_SYSCALL, Child, nullptr, nullptr ) != 0 )
+    {
+        return -1;
+    }
+
+    // Each system call stops its thread on entry and on exit, except the
+    // exit calls which never return
+    std::size_t Stops = 0;
+    for( ;; )
+    {
+        pid_t Thread = ::waitpid( -1, &Status, __WALL );
+        if( Thread < 0 )
+        {
+            return -1;
+        }
+        if( WIFEXITED( Status ) || WIFSIGNALED( Status ) )
+        {
+            if( Thread == Child )
+            {
+                break;
+            }
+            continue;
+        }
+        long Signal = 0;
+        if( WSTOPSIG( Status ) == ( SIGTRAP | 0x80 ) )
+        {
+            ++Stops;
+        }
+        else if( WSTOPSIG( Status ) != SIGTRAP && WSTOPSIG( Status ) != SIGSTOP )
+        {
+            Signal = WSTOPSIG( Status );
+        }
+        ::ptrace( PTRACE_SYSCALL, Thread, nullptr, reinterpret_cast<void*>( Signal ) );
+    }
+    // The raise() returning is the first stop and exit_group the last
+    return Stops > 2 ? ( Stops - 2 ) / 2.0 / Iterations : 0;
+#else
+    return -1;
+#endif
+}
+
+
+//! Ask the kernel to drop its dentry and inode caches so the next lookups
+//! read from disk
+bool drop_caches()
+{
+    ::sync();
+    std::ofstream Control( "/proc/sys/vm/drop_caches" );
+    return static_cast<bool>( Control << "2" << std::flush );
+}
+
+
+double time_ns( const run_t& Run, std::size_t Iterations, bool Cold )
+{
+    Run();
+    std::chrono::steady_clock::duration Elapsed{};
+    for( std::size_t i = 0; i != Iterations; ++i )
+    {
+        if( Cold && !drop_caches() )
+        {
+            std::perror( "relative_bench: /proc/sys/vm/drop_caches" );
+            std::exit( EXIT_FAILURE );
+        }
+        auto Start = std::chrono::steady_clock::now();
+        Run();
+        Elapsed += std::chrono::steady_clock::now() - Start;
+    }
+    return std::chrono::duration<double, std::nano>( Elapsed ).count() / Iterations;
+}
+
+
+} // namespace
+
+
+int main( int argc, char* argv[] )
+{
+    options_t Options;
+    if( !parse_options( argc, argv, Options ) )
+    {
+        usage( std::cerr );
+        return EXIT_FAILURE;
+    }
+
+    auto Root  = boost::filesystem::absolute( Options.Dir / "relative_bench_tree" );
+    auto Pairs = make_tree( Root, Options.Depth, Options.Files );
+    auto Real  = boost::filesystem::canonical( Root );
+
+    xstd::filesystem::dirfd_resolver  Resolver;
+    xstd::filesystem::rooted_resolver Rooted( Real );
+    xstd::filesystem::rooted_resolver Walked( Real, false );
+    xstd::filesystem::batch_resolver  Batch;
+    xstd::filesystem::batch_resolver  Threads( xstd::filesystem::batch_resolver::backend::threads );
+    xstd::filesystem::memory_filesystem Memory;
+    Memory.load( Real );
+    auto SnapshotFile = boost::filesystem::absolute( Options.Dir / "relative_bench.snapshot" );
+    xstd::filesystem::write_tree_snapshot( Real, SnapshotFile );
+    xstd::filesystem::tree_snapshot Snapshot( SnapshotFile );
+
+    std::printf( "%-13s %14s %14s\n", "mode", "ns/relative", "syscalls/rel" );
+
+    for( const auto& Mode: Options.Modes )
+    {
+        run_t Run;
+        if( Mode == "canonical" )
+        {
+            Run = make_run( Pairs, Real, boost::filesystem::system_operations() );
+        }
+        else if( Mode == "dirfd" )
+        {
+            for( const auto& Pair: prefixed( Pairs, Real ) )
+            {
+                boost::system::error_code ec;
+                Resolver.anchor( Pair.second, ec );
+            }
+            Run = make_run( Pairs, Real, boost::filesystem::dirfd_operations( Resolver ) );
+        }
+        else if( Mode == "rooted" )
+        {
+            if( !Rooted.uses_openat2() )
+            {
+                std::printf( "%-13s %14s %14s\n", Mode.c_str(), "n/a", "n/a" );
+                continue;
+            }
+            Run = make_run( Pairs, path_t(), boost::filesystem::rooted_operations( Rooted ) );
+        }
+        else if( Mode == "rooted-walk" )
+        {
+            Run = make_run( Pairs, path_t(), boost::filesystem::rooted_operations( Walked ) );
+        }
+        else if( Mode == "batch" )
+        {
+            if( !Batch.uses_io_uring() )
+            {
+                std::printf( "%-13s %14s %14s\n", Mode.c_str(), "n/a", "n/a" );
+                continue;
+            }
+            Run = make_batch_run( Pairs, Real, Batch );
+        }
+        else if( Mode == "batch-threads" )
+        {
+            Run = make_batch_run( Pairs, Real, Threads );
+        }
+        else if( Mode == "memory" )
+        {
+            Run = make_run( Pairs, Real, boost::filesystem::memory_operations( Memory ) );
+        }
+        else if( Mode == "snapshot" )
+        {
+            Run = make_run( Pairs, Real, boost::filesystem::snapshot_operations( Snapshot ) );
+        }
+        else
+        {
+            usage( std::cerr );
+            return EXIT_FAILURE;
+        }
+
+        auto Latency  = time_ns( Run, Options.Iterations, Options.Cold ) / Pairs.size();
+        auto Syscalls = count_syscalls( Run, 10 ) / Pairs.size();
+
+        if( Syscalls < 0 )
+        {
+            std::printf( "%-13s %14.0f %14s\n", Mode.c_str(), Latency, "n/a" );
+        }
+        else
+        {
+            std::printf( "%-13s %14.0f %14.1f\n", Mode.c_str(), Latency, Syscalls );
+        }
+    }
+
+    boost::filesystem::remove_all( Root );
+    boost::filesystem::remove( SnapshotFile );
+    return EXIT_SUCCESS;
+}
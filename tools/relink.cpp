@@ -0,0 +1,174 @@
+// relink - replace the absolute symlinks in a tree with relative ones
+//
+// Every symlink below DIR whose target is absolute is replaced, atomically,
+// by one whose target is relative to the directory holding it, so the tree
+// can be moved or packaged without its links breaking. Each change is
+// written to standard output as `link: old -> new`.
+
+// xstd Includes
+#include <filesystem/shared_canonical_cache.hpp>
+#include <filesystem/symlink_rewriter.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using path_t = boost::filesystem::path_t;
+
+
+namespace {
+
+
+struct options_t
+{
+    xstd::filesystem::relativise_options Relativise;
+    std::string CacheFile;
+    bool        Verbose = false;
+    path_t      Dir;
+};
+
+
+void usage( std::ostream& Out )
+{
+    Out << "usage: relink [-n] [-j jobs] [-r root] [-C cache] [-v] dir\n"
+           "\n"
+           "  -n, --dry-run     report what would change without changing anything\n"
+           "  -j, --jobs N      walk and rewrite using N threads (default one per core)\n"
+           "  -r, --root DIR    absolute targets are spelled from DIR, and resolved\n"
+           "                    inside it, as in a tree staged for installation\n"
+           "  -C, --cache FILE  share canonical paths with other processes through\n"
+           "                    a cache in FILE, creating it if needed; not with -r\n"
+           "  -v, --verbose     report the number of links changed and the time taken\n";
+}
+
+
+bool parse_options( int argc, char* argv[], options_t& Options )
+{
+    std::vector<std::string> Positional;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string Arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            return ( i + 1 < argc ) ? argv[++i] : nullptr;
+        };
+
+        if( Arg == "-n" || Arg == "--dry-run" )
+        {
+            Options.Relativise.dry_run = true;
+        }
+        else if( Arg == "-j" || Arg == "--jobs" )
+        {
+            const char* Jobs = value();
+            if( !Jobs ) return false;
+            Options.Relativise.threads = std::strtoul( Jobs, nullptr, 10 );
+        }
+        else if( Arg == "-r" || Arg == "--root" )
+        {
+            const char* Root = value();
+            if( !Root ) return false;
+            Options.Relativise.root = Root;
+        }
+        else if( Arg == "-C" || Arg == "--cache" )
+        {
+            const char* File = value();
+            if( !File ) return false;
+            Options.CacheFile = File;
+        }
+        else if( Arg == "-v" || Arg == "--verbose" )
+        {
+            Options.Verbose = true;
+        }
+        else if( Arg == "-h" || Arg == "--help" )
+        {
+            usage( std::cout );
+            std::exit( EXIT_SUCCESS );
+        }
+        else if( Arg.size() > 1 && Arg[0] == '-' )
+        {
+            return false;
+        }
+        else
+        {
+            Positional.push_back( Arg );
+        }
+    }
+    // The cache holds paths on this host, not inside a root
+    if( Positional.size() != 1 || ( !Options.CacheFile.empty() && !Options.Relativise.root.empty() ) )
+    {
+        return false;
+    }
+    Options.Dir = Positional[0];
+    return true;
+}
+
+
+} // namespace
+
+
+int main( int argc, char* argv[] )
+{
+    options_t Options;
+    if( !parse_options( argc, argv, Options ) )
+    {
+        usage( std::cerr );
+        return EXIT_FAILURE;
+    }
+
+    auto Started = std::chrono::steady_clock::now();
+
+    boost::system::error_code ec;
+    std::vector<xstd::filesystem::symlink_rewrite> Rewrites;
+    if( !Options.CacheFile.empty() )
+    {
+        try
+        {
+            xstd::filesystem::shared_canonical_cache Cache( Options.CacheFile );
+            Rewrites = xstd::filesystem::relativise_symlinks( Options.Dir, Options.Relativise, boost::filesystem::shared_canonical_operations<>( Cache ), ec );
+        }
+        catch( const boost::filesystem::filesystem_error& Error )
+        {
+            std::cerr << "relink: " << Error.what() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        Rewrites = xstd::filesystem::relativise_symlinks( Options.Dir, Options.Relativise, ec );
+    }
+    if( ec )
+    {
+        std::cerr << "relink: " << Options.Dir.string() << ": " << ec.message() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::size_t Changed = 0;
+    std::size_t Failed = 0;
+    for( const auto& Rewrite : Rewrites )
+    {
+        if( Rewrite.ec )
+        {
+            std::cerr << "relink: " << Rewrite.link.string() << ": " << Rewrite.ec.message() << "\n";
+            ++Failed;
+            continue;
+        }
+        std::cout << Rewrite.link.string() << ": " << Rewrite.old_target.string() << " -> " << Rewrite.new_target.string() << "\n";
+        ++Changed;
+    }
+
+    if( Options.Verbose )
+    {
+        auto Elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - Started ).count();
+        std::cerr << "relink: " << Changed << ( Options.Relativise.dry_run ? " links would be changed" : " links changed" )
+                  << ", " << Failed << " failed, in " << Elapsed << "s\n";
+    }
+    return Failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
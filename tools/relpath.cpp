@@ -0,0 +1,433 @@
+// relpath - print the relative path from START to each path read on input
+//
+// Paths are read from standard input, or from a file, separated by newlines
+// or by NUL characters, and the result for each one is written on its own
+// record in the same order using the same separator.
+
+// xstd Includes
+#include <filesystem/operations.hpp>
+#include <filesystem/parallel.hpp>
+#include <filesystem/shared_canonical_cache.hpp>
+#include <filesystem/tree_snapshot.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// POSIX Includes
+#include <fcntl.h>
+#include <unistd.h>
+
+
+using path_t = boost::filesystem::path_t;
+
+
+namespace {
+
+
+enum class operation_t
+{
+    relative,
+    proximate,
+    lexically_relative
+};
+
+
+struct options_t
+{
+    operation_t Mode        = operation_t::relative;
+    char        Separator   = '\n';
+    std::string InputFile;
+    std::string SnapshotFile;
+    std::string CacheFile;
+    std::size_t Jobs        = 1;
+    bool        Statistics  = false;
+    path_t      Start;
+
+    //! Loaded from SnapshotFile, if given, to answer queries instead of
+    //! the filesystem
+    std::shared_ptr<const xstd::filesystem::tree_snapshot> Snapshot;
+
+    //! Opened from CacheFile, if given, to share canonical paths with other
+    //! processes
+    std::shared_ptr<xstd::filesystem::shared_canonical_cache> Cache;
+};
+
+
+const std::size_t io_buffer_size = 64 * 1024;
+const std::size_t batch_size     = 4096;
+
+
+void usage( std::ostream& Out )
+{
+    Out << "usage: relpath [-0] [-m relative|proximate|lexical] [-j jobs] [-s] [-f file] [-S snapshot] [-C cache] start\n"
+           "\n"
+           "  -0, --null        records are separated by NUL instead of newline\n"
+           "  -m, --mode MODE   relative (default), proximate or lexical\n"
+           "  -j, --jobs N      compute results using N threads\n"
+           "  -s, --stats       report the work done by each thread on standard error\n"
+           "  -f, --file FILE   read paths from FILE instead of standard input\n"
+           "  -S, --snapshot FILE\n"
+           "                    resolve paths in a snapshot written by tree_snapshot\n"
+           "                    instead of the filesystem; relative paths and start\n"
+           "                    are taken from the snapshot's root\n"
+           "  -C, --cache FILE  share canonical paths with other processes through\n"
+           "                    a cache in FILE, creating it if needed; not with -S\n";
+}
+
+
+bool parse_options( int argc, char* argv[], options_t& Options )
+{
+    std::vector<std::string> Positional;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string Arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            return ( i + 1 < argc ) ? argv[++i] : nullptr;
+        };
+
+        if( Arg == "-0" || Arg == "--null" )
+        {
+            Options.Separator = '\0';
+        }
+        else if( Arg == "-m" || Arg == "--mode" )
+        {
+            const char* Mode = value();
+            if( !Mode ) return false;
+            if(      !std::strcmp( Mode, "relative" ) )  Options.Mode = operation_t::relative;
+            else if( !std::strcmp( Mode, "proximate" ) ) Options.Mode = operation_t::proximate;
+            else if( !std::strcmp( Mode, "lexical" ) )   Options.Mode = operation_t::lexically_relative;
+            else return false;
+        }
+        else if( Arg == "-j" || Arg == "--jobs" )
+        {
+            const char* Jobs = value();
+            if( !Jobs ) return false;
+            Options.Jobs = std::strtoul( Jobs, nullptr, 10 );
+            if( Options.Jobs == 0 )
+            {
+                Options.Jobs = std::max( 1u, std::thread::hardware_concurrency() );
+            }
+        }
+        else if( Arg == "-s" || Arg == "--stats" )
+        {
+            Options.Statistics = true;
+        }
+        else if( Arg == "-f" || Arg == "--file" )
+        {
+            const char* File = value();
+            if( !File ) return false;
+            Options.InputFile = File;
+        }
+        else if( Arg == "-S" || Arg == "--snapshot" )
+        {
+            const char* File = value();
+            if( !File ) return false;
+            Options.SnapshotFile = File;
+        }
+        else if( Arg == "-C" || Arg == "--cache" )
+        {
+            const char* File = value();
+            if( !File ) return false;
+            Options.CacheFile = File;
+        }
+        else if( Arg == "-h" || Arg == "--help" )
+        {
+            usage( std::cout );
+            std::exit( EXIT_SUCCESS );
+        }
+        else if( Arg.size() > 1 && Arg[0] == '-' )
+        {
+            return false;
+        }
+        else
+        {
+            Positional.push_back( Arg );
+        }
+    }
+    if( Positional.size() != 1 || ( !Options.CacheFile.empty() && !Options.SnapshotFile.empty() ) )
+    {
+        return false;
+    }
+    Options.Start = Positional.front();
+    return true;
+}
+
+
+//! Buffers output records and writes them in large blocks
+class output_t
+{
+public:
+
+    explicit output_t( int Fd )
+    : Fd_( Fd )
+    {
+        Buffer_.reserve( io_buffer_size );
+    }
+
+    ~output_t()
+    {
+        flush();
+    }
+
+    void write( const std::string& Records )
+    {
+        if( Buffer_.size() + Records.size() > io_buffer_size )
+        {
+            flush();
+        }
+        if( Records.size() > io_buffer_size )
+        {
+            write_all( Records.data(), Records.size() );
+        }
+        else
+        {
+            Buffer_.append( Records );
+        }
+    }
+
+    void flush()
+    {
+        write_all( Buffer_.data(), Buffer_.size() );
+        Buffer_.clear();
+    }
+
+private:
+
+    void write_all( const char* Data, std::size_t Size )
+    {
+        while( Size )
+        {
+            auto Written = ::write( Fd_, Data, Size );
+            if( Written < 0 )
+            {
+                if( errno == EINTR ) continue;
+                std::perror( "relpath: write" );
+                std::exit( EXIT_FAILURE );
+            }
+            Data += Written;
+            Size -= Written;
+        }
+    }
+
+    int         Fd_;
+    std::string Buffer_;
+};
+
+
+void process( const options_t& Options, const std::string& Input, std::string& Record )
+{
+    path_t Path = Input;
+    path_t Result;
+    boost::system::error_code ec;
+
+    if( Options.Snapshot && Options.Mode != operation_t::lexically_relative )
+    {
+        boost::filesystem::snapshot_operations Ops( *Options.Snapshot );
+        Result = relative( Path, Options.Start, ec, Ops );
+        if( Options.Mode == operation_t::proximate && Result.empty() )
+        {
+            Result = Path;
+        }
+    }
+    else if( Options.Cache && Options.Mode != operation_t::lexically_relative )
+    {
+        boost::filesystem::shared_canonical_operations<> Ops( *Options.Cache );
+        Result = relative( Path, Options.Start, ec, Ops );
+        if( Options.Mode == operation_t::proximate && Result.empty() )
+        {
+            Result = Path;
+        }
+    }
+    else switch( Options.Mode )
+    {
+        case operation_t::relative:           Result = relative( Path, Options.Start, ec );  break;
+        case operation_t::proximate:          Result = proximate( Path, Options.Start, ec ); break;
+        case operation_t::lexically_relative: Result = lexically_relative( Path, Options.Start ); break;
+    }
+    if( ec )
+    {
+        std::cerr << "relpath: " << Path.string() << ": " << ec.message() << "\n";
+        Result.clear();
+    }
+    Record = Result.string();
+    Record.push_back( Options.Separator );
+}
+
+
+//! Compute the results for a batch of paths across threads, stealing work so
+//! that a few slow paths do not hold up the rest, and write them in input
+//! order
+void process_batch( const options_t& Options, const std::vector<std::string>& Batch, std::vector<std::string>& Records, output_t& Output, std::vector<xstd::filesystem::worker_statistics>& Statistics )
+{
+    Records.resize( Batch.size() );
+
+    auto Workers = xstd::filesystem::work_stealing_for( Batch.size(), Options.Jobs, [&]( std::size_t First, std::size_t Last )
+    {
+        for( ; First != Last; ++First )
+        {
+            process( Options, Batch[First], Records[First] );
+        }
+    } );
+
+    if( Statistics.size() < Workers.size() )
+    {
+        Statistics.resize( Workers.size() );
+    }
+    for( std::size_t Worker = 0; Worker != Workers.size(); ++Worker )
+    {
+        Statistics[Worker].items  += Workers[Worker].items;
+        Statistics[Worker].steals += Workers[Worker].steals;
+        Statistics[Worker].busy   += Workers[Worker].busy;
+    }
+
+    for( std::size_t Record = 0; Record != Batch.size(); ++Record )
+    {
+        Output.write( Records[Record] );
+    }
+}
+
+
+void report( const std::vector<xstd::filesystem::worker_statistics>& Statistics, std::chrono::nanoseconds Elapsed )
+{
+    for( std::size_t Worker = 0; Worker != Statistics.size(); ++Worker )
+    {
+        const auto& Stats = Statistics[Worker];
+        double Utilisation = Elapsed.count() ? 100.0 * Stats.busy.count() / Elapsed.count() : 0;
+        std::cerr << "relpath: thread " << Worker
+                  << ": items " << Stats.items
+                  << ", steals " << Stats.steals
+                  << ", utilisation " << static_cast<int>( Utilisation + 0.5 ) << "%\n";
+    }
+}
+
+
+} // namespace
+
+
+int main( int argc, char* argv[] )
+{
+    options_t Options;
+    if( !parse_options( argc, argv, Options ) )
+    {
+        usage( std::cerr );
+        return EXIT_FAILURE;
+    }
+
+    if( !Options.SnapshotFile.empty() )
+    {
+        try
+        {
+            Options.Snapshot = std::make_shared<const xstd::filesystem::tree_snapshot>( Options.SnapshotFile );
+        }
+        catch( const boost::filesystem::filesystem_error& Error )
+        {
+            std::cerr << "relpath: " << Error.what() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( !Options.CacheFile.empty() )
+    {
+        try
+        {
+            Options.Cache = std::make_shared<xstd::filesystem::shared_canonical_cache>( Options.CacheFile );
+        }
+        catch( const boost::filesystem::filesystem_error& Error )
+        {
+            std::cerr << "relpath: " << Error.what() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    int Fd = STDIN_FILENO;
+    if( !Options.InputFile.empty() )
+    {
+        Fd = ::open( Options.InputFile.c_str(), O_RDONLY );
+        if( Fd < 0 )
+        {
+            std::perror( ( "relpath: " + Options.InputFile ).c_str() );
+            return EXIT_FAILURE;
+        }
+        ::posix_fadvise( Fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+    }
+
+    output_t Output( STDOUT_FILENO );
+
+    std::vector<char>        Buffer( io_buffer_size );
+    std::string              Partial;
+    std::vector<std::string> Batch;
+    std::vector<std::string> Records;
+
+    std::vector<xstd::filesystem::worker_statistics> Statistics;
+    auto Started = std::chrono::steady_clock::now();
+
+    Batch.reserve( batch_size );
+
+    for( ;; )
+    {
+        auto Read = ::read( Fd, Buffer.data(), Buffer.size() );
+        if( Read < 0 )
+        {
+            if( errno == EINTR ) continue;
+            std::perror( "relpath: read" );
+            return EXIT_FAILURE;
+        }
+        if( Read == 0 )
+        {
+            break;
+        }
+
+        const char* First = Buffer.data();
+        const char* Last  = First + Read;
+        while( First != Last )
+        {
+            auto End = static_cast<const char*>( std::memchr( First, Options.Separator, Last - First ) );
+            if( !End )
+            {
+                Partial.append( First, Last );
+                break;
+            }
+            Partial.append( First, End );
+            Batch.push_back( std::move( Partial ) );
+            Partial.clear();
+            First = End + 1;
+
+            if( Batch.size() == batch_size )
+            {
+                process_batch( Options, Batch, Records, Output, Statistics );
+                Batch.clear();
+            }
+        }
+    }
+    if( !Partial.empty() )
+    {
+        Batch.push_back( std::move( Partial ) );
+    }
+    if( !Batch.empty() )
+    {
+        process_batch( Options, Batch, Records, Output, Statistics );
+    }
+    if( Fd != STDIN_FILENO )
+    {
+        ::close( Fd );
+    }
+    if( Options.Statistics )
+    {
+        report( Statistics, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - Started ) );
+    }
+    return EXIT_SUCCESS;
+}
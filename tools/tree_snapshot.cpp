@@ -0,0 +1,108 @@
+// tree_snapshot - write the structure of a directory tree to a snapshot file
+//
+// The tree below DIR is walked once, without following symlinks, and its
+// directories, files and symlinks are written to SNAPSHOT in the format read
+// by xstd::filesystem::tree_snapshot. `relpath -S SNAPSHOT` then resolves
+// paths in the tree without touching the filesystem.
+
+// xstd Includes
+#include <filesystem/tree_snapshot.hpp>
+
+// Boost Library Includes
+#include <boost/filesystem.hpp>
+
+// C++ Standard Library Includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using path_t = boost::filesystem::path_t;
+
+
+namespace {
+
+
+struct options_t
+{
+    bool    Verbose = false;
+    path_t  Dir;
+    path_t  Snapshot;
+};
+
+
+void usage( std::ostream& Out )
+{
+    Out << "usage: tree_snapshot [-v] dir snapshot\n"
+           "\n"
+           "  -v, --verbose     report the number of entries written and the time taken\n";
+}
+
+
+bool parse_options( int argc, char* argv[], options_t& Options )
+{
+    std::vector<std::string> Positional;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string Arg = argv[i];
+
+        if( Arg == "-v" || Arg == "--verbose" )
+        {
+            Options.Verbose = true;
+        }
+        else if( Arg == "-h" || Arg == "--help" )
+        {
+            usage( std::cout );
+            std::exit( EXIT_SUCCESS );
+        }
+        else if( Arg.size() > 1 && Arg[0] == '-' )
+        {
+            return false;
+        }
+        else
+        {
+            Positional.push_back( Arg );
+        }
+    }
+    if( Positional.size() != 2 )
+    {
+        return false;
+    }
+    Options.Dir = Positional[0];
+    Options.Snapshot = Positional[1];
+    return true;
+}
+
+
+} // namespace
+
+
+int main( int argc, char* argv[] )
+{
+    options_t Options;
+    if( !parse_options( argc, argv, Options ) )
+    {
+        usage( std::cerr );
+        return EXIT_FAILURE;
+    }
+
+    auto Started = std::chrono::steady_clock::now();
+
+    boost::system::error_code ec;
+    auto Entries = xstd::filesystem::write_tree_snapshot( Options.Dir, Options.Snapshot, ec );
+    if( ec )
+    {
+        std::cerr << "tree_snapshot: " << Options.Dir.string() << ": " << ec.message() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if( Options.Verbose )
+    {
+        auto Elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - Started ).count();
+        std::cerr << "tree_snapshot: " << Entries << " entries written to " << Options.Snapshot.string() << " in " << Elapsed << "s\n";
+    }
+    return EXIT_SUCCESS;
+}